@@ -0,0 +1,120 @@
+#ifndef DYN2B_BENCH_H
+#define DYN2B_BENCH_H
+
+/**
+ * Minimal micro-benchmark harness.
+ *
+ * A benchmark is a function that performs one call of the kernel under test on
+ * operands taken from a slot. A slot is a block of BENCH_SLOT_SIZE doubles
+ * that is split into BENCH_SLOT_OPERANDS operands of BENCH_OPERAND_SIZE
+ * doubles each; BENCH_OPERAND(slot, k) is the k-th of them. The pool of slots
+ * is filled with values in [0.5, 1.5) before the first benchmark runs.
+ *
+ * Every benchmark is timed twice:
+ * - warm: all calls use the same slot, so the operands stay in L1
+ * - cold: consecutive calls use consecutive slots of a pool that is larger
+ *         than the last-level cache, so the operands come from memory
+ */
+
+#define BENCH_OPERAND_SIZE 64
+#define BENCH_SLOT_OPERANDS 4
+#define BENCH_SLOT_SIZE (BENCH_OPERAND_SIZE * BENCH_SLOT_OPERANDS)
+
+#define BENCH_OPERAND(slot, k) (&(slot)[BENCH_OPERAND_SIZE * (k)])
+
+
+/**
+ * Views of an operand as coordinate types whose members are pointers.
+ */
+#include <dyn2b/types/geometry.h>
+#include <dyn2b/types/mechanics.h>
+
+static inline struct gc_pose bench_pose(double *op)
+{
+    return (struct gc_pose) {
+        .rotation = (struct matrix3x3 *)&op[0],
+        .translation = (struct vector3 *)&op[9]
+    };
+}
+
+static inline struct gc_twist bench_twist(double *op)
+{
+    return (struct gc_twist) {
+        .angular_velocity = (struct vector3 *)&op[0],
+        .linear_velocity = (struct vector3 *)&op[3]
+    };
+}
+
+static inline struct gc_acc_twist bench_acc_twist(double *op)
+{
+    return (struct gc_acc_twist) {
+        .angular_acceleration = (struct vector3 *)&op[0],
+        .linear_acceleration = (struct vector3 *)&op[3]
+    };
+}
+
+static inline struct mc_momentum bench_momentum(double *op)
+{
+    return (struct mc_momentum) {
+        .angular_momentum = (struct vector3 *)&op[0],
+        .linear_momentum = (struct vector3 *)&op[3]
+    };
+}
+
+static inline struct mc_wrench bench_wrench(double *op)
+{
+    return (struct mc_wrench) {
+        .torque = (struct vector3 *)&op[0],
+        .force = (struct vector3 *)&op[3]
+    };
+}
+
+
+/**
+ * Clocks.
+ */
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#  define BENCH_HAVE_CYCLES 1
+#else
+#  define BENCH_HAVE_CYCLES 0
+#endif
+
+static inline double bench_now_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Time-stamp counter (0 if not available)
+static inline unsigned long long bench_now_cycles(void)
+{
+#if BENCH_HAVE_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+
+typedef void (*bench_fn)(double *slot);
+
+struct bench_suite;
+
+/**
+ * Register a benchmark.
+ *
+ * flops: number of floating-point operations of one call (0 if the kernel
+ *        only moves data)
+ */
+void bench_add(
+        struct bench_suite *s,
+        const char *name,
+        double flops,
+        bench_fn fn);
+
+#endif
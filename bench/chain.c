@@ -0,0 +1,337 @@
+#include "chain.h"
+
+#include <dyn2b/functions/executor.h>
+#include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/solver.h>
+#include <dyn2b/functions/solver_state.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Distance between two objects of a scattered chain: one page plus one cache
+// line, so that the objects neither share a line nor map to the same set
+#define SCATTER_STRIDE (4096 + 64)
+
+
+const char *axis_mix_name[3] = {
+    [AXIS_MIX_Z] = "z",
+    [AXIS_MIX_XYZ] = "xyz",
+    [AXIS_MIX_RANDOM] = "random"
+};
+
+const char *layout_name[2] = {
+    [LAYOUT_PACKED] = "packed",
+    [LAYOUT_SCATTERED] = "scattered"
+};
+
+
+static double uniform(
+        double lo,
+        double hi)
+{
+    return lo + (hi - lo) * rand() / RAND_MAX;
+}
+
+
+static void *chain_place(
+        struct chain *c,
+        size_t size)
+{
+    if (c->layout == LAYOUT_SCATTERED) {
+        return (char *)c->memory + (size_t)c->order[c->next++] * SCATTER_STRIDE;
+    }
+
+    void *p = (char *)c->memory + c->used;
+    c->used += (size + 63) & ~(size_t)63;
+
+    return p;
+}
+
+
+static void random_rotation(
+        struct matrix3x3 *r)
+{
+    double w, x, y, z, n;
+    do {
+        w = uniform(-1.0, 1.0);
+        x = uniform(-1.0, 1.0);
+        y = uniform(-1.0, 1.0);
+        z = uniform(-1.0, 1.0);
+        n = w * w + x * x + y * y + z * z;
+    } while (n > 1.0 || n < 1e-6);
+
+    n = 1.0 / sqrt(n);
+    w *= n; x *= n; y *= n; z *= n;
+
+    *r = (struct matrix3x3) {
+        .row_x = { 1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y) },
+        .row_y = { 2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x) },
+        .row_z = { 2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y) }
+    };
+}
+
+
+// Rigid-body inertia about the link's root frame for a random mass, centre of
+// mass and (diagonal) rotational inertia about the centre of mass
+static void random_rbi(
+        struct mc_rbi *m)
+{
+    double mass = uniform(0.5, 5.0);
+    double c[3] = { uniform(-0.2, 0.2), uniform(-0.2, 0.2), uniform(0.0, 0.5) };
+    double ic[3] = { uniform(0.01, 0.1), uniform(0.01, 0.1), uniform(0.01, 0.1) };
+    double cc = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+    double i[3][3];
+
+    // I = I_c + m (c^T c 1 - c c^T)
+    for (int r = 0; r < 3; r++) {
+        for (int k = 0; k < 3; k++) {
+            i[r][k] = mass * ((r == k ? cc : 0.0) - c[r] * c[k]) + (r == k ? ic[r] : 0.0);
+        }
+    }
+
+    *m = (struct mc_rbi) {
+        .zeroth_moment_of_mass = mass,
+        .first_moment_of_mass = { mass * c[0], mass * c[1], mass * c[2] },
+        .second_moment_of_mass = {
+            .row_x = { i[0][0], i[0][1], i[0][2] },
+            .row_y = { i[1][0], i[1][1], i[1][2] },
+            .row_z = { i[2][0], i[2][1], i[2][2] }
+        }
+    };
+}
+
+
+int chain_create(
+        int nseg,
+        enum axis_mix axes,
+        enum layout layout,
+        struct chain *c)
+{
+    // Per segment: attachment rotation and translation, joint inertia
+    const int NR_OBJECTS = 3 * nseg;
+
+    memset(c, 0, sizeof(*c));
+    c->layout = layout;
+    c->kc.number_of_segments = nseg;
+    c->kc.segment = calloc(nseg, sizeof(struct kcc_segment));
+
+    size_t size;
+    if (layout == LAYOUT_SCATTERED) {
+        size = (size_t)NR_OBJECTS * SCATTER_STRIDE;
+        c->order = malloc(NR_OBJECTS * sizeof(int));
+    } else {
+        // Every object starts on a cache line
+        size = (size_t)nseg * (128 + 64 + 64);
+    }
+    c->memory = aligned_alloc(64, size);
+
+    if (!c->kc.segment || !c->memory || (layout == LAYOUT_SCATTERED && !c->order)) {
+        free(c->kc.segment);
+        free(c->memory);
+        free(c->order);
+        return -1;
+    }
+
+    if (layout == LAYOUT_SCATTERED) {
+        for (int i = 0; i < NR_OBJECTS; i++) c->order[i] = i;
+        for (int i = NR_OBJECTS - 1; i > 0; i--) {
+            int j = rand() % (i + 1);
+            int t = c->order[i];
+            c->order[i] = c->order[j];
+            c->order[j] = t;
+        }
+    }
+
+    for (int i = 0; i < nseg; i++) {
+        struct kcc_segment *seg = &c->kc.segment[i];
+
+        struct matrix3x3 *rot = chain_place(c, sizeof(struct matrix3x3));
+        struct vector3 *pos = chain_place(c, sizeof(struct vector3));
+        joint_inertia *inertia = chain_place(c, sizeof(joint_inertia));
+
+        random_rotation(rot);
+        *pos = (struct vector3) { uniform(-0.1, 0.1), uniform(-0.1, 0.1), uniform(0.1, 0.5) };
+        *inertia = uniform(0.0, 0.1);
+
+        enum joint_axis axis = JOINT_AXIS_Z;
+        if (axes == AXIS_MIX_XYZ) axis = (enum joint_axis)(i % 3);
+        if (axes == AXIS_MIX_RANDOM) axis = (enum joint_axis)(rand() % 3);
+
+        seg->joint_attachment.rotation = rot;
+        seg->joint_attachment.translation = pos;
+        seg->joint.type = JOINT_TYPE_REVOLUTE;
+        seg->joint.revolute_joint.axis = axis;
+        seg->joint.revolute_joint.inertia = inertia;
+        random_rbi(&seg->link.inertia);
+    }
+
+    kcc_compile(&c->kc);
+
+    c->bytes = nseg * (sizeof(struct kcc_segment) + sizeof(struct matrix3x3)
+            + sizeof(struct vector3) + sizeof(joint_inertia));
+
+    return 0;
+}
+
+
+int chain_branch(
+        struct chain *c,
+        int nbranches)
+{
+    const int NR_SEGMENTS = c->kc.number_of_segments;
+
+    free(c->parent);
+    c->parent = malloc((NR_SEGMENTS > 0 ? NR_SEGMENTS : 1) * sizeof(int));
+    if (!c->parent) return -1;
+
+    // Segment i > 0 belongs to branch (i - 1) % nbranches; the first segment
+    // of a branch is attached to the trunk
+    for (int i = 0; i < NR_SEGMENTS; i++) {
+        c->parent[i] = i == 0 ? -1 : (i - 1 < nbranches ? 0 : i - nbranches);
+    }
+    c->kc.parent = c->parent;
+
+    return 0;
+}
+
+
+void chain_destroy(
+        struct chain *c)
+{
+    free(c->parent);
+    free(c->kc.segment);
+    free(c->memory);
+    free(c->order);
+}
+
+
+int sample_create(
+        const struct kcc_kinematic_chain *kc,
+        int nthreads,
+        struct sample *x)
+{
+    const int NR_SEGMENTS = kc->number_of_segments;
+
+    memset(x, 0, sizeof(*x));
+    if (solver_state_create_c(kc, &x->s) != 0) return -1;
+    if (kcc_executor_create(kc, nthreads, &x->ex) != 0) {
+        solver_state_destroy_c(&x->s);
+        return -1;
+    }
+
+    x->q = malloc(10 * NR_SEGMENTS * sizeof(double));
+    if (!x->q) {
+        kcc_executor_destroy(&x->ex);
+        solver_state_destroy_c(&x->s);
+        return -1;
+    }
+    x->qd = &x->q[NR_SEGMENTS];
+    x->qdd = &x->q[2 * NR_SEGMENTS];
+    x->tau = &x->q[3 * NR_SEGMENTS];
+    x->j = &x->q[4 * NR_SEGMENTS];
+
+    for (int i = 0; i < NR_SEGMENTS; i++) {
+        x->q[i] = uniform(-M_PI, M_PI);
+        x->qd[i] = uniform(-1.0, 1.0);
+        x->qdd[i] = uniform(-1.0, 1.0);
+        x->tau[i] = uniform(-1.0, 1.0);
+    }
+
+    // Gravity
+    x->s.xdd[0].linear_acceleration->z = 9.81;
+
+    return 0;
+}
+
+
+void sample_destroy(
+        struct sample *x)
+{
+    kcc_executor_destroy(&x->ex);
+    solver_state_destroy_c(&x->s);
+    free(x->q);
+}
+
+
+static void sweep_fpk(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    kcc_fpk(kc, x->q, &x->s);
+}
+
+
+static void sweep_fvk(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    kcc_fvk(kc, x->q, x->qd, &x->s);
+}
+
+
+static void sweep_fak(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    kcc_fak(kc, x->q, x->qd, x->qdd, &x->s);
+}
+
+
+static void sweep_aba(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    kcc_aba(kc, x->q, x->qd, x->tau, NULL, &x->s, x->qdd);
+}
+
+
+static void sweep_fpkscan(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    (void)kc;
+    kcc_executor_fpk(&x->ex, x->q, &x->s);
+}
+
+
+static void sweep_abasub(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    (void)kc;
+    kcc_executor_aba_subtrees(&x->ex, x->q, x->qd, x->tau, NULL, &x->s, x->qdd);
+}
+
+
+static void sweep_jac(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    const struct kcc_frame frame = { .body = kc->number_of_segments, .pose = NULL };
+
+    kcc_jacobian(kc, x->q, &frame, JACOBIAN_BODY, &x->s, x->j);
+}
+
+
+static void sweep_jdqd(
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x)
+{
+    const struct kcc_frame frame = { .body = kc->number_of_segments, .pose = NULL };
+
+    kcc_jacobian_dot_qd(kc, x->q, x->qd, &frame, JACOBIAN_BODY, &x->s, x->j);
+}
+
+
+const struct chain_sweep chain_sweep[NR_CHAIN_SWEEPS] = {
+    { "fpk", sweep_fpk },
+    { "fvk", sweep_fvk },
+    { "fak", sweep_fak },
+    { "aba", sweep_aba },
+    { "fpkscan", sweep_fpkscan },
+    { "abasub", sweep_abasub },
+    { "jac", sweep_jac },
+    { "jdqd", sweep_jdqd }
+};
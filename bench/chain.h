@@ -0,0 +1,127 @@
+#ifndef DYN2B_BENCH_CHAIN_H
+#define DYN2B_BENCH_CHAIN_H
+
+#include <dyn2b/types/kinematic_chain.h>
+#include <dyn2b/types/solver_state.h>
+#include <dyn2b/types/executor.h>
+
+#include <stddef.h>
+
+/**
+ * Randomly generated serial chains of revolute joints, optionally branched
+ * into trees, and the sweeps over them that the chain benchmarks time.
+ *
+ * The segments form one array. The data that they point to (joint attachment
+ * and joint inertia) either follows in one block (LAYOUT_PACKED) or is
+ * scattered over pages in random order (LAYOUT_SCATTERED).
+ */
+
+
+enum axis_mix
+{
+    AXIS_MIX_Z,                     // all joints rotate about z
+    AXIS_MIX_XYZ,                   // x, y, z, x, ...
+    AXIS_MIX_RANDOM
+};
+
+enum layout
+{
+    LAYOUT_PACKED,
+    LAYOUT_SCATTERED
+};
+
+extern const char *axis_mix_name[3];
+extern const char *layout_name[2];
+
+
+struct chain
+{
+    struct kcc_kinematic_chain kc;
+    size_t bytes;                   // footprint of the chain's data
+
+    void *memory;                   // objects the segments point to
+    size_t used;
+    int *order;                     // slot order of a scattered chain
+    int next;
+    enum layout layout;
+    int *parent;                    // parent indices of a branched chain
+};
+
+/**
+ * Random joint state of a chain, the solver state of the sweeps and the
+ * executor of the parallel sweeps.
+ */
+struct sample
+{
+    struct solver_state_c s;
+    struct kcc_executor ex;
+    joint_position *q;
+    joint_velocity *qd;
+    joint_acceleration *qdd;
+    joint_torque *tau;
+    double *j;                      // 6 x nd Jacobian
+};
+
+typedef void (*sweep_fn)(const struct kcc_kinematic_chain *kc, struct sample *x);
+
+
+/**
+ * Available sweeps:
+ * - fpk: kcc_fpk()
+ * - fvk: kcc_fvk()
+ * - fak: kcc_fak()
+ * - aba: kcc_aba()
+ * - fpkscan: kcc_executor_fpk()
+ * - abasub: kcc_executor_aba_subtrees()
+ * - jac: kcc_jacobian() of the last link; the poses of q are cached
+ * - jdqd: kcc_jacobian_dot_qd() of the last link; as jac
+ */
+#define NR_CHAIN_SWEEPS 8
+
+extern const struct chain_sweep
+{
+    const char *name;
+    sweep_fn fn;
+} chain_sweep[NR_CHAIN_SWEEPS];
+
+
+/**
+ * Generate a chain of nseg segments from rand().
+ *
+ * Returns 0 on success and -1 if the chain could not be allocated.
+ */
+int chain_create(
+        int nseg,
+        enum axis_mix axes,
+        enum layout layout,
+        struct chain *c);
+
+/**
+ * Turn the chain into a tree: segment 0 is the trunk and the other segments
+ * form nbranches serial branches of about equal length that are attached to
+ * it, like the limbs of a humanoid. The branches' segments are interleaved.
+ *
+ * Returns 0 on success and -1 if the parent indices could not be allocated.
+ */
+int chain_branch(
+        struct chain *c,
+        int nbranches);
+
+void chain_destroy(
+        struct chain *c);
+
+/**
+ * Draw a random joint state for the chain; the base is accelerated upwards to
+ * model gravity. The parallel sweeps use nthreads workers.
+ *
+ * Returns 0 on success and -1 if the state could not be allocated.
+ */
+int sample_create(
+        const struct kcc_kinematic_chain *kc,
+        int nthreads,
+        struct sample *x);
+
+void sample_destroy(
+        struct sample *x);
+
+#endif
@@ -0,0 +1,273 @@
+#include "bench.h"
+#include "chain.h"
+
+#include <dyn2b/functions/solver_state.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Scaling of the solvers with the length of a serial chain.
+ *
+ * Random chains of 1 to --max segments are generated and every sweep of
+ * chain.h is timed on each of them, either warm (the chain and the solver
+ * state stay in the caches) or, with --cold, after every cache level has been
+ * flushed. --layout scattered exposes the cost of the pointer chasing in the
+ * sweeps.
+ *
+ * The parallel sweeps run on --threads workers; the last line reports the
+ * crossover length from which on the prefix scan of kcc_executor_fpk() beats
+ * the serial kcc_fpk() on every measured chain, which is where a parallel
+ * position sweep starts to pay off on this machine.
+ */
+
+
+#define NR_SAMPLES 9
+
+// Flushed before every call of a cold run; larger than any last-level cache
+#define FLUSH_SIZE (64 * 1024 * 1024)
+
+
+static int compare_double(
+        const void *a,
+        const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+static volatile double flush_sink;
+
+static void flush_caches(
+        double *buffer)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < FLUSH_SIZE / sizeof(double); i += 8) {
+        buffer[i] += 1.0;
+        sum += buffer[i];
+    }
+    flush_sink = sum;
+}
+
+
+/**
+ * Median over NR_SAMPLES samples of the time per sweep. A warm sample is a
+ * batch of sweeps that takes at least min_ns / NR_SAMPLES; a cold sample is a
+ * single sweep after the caches have been flushed.
+ */
+static void measure(
+        sweep_fn fn,
+        const struct kcc_kinematic_chain *kc,
+        struct sample *x,
+        double *flush,
+        double min_ns,
+        double *ns_per_sweep,
+        double *cycles_per_sweep)
+{
+    double ns[NR_SAMPLES];
+    double cycles[NR_SAMPLES];
+    long batch = 1;
+
+    if (!flush) {
+        for (;;) {
+            double t0 = bench_now_ns();
+            for (long i = 0; i < batch; i++) fn(kc, x);
+            if (bench_now_ns() - t0 >= min_ns / NR_SAMPLES) break;
+            batch *= 2;
+        }
+    }
+
+    for (int k = 0; k < NR_SAMPLES; k++) {
+        if (flush) flush_caches(flush);
+
+        double t0 = bench_now_ns();
+        unsigned long long c0 = bench_now_cycles();
+        for (long i = 0; i < batch; i++) fn(kc, x);
+        unsigned long long c1 = bench_now_cycles();
+        double t1 = bench_now_ns();
+
+        ns[k] = (t1 - t0) / batch;
+        cycles[k] = (double)(c1 - c0) / batch;
+    }
+
+    qsort(ns, NR_SAMPLES, sizeof(double), compare_double);
+    qsort(cycles, NR_SAMPLES, sizeof(double), compare_double);
+
+    *ns_per_sweep = ns[NR_SAMPLES / 2];
+    *cycles_per_sweep = cycles[NR_SAMPLES / 2];
+}
+
+
+static int parse_name(
+        const char *name,
+        const char **names,
+        int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (strcmp(name, names[i]) == 0) return i;
+    }
+
+    return -1;
+}
+
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--max SEGMENTS] [--axes z|xyz|random]\n"
+            "          [--layout packed|scattered] [--cold] [--csv FILE]\n"
+            "          [--min-time MS] [--threads N] [--seed SEED]\n",
+            prog);
+}
+
+
+int main(int argc, char **argv)
+{
+    static const int length[] = {
+        1, 2, 3, 4, 6, 8, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 112, 128, 160, 192, 256
+    };
+
+    int max_segments = 128;
+    int axes = AXIS_MIX_RANDOM;
+    int layout = LAYOUT_PACKED;
+    int cold = 0;
+    const char *csv_path = NULL;
+    double min_ms = 20.0;
+    int nthreads = 4;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--max") == 0) {
+            max_segments = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--axes") == 0) {
+            axes = parse_name(argv[++i], axis_mix_name, 3);
+            if (axes < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "--layout") == 0) {
+            layout = parse_name(argv[++i], layout_name, 2);
+            if (layout < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cold") == 0) {
+            cold = 1;
+        } else if (i + 1 < argc && strcmp(argv[i], "--csv") == 0) {
+            csv_path = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--min-time") == 0) {
+            min_ms = atof(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            nthreads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0) {
+            seed = (unsigned)atol(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (nthreads < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    double *flush = NULL;
+    if (cold) {
+        flush = calloc(1, FLUSH_SIZE);
+        if (!flush) {
+            fprintf(stderr, "cannot allocate the flush buffer\n");
+            return 1;
+        }
+    }
+
+    FILE *csv = NULL;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) {
+            fprintf(stderr, "cannot open %s\n", csv_path);
+            return 1;
+        }
+        fprintf(csv, "segments,axes,layout,cache,algorithm,bytes,"
+                "ns,ns_per_segment,cycles_per_segment\n");
+    }
+
+    const char *cache = cold ? "cold" : "warm";
+
+    printf("axes: %s, layout: %s, cache: %s, threads: %d\n\n",
+            axis_mix_name[axes], layout_name[layout], cache, nthreads);
+    printf("%8s %10s", "segments", "bytes");
+    for (size_t k = 0; k < NR_CHAIN_SWEEPS; k++) {
+        printf(" %9s ns %8s ns/seg", chain_sweep[k].name, chain_sweep[k].name);
+    }
+    printf("\n");
+
+    // Shortest chain from which on fpkscan beats fpk on every longer chain
+    int crossover = 0;
+
+    srand(seed);
+    for (size_t l = 0; l < sizeof(length) / sizeof(length[0]); l++) {
+        const int NR_SEGMENTS = length[l];
+        if (NR_SEGMENTS > max_segments) break;
+
+        struct chain c;
+        struct sample x;
+        if (chain_create(NR_SEGMENTS, axes, layout, &c) != 0
+                || sample_create(&c.kc, nthreads, &x) != 0) {
+            fprintf(stderr, "cannot allocate a chain of %d segments\n", NR_SEGMENTS);
+            return 1;
+        }
+
+        // Everything that one sweep touches
+        size_t bytes = c.bytes + solver_state_size_c(&c.kc) + 10 * NR_SEGMENTS * sizeof(double);
+
+        printf("%8d %10zu", NR_SEGMENTS, bytes);
+        double ns_fpk = 0.0;
+        for (size_t k = 0; k < NR_CHAIN_SWEEPS; k++) {
+            double ns, cycles;
+            measure(chain_sweep[k].fn, &c.kc, &x, flush, min_ms * 1e6, &ns, &cycles);
+
+            if (strcmp(chain_sweep[k].name, "fpk") == 0) ns_fpk = ns;
+            if (strcmp(chain_sweep[k].name, "fpkscan") == 0) {
+                if (ns >= ns_fpk) {
+                    crossover = 0;
+                } else if (!crossover) {
+                    crossover = NR_SEGMENTS;
+                }
+            }
+
+            printf(" %12.1f %15.2f", ns, ns / NR_SEGMENTS);
+
+            if (csv) {
+                fprintf(csv, "%d,%s,%s,%s,%s,%zu,%.3f,%.3f,",
+                        NR_SEGMENTS, axis_mix_name[axes], layout_name[layout], cache,
+                        chain_sweep[k].name, bytes, ns, ns / NR_SEGMENTS);
+                if (BENCH_HAVE_CYCLES) {
+                    fprintf(csv, "%.2f\n", cycles / NR_SEGMENTS);
+                } else {
+                    fprintf(csv, "\n");
+                }
+            }
+        }
+        printf("\n");
+        fflush(stdout);
+
+        sample_destroy(&x);
+        chain_destroy(&c);
+    }
+
+    if (crossover) {
+        printf("\nfpkscan beats fpk from %d segments\n", crossover);
+    } else {
+        printf("\nfpkscan does not beat fpk on any length\n");
+    }
+
+    if (csv) fclose(csv);
+    free(flush);
+
+    return 0;
+}
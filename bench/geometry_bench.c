@@ -0,0 +1,114 @@
+#include "bench.h"
+
+#include <dyn2b/functions/geometry.h>
+
+
+static void bench_gc_pose_compose(double *slot)
+{
+    struct gc_pose x1 = bench_pose(BENCH_OPERAND(slot, 0));
+    struct gc_pose x2 = bench_pose(BENCH_OPERAND(slot, 1));
+    struct gc_pose r = bench_pose(BENCH_OPERAND(slot, 2));
+
+    gc_pose_compose(&x1, &x2, &r);
+}
+
+
+static void bench_gc_twist_tf_ref_to_tgt(double *slot)
+{
+    struct gc_pose x = bench_pose(BENCH_OPERAND(slot, 0));
+    struct gc_twist xd = bench_twist(BENCH_OPERAND(slot, 1));
+    struct gc_twist r = bench_twist(BENCH_OPERAND(slot, 2));
+
+    gc_twist_tf_ref_to_tgt(&x, &xd, &r);
+}
+
+
+// Elementary rotation about the y axis
+static struct gc_elementary_pose bench_elementary_pose(double *op)
+{
+    return (struct gc_elementary_pose) { .axis = 1, .cos_angle = op[0], .sin_angle = op[1] };
+}
+
+
+static void bench_gc_pose_compose_elementary(double *slot)
+{
+    struct gc_elementary_pose x1 = bench_elementary_pose(BENCH_OPERAND(slot, 0));
+    struct gc_pose x2 = bench_pose(BENCH_OPERAND(slot, 1));
+    struct gc_pose r = bench_pose(BENCH_OPERAND(slot, 2));
+
+    gc_pose_compose_elementary(&x1, &x2, &r);
+}
+
+
+static void bench_gc_twist_tf_ref_to_tgt_elementary(double *slot)
+{
+    struct gc_elementary_pose x = bench_elementary_pose(BENCH_OPERAND(slot, 0));
+    struct gc_twist xd = bench_twist(BENCH_OPERAND(slot, 1));
+    struct gc_twist r = bench_twist(BENCH_OPERAND(slot, 2));
+
+    gc_twist_tf_ref_to_tgt_elementary(&x, &xd, &r);
+}
+
+
+static void bench_gc_twist_accumulate(double *slot)
+{
+    struct gc_twist xd1 = bench_twist(BENCH_OPERAND(slot, 0));
+    struct gc_twist xd2 = bench_twist(BENCH_OPERAND(slot, 1));
+    struct gc_twist r = bench_twist(BENCH_OPERAND(slot, 2));
+
+    gc_twist_accumulate(&xd1, &xd2, &r);
+}
+
+
+static void bench_gc_twist_derive(double *slot)
+{
+    struct gc_twist xd1 = bench_twist(BENCH_OPERAND(slot, 0));
+    struct gc_twist xd2 = bench_twist(BENCH_OPERAND(slot, 1));
+    struct gc_acc_twist r = bench_acc_twist(BENCH_OPERAND(slot, 2));
+
+    gc_twist_derive(&xd1, &xd2, &r);
+}
+
+
+static void bench_gc_acc_twist_tf_ref_to_tgt(double *slot)
+{
+    struct gc_pose x = bench_pose(BENCH_OPERAND(slot, 0));
+    struct gc_acc_twist xdd = bench_acc_twist(BENCH_OPERAND(slot, 1));
+    struct gc_acc_twist r = bench_acc_twist(BENCH_OPERAND(slot, 2));
+
+    gc_acc_twist_tf_ref_to_tgt(&x, &xdd, &r);
+}
+
+
+static void bench_gc_acc_twist_add(double *slot)
+{
+    struct gc_acc_twist xdd1 = bench_acc_twist(BENCH_OPERAND(slot, 0));
+    struct gc_acc_twist xdd2 = bench_acc_twist(BENCH_OPERAND(slot, 1));
+    struct gc_acc_twist r = bench_acc_twist(BENCH_OPERAND(slot, 2));
+
+    gc_acc_twist_add(&xdd1, &xdd2, &r);
+}
+
+
+static void bench_gc_acc_twist_accumulate(double *slot)
+{
+    struct gc_acc_twist xdd1 = bench_acc_twist(BENCH_OPERAND(slot, 0));
+    struct gc_acc_twist xdd2 = bench_acc_twist(BENCH_OPERAND(slot, 1));
+    struct gc_acc_twist r = bench_acc_twist(BENCH_OPERAND(slot, 2));
+
+    gc_acc_twist_accumulate(&xdd1, &xdd2, &r);
+}
+
+
+void geometry_bench(struct bench_suite *s)
+{
+    bench_add(s, "gc_pose_compose", 45 + 24, bench_gc_pose_compose);
+    bench_add(s, "gc_twist_tf_ref_to_tgt", 9 + 3 + 2 * 15, bench_gc_twist_tf_ref_to_tgt);
+    bench_add(s, "gc_pose_compose_elementary", 18, bench_gc_pose_compose_elementary);
+    bench_add(s, "gc_twist_tf_ref_to_tgt_elementary", 12, bench_gc_twist_tf_ref_to_tgt_elementary);
+    bench_add(s, "gc_twist_accumulate", 12, bench_gc_twist_accumulate);
+    bench_add(s, "gc_twist_derive", 3 * 9 + 3, bench_gc_twist_derive);
+    bench_add(s, "gc_acc_twist_tf_ref_to_tgt", 9 + 3 + 2 * 15, bench_gc_acc_twist_tf_ref_to_tgt);
+    bench_add(s, "gc_acc_twist_add", 12, bench_gc_acc_twist_add);
+    bench_add(s, "gc_acc_twist_accumulate", 12, bench_gc_acc_twist_accumulate);
+}
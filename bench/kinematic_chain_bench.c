@@ -0,0 +1,193 @@
+#include "bench.h"
+
+#include <dyn2b/functions/kinematic_chain.h>
+
+
+static joint_inertia joint_inertia_bench[1] = { 0.1 };
+
+// One representative joint per joint type
+static const struct kcc_joint joint_bench[] = {
+    [JOINT_TYPE_REVOLUTE] = {
+        .type = JOINT_TYPE_REVOLUTE,
+        .revolute_joint = {
+            .axis = JOINT_AXIS_Z,
+            .inertia = joint_inertia_bench
+        }
+    },
+    [JOINT_TYPE_PRISMATIC] = {
+        .type = JOINT_TYPE_PRISMATIC,
+        .prismatic_joint = {
+            .axis = JOINT_AXIS_Z,
+            .inertia = joint_inertia_bench
+        }
+    },
+    [JOINT_TYPE_FIXED] = {
+        .type = JOINT_TYPE_FIXED
+    },
+    [JOINT_TYPE_SPHERICAL] = {
+        .type = JOINT_TYPE_SPHERICAL
+    },
+    [JOINT_TYPE_FREE_FLYER] = {
+        .type = JOINT_TYPE_FREE_FLYER
+    }
+};
+
+
+// Benchmark of one operator of a joint type
+#define BENCH_FPK(name, type) \
+    static void bench_##name##_fpk(double *slot) \
+    { \
+        struct gc_pose x = bench_pose(BENCH_OPERAND(slot, 1)); \
+        kcc_joint[type].fpk(&joint_bench[type], BENCH_OPERAND(slot, 0), &x); \
+    }
+
+#define BENCH_FPK_COMPOSE(name, type) \
+    static void bench_##name##_fpk_compose(double *slot) \
+    { \
+        struct gc_pose x_t = bench_pose(BENCH_OPERAND(slot, 1)); \
+        struct gc_pose x = bench_pose(BENCH_OPERAND(slot, 2)); \
+        struct gc_pose r = bench_pose(BENCH_OPERAND(slot, 3)); \
+        kcc_joint[type].fpk_compose(&joint_bench[type], BENCH_OPERAND(slot, 0), &x_t, &x, &r); \
+    }
+
+#define BENCH_FVK(name, type) \
+    static void bench_##name##_fvk(double *slot) \
+    { \
+        struct gc_twist xd = bench_twist(BENCH_OPERAND(slot, 1)); \
+        kcc_joint[type].fvk(&joint_bench[type], BENCH_OPERAND(slot, 0), &xd); \
+    }
+
+#define BENCH_FAK(name, type) \
+    static void bench_##name##_fak(double *slot) \
+    { \
+        struct gc_acc_twist xdd = bench_acc_twist(BENCH_OPERAND(slot, 1)); \
+        kcc_joint[type].fak(&joint_bench[type], BENCH_OPERAND(slot, 0), &xdd); \
+    }
+
+#define BENCH_INERTIAL_ACCELERATION(name, type) \
+    static void bench_##name##_inertial_acceleration(double *slot) \
+    { \
+        struct gc_twist xd = bench_twist(BENCH_OPERAND(slot, 1)); \
+        struct gc_acc_twist xdd = bench_acc_twist(BENCH_OPERAND(slot, 2)); \
+        kcc_joint[type].inertial_acceleration(&joint_bench[type], &xd, BENCH_OPERAND(slot, 0), &xdd); \
+    }
+
+#define BENCH_IFK(name, type) \
+    static void bench_##name##_ifk(double *slot) \
+    { \
+        struct mc_wrench f = bench_wrench(BENCH_OPERAND(slot, 1)); \
+        kcc_joint[type].ifk(&joint_bench[type], &f, BENCH_OPERAND(slot, 0), 1); \
+    }
+
+#define BENCH_INERTIAL_TORQUE(name, type) \
+    static void bench_##name##_inertial_torque(double *slot) \
+    { \
+        kcc_joint[type].inertial_torque(&joint_bench[type], BENCH_OPERAND(slot, 0), BENCH_OPERAND(slot, 1), 1); \
+    }
+
+#define BENCH_FFD(name, type) \
+    static void bench_##name##_ffd(double *slot) \
+    { \
+        const struct mc_abi_packed *m = (struct mc_abi_packed *)BENCH_OPERAND(slot, 1); \
+        struct mc_wrench f = bench_wrench(BENCH_OPERAND(slot, 2)); \
+        kcc_joint[type].ffd(&joint_bench[type], m, BENCH_OPERAND(slot, 0), &f, 1); \
+    }
+
+#define BENCH_FAD(name, type) \
+    static void bench_##name##_fad(double *slot) \
+    { \
+        const struct mc_abi_packed *m = (struct mc_abi_packed *)BENCH_OPERAND(slot, 1); \
+        kcc_joint[type].fad(&joint_bench[type], m, BENCH_OPERAND(slot, 0), BENCH_OPERAND(slot, 2), 1); \
+    }
+
+#define BENCH_PROJECT_INERTIA(name, type) \
+    static void bench_##name##_project_inertia(double *slot) \
+    { \
+        const struct mc_abi_packed *m = (struct mc_abi_packed *)BENCH_OPERAND(slot, 1); \
+        struct mc_abi_packed *r = (struct mc_abi_packed *)BENCH_OPERAND(slot, 2); \
+        kcc_joint[type].project_inertia(&joint_bench[type], m, r); \
+    }
+
+#define BENCH_PROJECT_WRENCH(name, type) \
+    static void bench_##name##_project_wrench(double *slot) \
+    { \
+        const struct mc_abi_packed *m = (struct mc_abi_packed *)BENCH_OPERAND(slot, 1); \
+        struct mc_wrench f = bench_wrench(BENCH_OPERAND(slot, 2)); \
+        struct mc_wrench r = bench_wrench(BENCH_OPERAND(slot, 3)); \
+        kcc_joint[type].project_wrench(&joint_bench[type], m, &f, &r, 1); \
+    }
+
+// Benchmarks of all operators of a joint type
+#define BENCH_JOINT(name, type) \
+    BENCH_FPK(name, type) \
+    BENCH_FPK_COMPOSE(name, type) \
+    BENCH_FVK(name, type) \
+    BENCH_FAK(name, type) \
+    BENCH_INERTIAL_ACCELERATION(name, type) \
+    BENCH_IFK(name, type) \
+    BENCH_INERTIAL_TORQUE(name, type) \
+    BENCH_FFD(name, type) \
+    BENCH_FAD(name, type) \
+    BENCH_PROJECT_INERTIA(name, type) \
+    BENCH_PROJECT_WRENCH(name, type)
+
+
+BENCH_JOINT(rev, JOINT_TYPE_REVOLUTE)
+BENCH_JOINT(pri, JOINT_TYPE_PRISMATIC)
+BENCH_FPK_COMPOSE(fix, JOINT_TYPE_FIXED)
+BENCH_PROJECT_INERTIA(fix, JOINT_TYPE_FIXED)
+BENCH_PROJECT_WRENCH(fix, JOINT_TYPE_FIXED)
+BENCH_FPK_COMPOSE(sph, JOINT_TYPE_SPHERICAL)
+BENCH_INERTIAL_ACCELERATION(sph, JOINT_TYPE_SPHERICAL)
+BENCH_FFD(sph, JOINT_TYPE_SPHERICAL)
+BENCH_FAD(sph, JOINT_TYPE_SPHERICAL)
+BENCH_PROJECT_INERTIA(sph, JOINT_TYPE_SPHERICAL)
+BENCH_PROJECT_WRENCH(sph, JOINT_TYPE_SPHERICAL)
+BENCH_FPK_COMPOSE(ffl, JOINT_TYPE_FREE_FLYER)
+BENCH_INERTIAL_ACCELERATION(ffl, JOINT_TYPE_FREE_FLYER)
+BENCH_FAD(ffl, JOINT_TYPE_FREE_FLYER)
+
+
+void kinematic_chain_bench(struct bench_suite *s)
+{
+    // sin and cos are not counted
+    bench_add(s, "kcc_joint[revolute].fpk", 0, bench_rev_fpk);
+    bench_add(s, "kcc_joint[revolute].fpk_compose", 18, bench_rev_fpk_compose);
+    bench_add(s, "kcc_joint[revolute].fvk", 0, bench_rev_fvk);
+    bench_add(s, "kcc_joint[revolute].fak", 0, bench_rev_fak);
+    bench_add(s, "kcc_joint[revolute].inertial_acceleration", 4, bench_rev_inertial_acceleration);
+    bench_add(s, "kcc_joint[revolute].ifk", 0, bench_rev_ifk);
+    bench_add(s, "kcc_joint[revolute].inertial_torque", 1, bench_rev_inertial_torque);
+    bench_add(s, "kcc_joint[revolute].ffd", 8, bench_rev_ffd);
+    bench_add(s, "kcc_joint[revolute].fad", 2, bench_rev_fad);
+    bench_add(s, "kcc_joint[revolute].project_inertia", 1 + 3 * 27, bench_rev_project_inertia);
+    bench_add(s, "kcc_joint[revolute].project_wrench", 2 + 12, bench_rev_project_wrench);
+
+    bench_add(s, "kcc_joint[prismatic].fpk", 0, bench_pri_fpk);
+    bench_add(s, "kcc_joint[prismatic].fpk_compose", 6, bench_pri_fpk_compose);
+    bench_add(s, "kcc_joint[prismatic].fvk", 0, bench_pri_fvk);
+    bench_add(s, "kcc_joint[prismatic].fak", 0, bench_pri_fak);
+    bench_add(s, "kcc_joint[prismatic].inertial_acceleration", 2, bench_pri_inertial_acceleration);
+    bench_add(s, "kcc_joint[prismatic].ifk", 0, bench_pri_ifk);
+    bench_add(s, "kcc_joint[prismatic].inertial_torque", 1, bench_pri_inertial_torque);
+    bench_add(s, "kcc_joint[prismatic].ffd", 8, bench_pri_ffd);
+    bench_add(s, "kcc_joint[prismatic].fad", 2, bench_pri_fad);
+    bench_add(s, "kcc_joint[prismatic].project_inertia", 1 + 3 * 27, bench_pri_project_inertia);
+    bench_add(s, "kcc_joint[prismatic].project_wrench", 2 + 12, bench_pri_project_wrench);
+
+    // Fixed joints only copy or clear their outputs
+    bench_add(s, "kcc_joint[fixed].fpk_compose", 0, bench_fix_fpk_compose);
+    bench_add(s, "kcc_joint[fixed].project_inertia", 0, bench_fix_project_inertia);
+    bench_add(s, "kcc_joint[fixed].project_wrench", 0, bench_fix_project_wrench);
+
+    // The multi-DoF joints factorize D = S^T M^A S on every call
+    bench_add(s, "kcc_joint[spherical].fpk_compose", 22 + 72, bench_sph_fpk_compose);
+    bench_add(s, "kcc_joint[spherical].inertial_acceleration", 18, bench_sph_inertial_acceleration);
+    bench_add(s, "kcc_joint[spherical].ffd", 31 + 18, bench_sph_ffd);
+    bench_add(s, "kcc_joint[spherical].fad", 31, bench_sph_fad);
+    bench_add(s, "kcc_joint[spherical].project_inertia", 13 + 3 * 18 + 36, bench_sph_project_inertia);
+    bench_add(s, "kcc_joint[spherical].project_wrench", 31 + 18, bench_sph_project_wrench);
+    bench_add(s, "kcc_joint[free_flyer].fpk_compose", 22 + 72, bench_ffl_fpk_compose);
+    bench_add(s, "kcc_joint[free_flyer].inertial_acceleration", 30, bench_ffl_inertial_acceleration);
+    bench_add(s, "kcc_joint[free_flyer].fad", 146, bench_ffl_fad);
+}
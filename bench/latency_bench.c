@@ -0,0 +1,394 @@
+#define _GNU_SOURCE
+
+#include "bench.h"
+#include "chain.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+/**
+ * Worst-case latency of a sweep in a periodic control loop.
+ *
+ * A sweep of chain.h runs once per period on a random chain, optionally in a
+ * SCHED_FIFO thread that is pinned to one CPU and with all memory locked. Two
+ * latencies are recorded for every cycle:
+ * - wakeup: delay between the planned and the actual start of the cycle
+ * - sweep: duration of the sweep itself
+ *
+ * The page faults and the heap allocations of the measured cycles are
+ * counted, so that a run certifies whether the solver path is free of both.
+ * Allocations are only counted with glibc, whose allocator can be wrapped.
+ *
+ * With --branches the chain is a tree with that many branches on a common
+ * trunk segment. The parallel sweeps (fpkscan, abasub) use --threads
+ * workers; only the measuring thread is real-time, the workers keep the
+ * default policy.
+ */
+
+
+#define NSEC_PER_SEC 1000000000L
+
+// Cycles that run before the measurement to warm up the caches
+#define NR_WARMUP 1000
+
+// Number of buckets of the histogram; the last one collects the outliers
+#define NR_BUCKETS 1000
+
+
+// Heap allocations while counting is enabled
+//
+
+static volatile int alloc_counting;
+static unsigned long alloc_count;
+
+#ifdef __GLIBC__
+#  define BENCH_HAVE_ALLOC_COUNT 1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *p, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+static void count_alloc(void)
+{
+    if (alloc_counting) __atomic_fetch_add(&alloc_count, 1, __ATOMIC_RELAXED);
+}
+
+void *malloc(size_t size)
+{
+    count_alloc();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size)
+{
+    count_alloc();
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t size)
+{
+    count_alloc();
+    return __libc_realloc(p, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    count_alloc();
+    return __libc_memalign(alignment, size);
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+    count_alloc();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **p, size_t alignment, size_t size)
+{
+    count_alloc();
+    *p = __libc_memalign(alignment, size);
+    return *p ? 0 : ENOMEM;
+}
+#else
+#  define BENCH_HAVE_ALLOC_COUNT 0
+#endif
+
+
+struct latency
+{
+    long *sample;                   // ns, one per cycle
+    long histogram[NR_BUCKETS];
+};
+
+
+static int compare_long(
+        const void *a,
+        const void *b)
+{
+    long x = *(const long *)a;
+    long y = *(const long *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+static long percentile(
+        const long *sorted,
+        long n,
+        double p)
+{
+    long i = (long)(p / 100.0 * (n - 1) + 0.5);
+
+    return sorted[i];
+}
+
+
+static void report(
+        const char *name,
+        struct latency *l,
+        long n,
+        long bucket_ns,
+        FILE *histogram)
+{
+    qsort(l->sample, n, sizeof(long), compare_long);
+
+    printf("%-8s %10ld %10ld %10ld %10ld %10ld\n", name,
+            l->sample[0],
+            percentile(l->sample, n, 50.0),
+            percentile(l->sample, n, 99.0),
+            percentile(l->sample, n, 99.9),
+            l->sample[n - 1]);
+
+    if (histogram) {
+        for (int b = 0; b < NR_BUCKETS; b++) {
+            if (l->histogram[b] == 0) continue;
+            fprintf(histogram, "%s,%ld,%ld\n", name, b * bucket_ns, l->histogram[b]);
+        }
+    }
+}
+
+
+static void record(
+        struct latency *l,
+        long i,
+        long ns,
+        long bucket_ns)
+{
+    long b = ns / bucket_ns;
+
+    l->sample[i] = ns;
+    l->histogram[b < NR_BUCKETS ? b : NR_BUCKETS - 1]++;
+}
+
+
+static long elapsed_ns(
+        const struct timespec *t0,
+        const struct timespec *t1)
+{
+    return (t1->tv_sec - t0->tv_sec) * NSEC_PER_SEC + (t1->tv_nsec - t0->tv_nsec);
+}
+
+
+static void advance(
+        struct timespec *t,
+        long ns)
+{
+    t->tv_nsec += ns;
+    while (t->tv_nsec >= NSEC_PER_SEC) {
+        t->tv_nsec -= NSEC_PER_SEC;
+        t->tv_sec++;
+    }
+}
+
+
+// Touch the pages of the stack that the loop may use, so that their faults
+// happen before the measurement
+static void prefault_stack(void)
+{
+    volatile char stack[256 * 1024];
+    for (size_t i = 0; i < sizeof(stack); i += 4096) stack[i] = 0;
+}
+
+
+static int parse_sweep(
+        const char *name)
+{
+    for (int k = 0; k < NR_CHAIN_SWEEPS; k++) {
+        if (strcmp(name, chain_sweep[k].name) == 0) return k;
+    }
+
+    return -1;
+}
+
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--sweep fpk|fvk|fak|aba|fpkscan|abasub|jac|jdqd]\n"
+            "          [--segments N] [--cycles N] [--branches N] [--threads N]\n"
+            "          [--period US] [--priority PRIO] [--cpu CPU]\n"
+            "          [--bucket NS] [--histogram FILE] [--seed SEED]\n",
+            prog);
+}
+
+
+int main(int argc, char **argv)
+{
+    int k = parse_sweep("aba");
+    int nseg = 7;
+    int nbranches = 1;
+    int nthreads = 1;
+    long ncycles = 100000;
+    long period_ns = 1000000;
+    int priority = 0;
+    int cpu = -1;
+    long bucket_ns = 100;
+    const char *histogram_path = NULL;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--sweep") == 0) {
+            k = parse_sweep(argv[++i]);
+            if (k < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (i + 1 < argc && strcmp(argv[i], "--segments") == 0) {
+            nseg = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--branches") == 0) {
+            nbranches = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            nthreads = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--cycles") == 0) {
+            ncycles = atol(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--period") == 0) {
+            period_ns = atol(argv[++i]) * 1000;
+        } else if (i + 1 < argc && strcmp(argv[i], "--priority") == 0) {
+            priority = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--cpu") == 0) {
+            cpu = atoi(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--bucket") == 0) {
+            bucket_ns = atol(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--histogram") == 0) {
+            histogram_path = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--seed") == 0) {
+            seed = (unsigned)atol(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (nseg < 1 || ncycles < 1 || period_ns < 0 || bucket_ns < 1
+            || nbranches < 1 || nthreads < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+
+    // Everything is allocated before the memory is locked and the
+    // measurement starts
+    srand(seed);
+
+    struct chain c;
+    struct sample x;
+    struct latency *wakeup = calloc(1, sizeof(struct latency));
+    struct latency *sweep = calloc(1, sizeof(struct latency));
+    if (!wakeup || !sweep
+            || !(wakeup->sample = calloc(ncycles, sizeof(long)))
+            || !(sweep->sample = calloc(ncycles, sizeof(long)))
+            || chain_create(nseg, AXIS_MIX_RANDOM, LAYOUT_PACKED, &c) != 0
+            || (nbranches > 1 && chain_branch(&c, nbranches) != 0)
+            || sample_create(&c.kc, nthreads, &x) != 0) {
+        fprintf(stderr, "cannot allocate %ld cycles\n", ncycles);
+        return 1;
+    }
+
+    FILE *histogram = NULL;
+    if (histogram_path) {
+        histogram = fopen(histogram_path, "w");
+        if (!histogram) {
+            fprintf(stderr, "cannot open %s\n", histogram_path);
+            return 1;
+        }
+        fprintf(histogram, "latency,ns,count\n");
+    }
+
+
+    // Real-time setup; every step that fails is reported, but the
+    // measurement still runs
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err) fprintf(stderr, "warning: cannot pin to CPU %d: %s\n", cpu, strerror(err));
+    }
+
+    if (priority > 0) {
+        struct sched_param param = { .sched_priority = priority };
+        int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err) fprintf(stderr, "warning: cannot use SCHED_FIFO: %s\n", strerror(err));
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        fprintf(stderr, "warning: cannot lock the memory: %s\n", strerror(errno));
+    }
+
+    prefault_stack();
+
+    // The samples and histograms are written once before the run so that
+    // recording them does not fault either
+    memset(wakeup->sample, 0, ncycles * sizeof(long));
+    memset(sweep->sample, 0, ncycles * sizeof(long));
+    memset(wakeup->histogram, 0, sizeof(wakeup->histogram));
+    memset(sweep->histogram, 0, sizeof(sweep->histogram));
+
+    // The first read of the clock faults in the page of the vDSO's data
+    struct rusage usage0, usage1;
+    struct timespec next, t0, t1;
+
+    const sweep_fn fn = chain_sweep[k].fn;
+    for (int i = 0; i < NR_WARMUP; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        fn(&c.kc, &x);
+    }
+
+
+    getrusage(RUSAGE_THREAD, &usage0);
+    alloc_count = 0;
+    alloc_counting = 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (long i = 0; i < ncycles; i++) {
+        if (period_ns > 0) {
+            advance(&next, period_ns);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        fn(&c.kc, &x);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        record(wakeup, i, period_ns > 0 ? elapsed_ns(&next, &t0) : 0, bucket_ns);
+        record(sweep, i, elapsed_ns(&t0, &t1), bucket_ns);
+    }
+
+    alloc_counting = 0;
+    getrusage(RUSAGE_THREAD, &usage1);
+
+
+    printf("sweep: %s, segments: %d, branches: %d, threads: %d, cycles: %ld, period: %ld us\n",
+            chain_sweep[k].name, nseg, nbranches, nthreads, ncycles, period_ns / 1000);
+    printf("minor page faults: %ld, major page faults: %ld, allocations: ",
+            usage1.ru_minflt - usage0.ru_minflt,
+            usage1.ru_majflt - usage0.ru_majflt);
+    if (BENCH_HAVE_ALLOC_COUNT) {
+        printf("%lu\n\n", alloc_count);
+    } else {
+        printf("not counted\n\n");
+    }
+
+    printf("%-8s %10s %10s %10s %10s %10s\n", "ns", "min", "p50", "p99", "p99.9", "max");
+    if (period_ns > 0) report("wakeup", wakeup, ncycles, bucket_ns, histogram);
+    report("sweep", sweep, ncycles, bucket_ns, histogram);
+
+    if (histogram) fclose(histogram);
+
+    munlockall();
+    sample_destroy(&x);
+    chain_destroy(&c);
+    free(sweep->sample);
+    free(wakeup->sample);
+    free(sweep);
+    free(wakeup);
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "bench.h"
+
+#include <dyn2b/functions/linear_algebra.h>
+
+
+// Dimension of the general kernels: spatial vectors and 6x6 matrices
+#define N 6
+
+#define A BENCH_OPERAND(slot, 0)
+#define B BENCH_OPERAND(slot, 1)
+#define C BENCH_OPERAND(slot, 2)
+#define D BENCH_OPERAND(slot, 3)
+
+
+static void bench_la_dscal_o(double *slot) { la_dscal_o(N, 1.0, A, 1, B, 1); }
+static void bench_la_dscal_i(double *slot) { la_dscal_i(N, 1.0, A, 1); }
+static void bench_la_dgeadd_os(double *slot) { la_dgeadd_os(N, N, A, N, B, N, C, N); }
+static void bench_la_dgeadd_is(double *slot) { la_dgeadd_is(N, N, A, N, B, N); }
+static void bench_la_daxpy_oe(double *slot) { la_daxpy_oe(N, 1.0, A, 1, B, 1, C, 1); }
+static void bench_la_daxpy_ie(double *slot) { la_daxpy_ie(N, 1.0, A, 1, B, 1); }
+static void bench_la_ddot(double *slot) { la_ddot(N, A, 1, B, 1, C); }
+static void bench_la_dsincos(double *slot) { la_dsincos(BENCH_OPERAND_SIZE, A, 1, B, 1, C, 1); }
+static void bench_la_dcross_o(double *slot) { la_dcross_o(A, 1, B, 1, C, 1); }
+static void bench_la_dcrossop(double *slot) { la_dcrossop(A, 1, B, 3); }
+
+static void bench_la_dgemv_nos(double *slot) { la_dgemv_nos(N, N, A, N, B, 1, C, 1); }
+static void bench_la_dgemv_tos(double *slot) { la_dgemv_tos(N, N, A, N, B, 1, C, 1); }
+static void bench_la_dgemv_noe(double *slot) { la_dgemv_noe(N, N, 1.0, A, N, B, 1, 1.0, C, 1, D, 1); }
+static void bench_la_dgemv_toe(double *slot) { la_dgemv_toe(N, N, 1.0, A, N, B, 1, 1.0, C, 1, D, 1); }
+
+static void bench_la_dgemm_nnos(double *slot) { la_dgemm_nnos(N, N, N, A, N, B, N, C, N); }
+static void bench_la_dgemm_ntos(double *slot) { la_dgemm_ntos(N, N, N, A, N, B, N, C, N); }
+static void bench_la_dgemm_tnos(double *slot) { la_dgemm_tnos(N, N, N, A, N, B, N, C, N); }
+static void bench_la_dgemm_ttos(double *slot) { la_dgemm_ttos(N, N, N, A, N, B, N, C, N); }
+static void bench_la_dgemm_nnoe(double *slot) { la_dgemm_nnoe(N, N, N, 1.0, A, N, B, N, 1.0, C, N, D, N); }
+static void bench_la_dgemm_tnoe(double *slot) { la_dgemm_tnoe(N, N, N, 1.0, A, N, B, N, 1.0, C, N, D, N); }
+static void bench_la_dgemm_ntoe(double *slot) { la_dgemm_ntoe(N, N, N, 1.0, A, N, B, N, 1.0, C, N, D, N); }
+
+static void bench_la_d33gemv_nos(double *slot) { la_d33gemv_nos(A, B, C); }
+static void bench_la_d33gemv_tos(double *slot) { la_d33gemv_tos(A, B, C); }
+static void bench_la_d33gemv_noe(double *slot) { la_d33gemv_noe(1.0, A, B, 1.0, C, D); }
+static void bench_la_d33gemv_toe(double *slot) { la_d33gemv_toe(1.0, A, B, 1.0, C, D); }
+static void bench_la_d33gemm_nnos(double *slot) { la_d33gemm_nnos(A, B, C); }
+static void bench_la_d33gemm_tnos(double *slot) { la_d33gemm_tnos(A, B, C); }
+static void bench_la_d33gemm_nnoe(double *slot) { la_d33gemm_nnoe(1.0, A, B, 1.0, C, D); }
+static void bench_la_d33gemm_ntoe(double *slot) { la_d33gemm_ntoe(1.0, A, B, 1.0, C, D); }
+static void bench_la_d33gecongr_tos(double *slot) { la_d33gecongr_tos(A, B, C); }
+static void bench_la_d33crossgemm_noe(double *slot) { la_d33crossgemm_noe(1.0, A, B, 1.0, C, D); }
+static void bench_la_d33crossgemm_toe(double *slot) { la_d33crossgemm_toe(1.0, A, B, 1.0, C, D); }
+static void bench_la_d33gemmcross_noe(double *slot) { la_d33gemmcross_noe(1.0, A, B, 1.0, C, D); }
+
+static void bench_la_dsytrf_los(double *slot) { la_dsytrf_los(N, A, N, B, N); }
+static void bench_la_trsv_lnd(double *slot) { la_trsv_lnd(N, A, N, B, 1, C, 1); }
+static void bench_la_trsv_ltd(double *slot) { la_trsv_ltd(N, A, N, B, 1, C, 1); }
+
+
+void linear_algebra_bench(struct bench_suite *s)
+{
+    bench_add(s, "la_dscal_o", N, bench_la_dscal_o);
+    bench_add(s, "la_dscal_i", N, bench_la_dscal_i);
+    bench_add(s, "la_dgeadd_os", N * N, bench_la_dgeadd_os);
+    bench_add(s, "la_dgeadd_is", N * N, bench_la_dgeadd_is);
+    bench_add(s, "la_daxpy_oe", 2 * N, bench_la_daxpy_oe);
+    bench_add(s, "la_daxpy_ie", 2 * N, bench_la_daxpy_ie);
+    bench_add(s, "la_ddot", 2 * N, bench_la_ddot);
+    // Reduction and both polynomials per element
+    bench_add(s, "la_dsincos", 40 * BENCH_OPERAND_SIZE, bench_la_dsincos);
+    bench_add(s, "la_dcross_o", 9, bench_la_dcross_o);
+    bench_add(s, "la_dcrossop", 0, bench_la_dcrossop);
+
+    bench_add(s, "la_dgemv_nos", 2 * N * N, bench_la_dgemv_nos);
+    bench_add(s, "la_dgemv_tos", 2 * N * N, bench_la_dgemv_tos);
+    bench_add(s, "la_dgemv_noe", 2 * N * N + 3 * N, bench_la_dgemv_noe);
+    bench_add(s, "la_dgemv_toe", 2 * N * N + 3 * N, bench_la_dgemv_toe);
+
+    bench_add(s, "la_dgemm_nnos", 2 * N * N * N, bench_la_dgemm_nnos);
+    bench_add(s, "la_dgemm_ntos", 2 * N * N * N, bench_la_dgemm_ntos);
+    bench_add(s, "la_dgemm_tnos", 2 * N * N * N, bench_la_dgemm_tnos);
+    bench_add(s, "la_dgemm_ttos", 2 * N * N * N, bench_la_dgemm_ttos);
+    bench_add(s, "la_dgemm_nnoe", 2 * N * N * N + 3 * N * N, bench_la_dgemm_nnoe);
+    bench_add(s, "la_dgemm_tnoe", 2 * N * N * N + 3 * N * N, bench_la_dgemm_tnoe);
+    bench_add(s, "la_dgemm_ntoe", 2 * N * N * N + 3 * N * N, bench_la_dgemm_ntoe);
+
+    bench_add(s, "la_d33gemv_nos", 15, bench_la_d33gemv_nos);
+    bench_add(s, "la_d33gemv_tos", 15, bench_la_d33gemv_tos);
+    bench_add(s, "la_d33gemv_noe", 24, bench_la_d33gemv_noe);
+    bench_add(s, "la_d33gemv_toe", 24, bench_la_d33gemv_toe);
+    bench_add(s, "la_d33gemm_nnos", 45, bench_la_d33gemm_nnos);
+    bench_add(s, "la_d33gemm_tnos", 45, bench_la_d33gemm_tnos);
+    bench_add(s, "la_d33gemm_nnoe", 72, bench_la_d33gemm_nnoe);
+    bench_add(s, "la_d33gemm_ntoe", 72, bench_la_d33gemm_ntoe);
+    bench_add(s, "la_d33gecongr_tos", 90, bench_la_d33gecongr_tos);
+    bench_add(s, "la_d33crossgemm_noe", 54, bench_la_d33crossgemm_noe);
+    bench_add(s, "la_d33crossgemm_toe", 54, bench_la_d33crossgemm_toe);
+    bench_add(s, "la_d33gemmcross_noe", 54, bench_la_d33gemmcross_noe);
+
+    bench_add(s, "la_dsytrf_los", N * N * N / 3 + N * N, bench_la_dsytrf_los);
+    bench_add(s, "la_trsv_lnd", N * (N - 1), bench_la_trsv_lnd);
+    bench_add(s, "la_trsv_ltd", N * (N - 1), bench_la_trsv_ltd);
+
+    // la_dsytrfr_lo is declared but has no implementation yet
+}
@@ -0,0 +1,285 @@
+#include "bench.h"
+
+#include <dyn2b/functions/linear_algebra.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+extern void linear_algebra_bench(struct bench_suite *s);
+extern void geometry_bench(struct bench_suite *s);
+extern void mechanics_bench(struct bench_suite *s);
+extern void kinematic_chain_bench(struct bench_suite *s);
+
+
+#define MAX_BENCHMARKS 256
+#define NR_SAMPLES 9
+
+
+struct bench_case
+{
+    const char *name;
+    double flops;
+    bench_fn fn;
+};
+
+struct bench_suite
+{
+    struct bench_case bench[MAX_BENCHMARKS];
+    int count;
+};
+
+struct bench_result
+{
+    double ns;                      // per call
+    double cycles;                  // per call (time-stamp counter)
+};
+
+
+static const char *isa_name[] = {
+    [LA_ISA_SCALAR] = "scalar",
+    [LA_ISA_SSE2] = "sse2",
+    [LA_ISA_AVX2] = "avx2",
+    [LA_ISA_AVX512] = "avx512"
+};
+
+
+void bench_add(
+        struct bench_suite *s,
+        const char *name,
+        double flops,
+        bench_fn fn)
+{
+    if (s->count == MAX_BENCHMARKS) {
+        fprintf(stderr, "too many benchmarks, dropping %s\n", name);
+        return;
+    }
+
+    s->bench[s->count++] = (struct bench_case) { name, flops, fn };
+}
+
+
+static int compare_double(
+        const void *a,
+        const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+static void bench_noop(double *slot)
+{
+    (void)slot;
+}
+
+
+/**
+ * Median over NR_SAMPLES batches of the time per call. The batch size is
+ * doubled until one batch takes at least min_ns / NR_SAMPLES.
+ */
+static struct bench_result measure(
+        bench_fn fn,
+        double *pool,
+        const int *order,
+        int nslots,
+        double min_ns)
+{
+    long batch = 1;
+    int next = 0;
+
+    for (;;) {
+        double t0 = bench_now_ns();
+        for (long i = 0; i < batch; i++) {
+            fn(&pool[(long)order[next] * BENCH_SLOT_SIZE]);
+            if (++next == nslots) next = 0;
+        }
+        if (bench_now_ns() - t0 >= min_ns / NR_SAMPLES) break;
+        batch *= 2;
+    }
+
+    double ns[NR_SAMPLES];
+    double cycles[NR_SAMPLES];
+    for (int k = 0; k < NR_SAMPLES; k++) {
+        double t0 = bench_now_ns();
+        unsigned long long c0 = bench_now_cycles();
+        for (long i = 0; i < batch; i++) {
+            fn(&pool[(long)order[next] * BENCH_SLOT_SIZE]);
+            if (++next == nslots) next = 0;
+        }
+        unsigned long long c1 = bench_now_cycles();
+        double t1 = bench_now_ns();
+
+        ns[k] = (t1 - t0) / batch;
+        cycles[k] = (double)(c1 - c0) / batch;
+    }
+
+    qsort(ns, NR_SAMPLES, sizeof(double), compare_double);
+    qsort(cycles, NR_SAMPLES, sizeof(double), compare_double);
+
+    return (struct bench_result) { ns[NR_SAMPLES / 2], cycles[NR_SAMPLES / 2] };
+}
+
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--filter SUBSTRING] [--isa scalar|sse2|avx2|avx512]\n"
+            "          [--json FILE] [--min-time MS] [--pool-mb MB]\n",
+            prog);
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    const char *json_path = NULL;
+    double min_ms = 50.0;
+    long pool_mb = 256;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && strcmp(argv[i], "--filter") == 0) {
+            filter = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--json") == 0) {
+            json_path = argv[++i];
+        } else if (i + 1 < argc && strcmp(argv[i], "--min-time") == 0) {
+            min_ms = atof(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--pool-mb") == 0) {
+            pool_mb = atol(argv[++i]);
+        } else if (i + 1 < argc && strcmp(argv[i], "--isa") == 0) {
+            const char *name = argv[++i];
+            int found = 0;
+            for (int k = 0; k < (int)(sizeof(isa_name) / sizeof(isa_name[0])); k++) {
+                if (strcmp(name, isa_name[k]) == 0) {
+                    if (la_set_isa((enum la_isa)k) != 0) {
+                        fprintf(stderr, "instruction set %s is not available\n", name);
+                        return 1;
+                    }
+                    found = 1;
+                }
+            }
+            if (!found) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+
+    // The pool must be larger than the last-level cache for the cold runs
+    int nslots = (int)(pool_mb * 1024 * 1024 / (BENCH_SLOT_SIZE * sizeof(double)));
+    if (nslots < 1) nslots = 1;
+
+    double *pool = malloc((size_t)nslots * BENCH_SLOT_SIZE * sizeof(double));
+    int *order = malloc((size_t)nslots * sizeof(int));
+    if (!pool || !order) {
+        fprintf(stderr, "cannot allocate a pool of %ld MiB\n", pool_mb);
+        return 1;
+    }
+
+    srand(1);
+    for (long i = 0; i < (long)nslots * BENCH_SLOT_SIZE; i++) {
+        pool[i] = 0.5 + (double)rand() / RAND_MAX;
+    }
+
+    // Visit the slots in random order so that the prefetchers cannot help
+    for (int i = 0; i < nslots; i++) order[i] = i;
+    for (int i = nslots - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    const int warm[1] = { 0 };
+
+
+    struct bench_suite *s = calloc(1, sizeof(struct bench_suite));
+    if (!s) return 1;
+
+    linear_algebra_bench(s);
+    geometry_bench(s);
+    mechanics_bench(s);
+    kinematic_chain_bench(s);
+
+
+    FILE *json = NULL;
+    if (json_path) {
+        json = fopen(json_path, "w");
+        if (!json) {
+            fprintf(stderr, "cannot open %s\n", json_path);
+            return 1;
+        }
+    }
+
+    double min_ns = min_ms * 1e6;
+    struct bench_result overhead = measure(bench_noop, pool, warm, 1, min_ns);
+    const char *isa = isa_name[la_get_isa()];
+
+    printf("isa: %s, call overhead: %.2f ns (subtracted)%s\n\n",
+            isa, overhead.ns, BENCH_HAVE_CYCLES ? "" : ", no cycle counter");
+    printf("%-44s %10s %10s %10s %10s %10s %10s\n", "benchmark",
+            "warm ns", "cycles", "GFLOP/s", "cold ns", "cycles", "GFLOP/s");
+
+    if (json) {
+        fprintf(json, "{\n  \"isa\": \"%s\",\n  \"overhead_ns\": %.3f,\n"
+                "  \"pool_mb\": %ld,\n  \"benchmarks\": [", isa, overhead.ns, pool_mb);
+    }
+
+    int first = 1;
+    for (int i = 0; i < s->count; i++) {
+        const struct bench_case *b = &s->bench[i];
+        if (filter && !strstr(b->name, filter)) continue;
+
+        struct bench_result r[2] = {
+            measure(b->fn, pool, warm, 1, min_ns),
+            measure(b->fn, pool, order, nslots, min_ns)
+        };
+
+        double gflops[2];
+        for (int k = 0; k < 2; k++) {
+            r[k].ns -= overhead.ns;
+            r[k].cycles -= overhead.cycles;
+            if (r[k].ns < 0.0) r[k].ns = 0.0;
+            if (r[k].cycles < 0.0) r[k].cycles = 0.0;
+            gflops[k] = r[k].ns > 0.0 ? b->flops / r[k].ns : 0.0;
+        }
+
+        printf("%-44s %10.2f %10.1f %10.2f %10.2f %10.1f %10.2f\n", b->name,
+                r[0].ns, r[0].cycles, gflops[0], r[1].ns, r[1].cycles, gflops[1]);
+
+        if (json) {
+            static const char *variant[2] = { "warm", "cold" };
+            for (int k = 0; k < 2; k++) {
+                fprintf(json, "%s\n    { \"name\": \"%s\", \"variant\": \"%s\", "
+                        "\"ns_per_call\": %.3f, \"cycles_per_call\": ",
+                        first ? "" : ",", b->name, variant[k], r[k].ns);
+                if (BENCH_HAVE_CYCLES) {
+                    fprintf(json, "%.1f", r[k].cycles);
+                } else {
+                    fprintf(json, "null");
+                }
+                fprintf(json, ", \"flops_per_call\": %.0f, \"gflops\": %.3f }",
+                        b->flops, gflops[k]);
+                first = 0;
+            }
+        }
+    }
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+
+    free(s);
+    free(order);
+    free(pool);
+
+    return 0;
+}
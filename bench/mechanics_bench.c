@@ -0,0 +1,170 @@
+#include "bench.h"
+
+#include <dyn2b/functions/mechanics.h>
+
+
+static void bench_mc_momentum_derive(double *slot)
+{
+    struct gc_twist xd = bench_twist(BENCH_OPERAND(slot, 0));
+    struct mc_momentum p = bench_momentum(BENCH_OPERAND(slot, 1));
+    struct mc_wrench r = bench_wrench(BENCH_OPERAND(slot, 2));
+
+    mc_momentum_derive(&xd, &p, &r, 1);
+}
+
+
+static void bench_mc_wrench_tf_tgt_to_ref(double *slot)
+{
+    struct gc_pose x = bench_pose(BENCH_OPERAND(slot, 0));
+    struct mc_wrench f = bench_wrench(BENCH_OPERAND(slot, 1));
+    struct mc_wrench r = bench_wrench(BENCH_OPERAND(slot, 2));
+
+    mc_wrench_tf_tgt_to_ref(&x, &f, &r, 1);
+}
+
+
+static void bench_mc_wrench_invert(double *slot)
+{
+    struct mc_wrench f = bench_wrench(BENCH_OPERAND(slot, 0));
+    struct mc_wrench r = bench_wrench(BENCH_OPERAND(slot, 1));
+
+    mc_wrench_invert(&f, &r, 1);
+}
+
+
+static void bench_mc_wrench_add(double *slot)
+{
+    struct mc_wrench f1 = bench_wrench(BENCH_OPERAND(slot, 0));
+    struct mc_wrench f2 = bench_wrench(BENCH_OPERAND(slot, 1));
+    struct mc_wrench r = bench_wrench(BENCH_OPERAND(slot, 2));
+
+    mc_wrench_add(&f1, &f2, &r, 1);
+}
+
+
+static void bench_mc_wrench_sub(double *slot)
+{
+    struct mc_wrench f1 = bench_wrench(BENCH_OPERAND(slot, 0));
+    struct mc_wrench f2 = bench_wrench(BENCH_OPERAND(slot, 1));
+    struct mc_wrench r = bench_wrench(BENCH_OPERAND(slot, 2));
+
+    mc_wrench_sub(&f1, &f2, &r, 1);
+}
+
+
+static void bench_mc_rbi_map_twist_to_momentum(double *slot)
+{
+    const struct mc_rbi *m = (struct mc_rbi *)BENCH_OPERAND(slot, 0);
+    struct gc_twist xd = bench_twist(BENCH_OPERAND(slot, 1));
+    struct mc_momentum r = bench_momentum(BENCH_OPERAND(slot, 2));
+
+    mc_rbi_map_twist_to_momentum(m, &xd, &r);
+}
+
+
+static void bench_mc_rbi_map_acc_twist_to_wrench(double *slot)
+{
+    const struct mc_rbi *m = (struct mc_rbi *)BENCH_OPERAND(slot, 0);
+    struct gc_acc_twist xdd = bench_acc_twist(BENCH_OPERAND(slot, 1));
+    struct mc_wrench r = bench_wrench(BENCH_OPERAND(slot, 2));
+
+    mc_rbi_map_acc_twist_to_wrench(m, &xdd, &r);
+}
+
+
+static void bench_mc_rbi_to_abi(double *slot)
+{
+    const struct mc_rbi *m = (struct mc_rbi *)BENCH_OPERAND(slot, 0);
+    struct mc_abi *r = (struct mc_abi *)BENCH_OPERAND(slot, 1);
+
+    mc_rbi_to_abi(m, r);
+}
+
+
+static void bench_mc_abi_tf_tgt_to_ref(double *slot)
+{
+    struct gc_pose x = bench_pose(BENCH_OPERAND(slot, 0));
+    const struct mc_abi *m = (struct mc_abi *)BENCH_OPERAND(slot, 1);
+    struct mc_abi *r = (struct mc_abi *)BENCH_OPERAND(slot, 2);
+
+    mc_abi_tf_tgt_to_ref(&x, m, r);
+}
+
+
+static void bench_mc_abi_add(double *slot)
+{
+    const struct mc_abi *m1 = (struct mc_abi *)BENCH_OPERAND(slot, 0);
+    const struct mc_abi *m2 = (struct mc_abi *)BENCH_OPERAND(slot, 1);
+    struct mc_abi *r = (struct mc_abi *)BENCH_OPERAND(slot, 2);
+
+    mc_abi_add(m1, m2, r);
+}
+
+
+static void bench_mc_abi_map_acc_twist_to_wrench(double *slot)
+{
+    const struct mc_abi *m = (struct mc_abi *)BENCH_OPERAND(slot, 0);
+    struct gc_acc_twist xdd = bench_acc_twist(BENCH_OPERAND(slot, 1));
+    struct mc_wrench f = bench_wrench(BENCH_OPERAND(slot, 2));
+
+    mc_abi_map_acc_twist_to_wrench(m, &xdd, &f);
+}
+
+
+static void bench_mc_rbi_to_abi_packed(double *slot)
+{
+    const struct mc_rbi *m = (struct mc_rbi *)BENCH_OPERAND(slot, 0);
+    struct mc_abi_packed *r = (struct mc_abi_packed *)BENCH_OPERAND(slot, 1);
+
+    mc_rbi_to_abi_packed(m, r);
+}
+
+
+static void bench_mc_abi_packed_tf_tgt_to_ref(double *slot)
+{
+    struct gc_pose x = bench_pose(BENCH_OPERAND(slot, 0));
+    const struct mc_abi_packed *m = (struct mc_abi_packed *)BENCH_OPERAND(slot, 1);
+    struct mc_abi_packed *r = (struct mc_abi_packed *)BENCH_OPERAND(slot, 2);
+
+    mc_abi_packed_tf_tgt_to_ref(&x, m, r);
+}
+
+
+static void bench_mc_abi_packed_add(double *slot)
+{
+    const struct mc_abi_packed *m1 = (struct mc_abi_packed *)BENCH_OPERAND(slot, 0);
+    const struct mc_abi_packed *m2 = (struct mc_abi_packed *)BENCH_OPERAND(slot, 1);
+    struct mc_abi_packed *r = (struct mc_abi_packed *)BENCH_OPERAND(slot, 2);
+
+    mc_abi_packed_add(m1, m2, r);
+}
+
+
+static void bench_mc_abi_packed_map_acc_twist_to_wrench(double *slot)
+{
+    const struct mc_abi_packed *m = (struct mc_abi_packed *)BENCH_OPERAND(slot, 0);
+    struct gc_acc_twist xdd = bench_acc_twist(BENCH_OPERAND(slot, 1));
+    struct mc_wrench f = bench_wrench(BENCH_OPERAND(slot, 2));
+
+    mc_abi_packed_map_acc_twist_to_wrench(m, &xdd, &f);
+}
+
+
+void mechanics_bench(struct bench_suite *s)
+{
+    bench_add(s, "mc_momentum_derive", 3 * 9 + 3, bench_mc_momentum_derive);
+    bench_add(s, "mc_wrench_tf_tgt_to_ref", 15 + 9 + 24, bench_mc_wrench_tf_tgt_to_ref);
+    bench_add(s, "mc_wrench_invert", 6, bench_mc_wrench_invert);
+    bench_add(s, "mc_wrench_add", 6, bench_mc_wrench_add);
+    bench_add(s, "mc_wrench_sub", 6, bench_mc_wrench_sub);
+    bench_add(s, "mc_rbi_map_twist_to_momentum", 2 * 9 + 24 + 3 + 6, bench_mc_rbi_map_twist_to_momentum);
+    bench_add(s, "mc_rbi_map_acc_twist_to_wrench", 2 * 9 + 24 + 3 + 6, bench_mc_rbi_map_acc_twist_to_wrench);
+    bench_add(s, "mc_rbi_to_abi", 0, bench_mc_rbi_to_abi);
+    bench_add(s, "mc_abi_tf_tgt_to_ref", 3 * 90 + 3 * 54, bench_mc_abi_tf_tgt_to_ref);
+    bench_add(s, "mc_abi_add", 27, bench_mc_abi_add);
+    bench_add(s, "mc_abi_map_acc_twist_to_wrench", 2 * 15 + 2 * 24, bench_mc_abi_map_acc_twist_to_wrench);
+    bench_add(s, "mc_rbi_to_abi_packed", 0, bench_mc_rbi_to_abi_packed);
+    bench_add(s, "mc_abi_packed_tf_tgt_to_ref", 2 * 75 + 90 + 54 + 72, bench_mc_abi_packed_tf_tgt_to_ref);
+    bench_add(s, "mc_abi_packed_add", 21, bench_mc_abi_packed_add);
+    bench_add(s, "mc_abi_packed_map_acc_twist_to_wrench", 2 * 15 + 36, bench_mc_abi_packed_map_acc_twist_to_wrench);
+}
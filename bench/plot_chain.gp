@@ -0,0 +1,19 @@
+# Plot the per-segment cost of the sweeps over the chain length.
+#
+# usage: dyn2b_chain_bench --csv chain.csv
+#        gnuplot -e "csv='chain.csv'" plot_chain.gp
+
+if (!exists("csv")) csv = "chain.csv"
+
+set datafile separator ","
+set terminal pngcairo size 900,600
+set output csv.".png"
+
+set xlabel "segments"
+set ylabel "ns per segment"
+set logscale x 2
+set key top left
+set grid
+
+plot for [a in "fpk fvk fak aba"] csv \
+        using 1:(strcol(5) eq a ? $8 : 1/0) skip 1 with linespoints title a
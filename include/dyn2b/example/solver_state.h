@@ -11,6 +11,8 @@ extern "C" {
 
 /**
  * Setup the solver state for a simple task and a serial kinematic chain.
+ *
+ * The state must be released with solver_state_destroy_c().
  */
 void setup_simple_state_c(
         const struct kcc_kinematic_chain *kc,
@@ -0,0 +1,147 @@
+#ifndef DYN2B_FUNCTIONS_EXECUTOR_H
+#define DYN2B_FUNCTIONS_EXECUTOR_H
+
+#include <dyn2b/types/executor.h>
+#include <dyn2b/types/mechanics.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Thread pool that solves many independent instances of the same chain, or
+ * the independent subtrees of one instance of a tree.
+ *
+ * Every worker owns a solver state for the chain that is allocated once when
+ * the executor is created. The samples of a job are split into one contiguous
+ * range per worker. A worker takes grain samples at a time from the front of
+ * its own range and, once that is exhausted, steals the back half of another
+ * worker's range. The calling thread acts as worker 0 until the job is done.
+ *
+ * An executor must only be used by one thread at a time.
+ */
+
+
+/**
+ * Start nthreads - 1 worker threads and allocate one solver state per
+ * worker. With nthreads <= 0 one worker per online CPU is used.
+ *
+ * Returns 0 on success and -1 if a thread or a solver state could not be
+ * created.
+ */
+int kcc_executor_create(
+        const struct kcc_kinematic_chain *kc,
+        int nthreads,
+        struct kcc_executor *ex);
+
+/**
+ * Stop the worker threads and release the solver states.
+ */
+void kcc_executor_destroy(
+        struct kcc_executor *ex);
+
+/**
+ * Call task for every index in [0, count) and return when all calls have
+ * finished. With grain <= 0 a grain size is chosen from count and the number
+ * of workers.
+ */
+void kcc_executor_run(
+        struct kcc_executor *ex,
+        int count,
+        int grain,
+        kcc_task task,
+        void *data);
+
+/**
+ * Forward dynamics (see kcc_aba()) of count independent instances.
+ *
+ * q: count x nq, one row per instance
+ * qd: count x nd
+ * tau: count x nd
+ * f_ext: count wrenches with nbody entries each (may be NULL)
+ * xdd_base: acceleration twist of the base, shared by all instances (may be
+ *           NULL for an unaccelerated base); the base does not move
+ * qdd: count x nd
+ */
+void kcc_executor_aba(
+        struct kcc_executor *ex,
+        int count,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct mc_wrench *f_ext,
+        const struct gc_acc_twist *xdd_base,
+        joint_acceleration *qdd);
+
+/**
+ * Inverse dynamics (see kcc_rnea()) of count independent instances.
+ *
+ * q: count x nq, one row per instance
+ * qd: count x nd (may be NULL)
+ * qdd: count x nd (may be NULL)
+ * f_ext: count wrenches with nbody entries each (may be NULL)
+ * xdd_base: acceleration twist of the base, shared by all instances (may be
+ *           NULL for an unaccelerated base); the base does not move
+ * tau: count x nd
+ */
+void kcc_executor_rnea(
+        struct kcc_executor *ex,
+        int count,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_acceleration *qdd,
+        const struct mc_wrench *f_ext,
+        const struct gc_acc_twist *xdd_base,
+        joint_torque *tau);
+
+/**
+ * Forward dynamics (see kcc_aba()) of one instance of a tree with the
+ * subtrees below its first branching body solved concurrently.
+ *
+ * The trunk, i.e. the path from the base to the first body with more than one
+ * child, is solved by the calling thread. Every child of the branching body
+ * roots one subtree, e.g. the legs and the torso of a humanoid, whose outward
+ * and inward passes run as one task; their articulated inertias and bias
+ * forces are joined at the branching body before the trunk's inward pass.
+ * The subtrees' accelerations are again solved concurrently after the
+ * trunk's. Deeper branches of a subtree are solved by the subtree's task.
+ *
+ * The arguments are those of kcc_aba(); all workers operate on the caller's
+ * solver state s. Serial chains are solved by the calling thread alone. Since
+ * each call posts two jobs to the pool, this only pays off if the subtrees'
+ * passes take longer than waking up the workers.
+ */
+void kcc_executor_aba_subtrees(
+        struct kcc_executor *ex,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        joint_acceleration *qdd);
+
+/**
+ * Forward position kinematics (see kcc_fpk()) of one instance of a serial
+ * chain as a parallel prefix scan over the workers.
+ *
+ * Pose composition is associative, hence the chain is split into one block
+ * of consecutive segments per worker. The workers compute their blocks'
+ * relative poses and the prefix products within the blocks concurrently, the
+ * calling thread chains the blocks' last poses to the base, and the workers
+ * finally compose their blocks' remaining poses with the preceding block's
+ * last pose. That doubles the compositions but divides the sweep's critical
+ * path by the number of workers.
+ *
+ * Trees and chains with fewer than two segments per worker are solved by
+ * kcc_fpk() on the calling thread.
+ */
+void kcc_executor_fpk(
+        struct kcc_executor *ex,
+        const joint_position *q,
+        struct solver_state_c *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
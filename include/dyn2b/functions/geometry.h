@@ -18,6 +18,23 @@ void gc_pose_compose(
         const struct gc_pose *x2,
         struct gc_pose *r);
 
+/**
+ * Compose an elementary rotation with a pose (coordinates).
+ *
+ * X_1 X_2
+ */
+void gc_pose_compose_elementary(
+        const struct gc_elementary_pose *x1,
+        const struct gc_pose *x2,
+        struct gc_pose *r);
+
+/**
+ * Expand an elementary rotation to a pose (coordinates).
+ */
+void gc_elementary_pose_to_pose(
+        const struct gc_elementary_pose *x,
+        struct gc_pose *r);
+
 /**
  * Compose two poses (ADT).
  *
@@ -52,6 +69,28 @@ void gc_twist_tf_ref_to_tgt(
         const struct gc_twist *xd,
         struct gc_twist *r);
 
+/**
+ * Transform twist from the pose's target frame to the pose's reference frame
+ * (coordinates).
+ *
+ * X^{-1} Xd
+ */
+void gc_twist_tf_tgt_to_ref(
+        const struct gc_pose *x,
+        const struct gc_twist *xd,
+        struct gc_twist *r);
+
+/**
+ * Transform twist over an elementary rotation from the pose's reference frame
+ * to the pose's target frame (coordinates).
+ *
+ * X Xd
+ */
+void gc_twist_tf_ref_to_tgt_elementary(
+        const struct gc_elementary_pose *x,
+        const struct gc_twist *xd,
+        struct gc_twist *r);
+
 /**
  * Transform twist from the pose's reference frame to the pose's target frame
  * (ADT).
@@ -127,6 +166,17 @@ void gc_acc_twist_tf_ref_to_tgt(
         const struct gc_acc_twist *xdd,
         struct gc_acc_twist *r);
 
+/**
+ * Transform acceleration twist over an elementary rotation from the pose's
+ * reference frame to the pose's target frame (coordinates).
+ *
+ * X Xdd
+ */
+void gc_acc_twist_tf_ref_to_tgt_elementary(
+        const struct gc_elementary_pose *x,
+        const struct gc_acc_twist *xdd,
+        struct gc_acc_twist *r);
+
 /**
  * Transform acceleration twist from the pose's reference frame to the pose's
  * target frame (ADT).
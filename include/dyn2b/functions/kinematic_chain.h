@@ -94,8 +94,66 @@ void kca_project_wrench(
         struct ma_wrench *r);
 
 
+/**
+ * Check that the frames, points and bodies of a chain are wired consistently
+ * (ADT).
+ *
+ * These are the checks that the assertions of an ADT sweep over the chain
+ * perform, done once, e.g. when the model is loaded. They do not depend on
+ * assertions, hence they also work when the library is built without them.
+ * The segments of a tree must be in topological order, i.e. every segment's
+ * parent must precede it.
+ *
+ * segment: index of the first inconsistent segment (may be NULL)
+ *
+ * Returns 0 if the chain is consistent and -1 otherwise.
+ */
+int kca_verify(
+        const struct kca_kinematic_chain *kc,
+        int *segment);
+
+/**
+ * Check that a chain is consistent (see kca_verify()) and that its
+ * coordinates are complete and match it, including the tree's parent
+ * indices. On success, the coordinate chain is marked as verified.
+ *
+ * segment: index of the first faulty segment or -1 if the chains differ in
+ *          their number of segments (may be NULL)
+ *
+ * Returns 0 if the chain is valid and -1 otherwise.
+ */
+int kcc_verify(
+        const struct kca_kinematic_chain *kca,
+        struct kcc_kinematic_chain *kcc,
+        int *segment);
+
+/**
+ * Check that the coordinates of a chain are complete and that every segment's
+ * parent precedes it, without an abstract chain to compare them against. The
+ * chain is not marked as verified.
+ *
+ * segment: index of the first faulty segment (may be NULL)
+ *
+ * Returns 0 if the coordinates are valid and -1 otherwise.
+ */
+int kcc_verify_coordinates(
+        const struct kcc_kinematic_chain *kc,
+        int *segment);
+
+
+/**
+ * Operators of a joint type.
+ *
+ * A joint's positions are nq consecutive joint_position values and its
+ * velocities, accelerations and torques nd consecutive values each. The
+ * operators on <count> elements store element i's joint values at offset
+ * i * nd, e.g. tau[i * nd], ..., tau[i * nd + nd - 1] = S^T F[i].
+ */
 struct kcc_joint_operators
 {
+    int nq;                         // number of joint positions
+    int nd;                         // number of motion DoFs
+
     /**
      * Forward position kinematics (coordinates).
      *
@@ -106,6 +164,35 @@ struct kcc_joint_operators
             const joint_position *q,
             struct gc_pose *x);
 
+    /**
+     * Forward position kinematics composed with the joint's attachment
+     * (coordinates).
+     *
+     * x = X_J
+     * r = X_J X_T
+     */
+    void (*fpk_compose)(
+            const struct kcc_joint *joint,
+            const joint_position *q,
+            const struct gc_pose *x_t,
+            struct gc_pose *x,
+            struct gc_pose *r);
+
+    /**
+     * Same as fpk_compose() from the cosines and sines of q (NULL if the
+     * joint's pose does not depend on them).
+     *
+     * x = X_J
+     * r = X_J X_T
+     */
+    void (*fpk_compose_trig)(
+            const struct kcc_joint *joint,
+            const double *cq,
+            const double *sq,
+            const struct gc_pose *x_t,
+            struct gc_pose *x,
+            struct gc_pose *r);
+
     /**
      * Forward velocity kinematics (coordinates).
      *
@@ -149,6 +236,18 @@ struct kcc_joint_operators
             joint_torque *tau,
             int count);
 
+    /**
+     * Torque that accelerates the joint's own inertia on <count>
+     * accelerations (coordinates).
+     *
+     * tau[i] = I_J qdd[i]
+     */
+    void (*inertial_torque)(
+            const struct kcc_joint *joint,
+            const joint_acceleration *qdd,
+            joint_torque *tau,
+            int count);
+
     /**
      * Forward force dynamics on <count> torques (coordinates).
      *
@@ -156,20 +255,35 @@ struct kcc_joint_operators
      */
     void (*ffd)(
             const struct kcc_joint *joint,
-            const struct mc_abi *m,
+            const struct mc_abi_packed *m,
             const joint_torque *tau,
             struct mc_wrench *f,
             int count);
 
+    /**
+     * Forward acceleration dynamics on <count> torques (coordinates).
+     *
+     * qdd[i] = D^{-1} tau[i] = (S^T M^A S + I_J)^{-1} tau[i]
+     */
+    void (*fad)(
+            const struct kcc_joint *joint,
+            const struct mc_abi_packed *m,
+            const joint_torque *tau,
+            joint_acceleration *qdd,
+            int count);
+
     /**
      * Project inertia over a joint (coordinates).
      *
      * M^a = P^T M^A = (1 - M^A S D^{-1} S^T) M^A
+     *
+     * M^a is symmetric, hence only the upper triangles of its zeroth and
+     * second moments of mass are computed.
      */
     void (*project_inertia)(
             const struct kcc_joint *joint,
-            const struct mc_abi *m,
-            struct mc_abi *r);
+            const struct mc_abi_packed *m,
+            struct mc_abi_packed *r);
 
     /**
      * Project an array of <count> wrenches over a joint (coordinates).
@@ -178,15 +292,86 @@ struct kcc_joint_operators
      */
     void (*project_wrench)(
             const struct kcc_joint *joint,
-            const struct mc_abi *m,
+            const struct mc_abi_packed *m,
             const struct mc_wrench *f,
             struct mc_wrench *r,
             int count);
 };
 
 
+/**
+ * Operators of each joint type. They branch on the joint's parameters, e.g.
+ * its axis, on every call.
+ */
 extern const struct kcc_joint_operators kcc_joint[];
 
+/**
+ * Operators of revolute joints, specialized for each axis.
+ */
+extern const struct kcc_joint_operators kcc_revolute_joint[];
+
+/**
+ * Operators of prismatic joints, specialized for each axis.
+ */
+extern const struct kcc_joint_operators kcc_prismatic_joint[];
+
+
+/**
+ * Operators that are specialized for a joint's type and parameters.
+ */
+const struct kcc_joint_operators *kcc_joint_resolve(
+        const struct kcc_joint *joint);
+
+/**
+ * Resolve the specialized operators of every joint of a chain once, e.g. when
+ * the model is loaded, so that the solvers call them without branching on the
+ * joints' parameters. The chain must be complete (see kcc_verify()) and must
+ * be compiled again whenever a joint's type or parameters change.
+ *
+ * A compiled chain must not contain fixed joints: they would still compose an
+ * identity transform and project the inertias and forces in every sweep. Merge
+ * them with kcc_merge_fixed_joints() first, whose result is compiled, so that
+ * they cost nothing per cycle.
+ *
+ * The solvers fall back to kcc_joint[] for joints that are not compiled.
+ *
+ * Returns 0 on success and -1 if the chain contains a fixed joint, in which
+ * case it is left unchanged.
+ */
+int kcc_compile(
+        struct kcc_kinematic_chain *kc);
+
+/**
+ * Number of joint positions and of motion DoFs of a chain, i.e. the sums of
+ * its joints' nq and nd.
+ */
+void kcc_dimensions(
+        const struct kcc_kinematic_chain *kc,
+        int *nq,
+        int *nd);
+
+/**
+ * Merge the links behind fixed joints into their parents' links, so that
+ * fixed joints cost nothing in the sweeps. The attachments of the fixed
+ * joints' children are composed with the fixed joints' attachments, and links
+ * that are fixed to the base are dropped since they do not contribute to the
+ * dynamics. The merged chain is compiled (see kcc_compile()), has the same
+ * tree structure without the fixed segments, and the same joint coordinates.
+ *
+ * The merged chain refers to the joints' parameters of the original chain.
+ *
+ * Returns 0 on success and -1 if the merged chain cannot be allocated.
+ */
+int kcc_merge_fixed_joints(
+        const struct kcc_kinematic_chain *kc,
+        struct kcc_kinematic_chain *r);
+
+/**
+ * Release a chain that was created by kcc_merge_fixed_joints().
+ */
+void kcc_merged_destroy(
+        struct kcc_kinematic_chain *r);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,8 @@
 #ifndef DYN2B_FUNCTIONS_LINEAR_ALGEBRA_H
 #define DYN2B_FUNCTIONS_LINEAR_ALGEBRA_H
 
+#include <dyn2b/types/linear_algebra.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,9 +22,29 @@ extern "C" {
  *   https://blasfeo.syscop.de/docs/naming/#additional-flags
  * - l/u: lower vs. upper
  *   https://blasfeo.syscop.de/docs/naming/#additional-flags
+ *
+ * The unit-stride cases of the vector, matrix-vector and matrix-matrix
+ * operations run on vectorized kernels. The best instruction set supported by
+ * the CPU is selected once when the library is loaded.
  */
 
 
+/**
+ * Instruction set of the kernels that are currently in use.
+ */
+enum la_isa la_get_isa(void);
+
+/**
+ * Switch the kernels to the given instruction set, e.g. to compare results or
+ * timings across instruction sets. Not thread-safe w.r.t. running operations.
+ *
+ * Returns 0 on success and -1 if the library was built without the
+ * instruction set or the CPU does not support it.
+ */
+int la_set_isa(
+        enum la_isa isa);
+
+
 /**
  * Vector scaling (out-of-place)
  * y = alpha * x
@@ -148,6 +170,28 @@ void la_ddot(
         double *y, int incy,
         double *alpha);
 
+/**
+ * Vector sine and cosine (element-wise).
+ * s = sin(x)
+ * c = cos(x)
+ *
+ * x: n x 1
+ * s: n x 1
+ * c: n x 1
+ *
+ * The absolute error is below 1e-15 for |x| <= 1e5; larger and non-finite
+ * arguments are evaluated by libm.
+ *
+ * Reference:
+ * - https://www.netlib.org/fdlibm/k_sin.c
+ * - https://www.netlib.org/fdlibm/k_cos.c
+ */
+void la_dsincos(
+        int n,
+        const double *x, int incx,
+        double *s, int incs,
+        double *c, int incc);
+
 
 /**
  * Vector cross product (out-of-place).
@@ -392,6 +436,146 @@ void la_dgemm_ntoe(
 
 
 
+/**
+ * Fixed-size 3x3 operations
+ *
+ * Specializations of the above operations for dense, row-major 3x3 matrices
+ * and contiguous 3-vectors as they appear in the spatial algebra. Without the
+ * runtime dimensions, leading dimensions and increments the compiler fully
+ * unrolls the loops. The results are accumulated in registers before they are
+ * stored, hence the output may alias any input.
+ */
+
+/**
+ * Matrix-vector product (out-of-place, simple, 3x3).
+ * y = A * x
+ */
+void la_d33gemv_nos(
+        const double *a,
+        const double *x,
+        double *y);
+
+/**
+ * Matrix-vector product (out-of-place, simple, 3x3).
+ * y = A^T * x
+ */
+void la_d33gemv_tos(
+        const double *a,
+        const double *x,
+        double *y);
+
+/**
+ * Matrix-vector product (out-of-place, extended, 3x3).
+ * z = alpha * A * x + beta * y
+ */
+void la_d33gemv_noe(
+        double alpha,
+        const double *a,
+        const double *x,
+        double beta,
+        const double *y,
+        double *z);
+
+/**
+ * Matrix-vector product (out-of-place, extended, 3x3).
+ * z = alpha * A^T * x + beta * y
+ */
+void la_d33gemv_toe(
+        double alpha,
+        const double *a,
+        const double *x,
+        double beta,
+        const double *y,
+        double *z);
+
+/**
+ * Matrix-matrix product (out-of-place, simple, 3x3).
+ * C = A * B
+ */
+void la_d33gemm_nnos(
+        const double *a,
+        const double *b,
+        double *c);
+
+/**
+ * Matrix-matrix product (out-of-place, simple, 3x3).
+ * C = A^T * B
+ */
+void la_d33gemm_tnos(
+        const double *a,
+        const double *b,
+        double *c);
+
+/**
+ * Matrix-matrix product (out-of-place, extended, 3x3).
+ * D = alpha * A * B + beta * C
+ */
+void la_d33gemm_nnoe(
+        double alpha,
+        const double *a,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d);
+
+/**
+ * Matrix-matrix product (out-of-place, extended, 3x3).
+ * D = alpha * A * B^T + beta * C
+ */
+void la_d33gemm_ntoe(
+        double alpha,
+        const double *a,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d);
+
+/**
+ * Congruence transformation (out-of-place, simple, 3x3).
+ * C = E^T * A * E
+ */
+void la_d33gecongr_tos(
+        const double *e,
+        const double *a,
+        double *c);
+
+/**
+ * Product with a cross operator from the left (out-of-place, extended, 3x3).
+ * D = alpha * [x]_x * B + beta * C
+ */
+void la_d33crossgemm_noe(
+        double alpha,
+        const double *x,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d);
+
+/**
+ * Product with a cross operator from the left (out-of-place, extended, 3x3).
+ * D = alpha * [x]_x * B^T + beta * C
+ */
+void la_d33crossgemm_toe(
+        double alpha,
+        const double *x,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d);
+
+/**
+ * Product with a cross operator from the right (out-of-place, extended, 3x3).
+ * D = alpha * A * [x]_x + beta * C
+ */
+void la_d33gemmcross_noe(
+        double alpha,
+        const double *a,
+        const double *x,
+        double beta,
+        const double *c,
+        double *d);
+
+
 /**
  * Rank-one update of a symmetric matrix (lower triangular, out-of-place)
  * B = alpha * x * x^T + A
@@ -417,17 +601,20 @@ void la_dgemm_ntoe(
  * LDL^T factorization of a symmetric matrix (out-of-place)
  * A = L * D * L^T
  * 
- * The factors (L, D) are stored in B.
+ * The factors (L, D) are stored in B: L's unit diagonal is implied, D is
+ * stored on the diagonal and L below it. Only the lower triangle of A is read
+ * and the strictly upper triangle of B is not written. The factorization does
+ * not pivot, hence A must be definite, e.g. an inertia.
  * 
  * Reference:
  * - https://www.netlib.org/lapack/explore-html/dd/df4/dsytrf_8f.html
  * - https://www.netlib.org/lapack/explore-html/d0/d9a/dsytrs_8f.html
  * - https://blasfeo.syscop.de/docs/naming/#factorization
  */
-//void la_dsytrf_los(
-//    int n,
-//    const double *a, int lda,
-//    double *b, int ldb);
+void la_dsytrf_los(
+        int n,
+        const double *a, int lda,
+        double *b, int ldb);
 
 /**
  * Rank-one update of an LDL^T factorization of a symmetric matrix (out-of-place)
@@ -455,9 +642,9 @@ void la_dsytrfr_lo(
  * 
  * "Forward substitution"
  *
- * A: lda x n
+ * A: n x n, only the strictly lower triangle is read
  * b: n x 1
- * x: n x 1
+ * x: n x 1 (may alias b)
  *
  * Reference:
  * - https://www.netlib.org/lapack/explore-html/d6/d96/dtrsv_8f.html
@@ -474,9 +661,9 @@ void la_trsv_lnd(
  * 
  * "Back substitution"
  *
- * A: n x lda
+ * A: n x n, only the strictly lower triangle is read
  * b: n x 1
- * x: n x 1
+ * x: n x 1 (may alias b)
  *
  * Reference:
  * - https://www.netlib.org/lapack/explore-html/d6/d96/dtrsv_8f.html
@@ -10,14 +10,16 @@ extern "C" {
 
 
 /**
- * Spatial cross product's dual (coordinates).
+ * Spatial cross product's dual of two arrays of <count> twists and momenta
+ * (coordinates).
  *
- * Xd x* p
+ * Xd[i] x* p[i]
  */
 void mc_momentum_derive(
         const struct gc_twist *xd,
         const struct mc_momentum *p,
-        struct mc_wrench *r);
+        struct mc_wrench *r,
+        int count);
 
 /**
  * Spatial cross product's dual (ADT).
@@ -148,6 +150,26 @@ void ma_rbi_map_twist_to_momentum(
         const struct ga_twist *xd,
         struct ma_momentum *r);
 
+/**
+ * Map an acceleration twist into a wrench (coordinates).
+ *
+ * M Xdd
+ */
+void mc_rbi_map_acc_twist_to_wrench(
+        const struct mc_rbi *m,
+        const struct gc_acc_twist *xdd,
+        struct mc_wrench *r);
+
+/**
+ * Map an acceleration twist into a wrench (ADT).
+ *
+ * M Xdd
+ */
+void ma_rbi_map_acc_twist_to_wrench(
+        const struct ma_rbi *m,
+        const struct ga_acc_twist *xdd,
+        struct ma_wrench *r);
+
 /**
  * Convert rigid-body inertia to articulated-body inertia (coordinates).
  * 
@@ -166,6 +188,28 @@ void ma_rbi_to_abi(
         const struct ma_rbi *rbi,
         struct ma_abi *r);
 
+/**
+ * Transform rigid-body inertia from pose's target frame to pose's reference
+ * frame (coordinates).
+ *
+ * X^T M X
+ */
+void mc_rbi_tf_tgt_to_ref(
+        const struct gc_pose *x,
+        const struct mc_rbi *m,
+        struct mc_rbi *r);
+
+/**
+ * Add two rigid-body inertias, i.e. rigidly connect the bodies
+ * (coordinates).
+ *
+ * M_1 + M_2
+ */
+void mc_rbi_add(
+        const struct mc_rbi *m1,
+        const struct mc_rbi *m2,
+        struct mc_rbi *r);
+
 /**
  * Print rigid-body inertia (coordinates).
  */
@@ -252,6 +296,77 @@ void mc_abi_log(
 void ma_abi_log(
         const struct ma_abi *m);
 
+
+/**
+ * Articulated-body inertia in packed storage (coordinates).
+ *
+ * The following operations exploit the symmetry of the zeroth and second
+ * moments of mass: they only compute and store the upper triangles. Their
+ * ADT counterparts are the ma_abi_* operations above.
+ */
+
+/**
+ * Pack articulated-body inertia; the lower triangles of the zeroth and second
+ * moments of mass are ignored (coordinates).
+ */
+void mc_abi_pack(
+        const struct mc_abi *m,
+        struct mc_abi_packed *r);
+
+/**
+ * Unpack articulated-body inertia (coordinates).
+ */
+void mc_abi_unpack(
+        const struct mc_abi_packed *m,
+        struct mc_abi *r);
+
+/**
+ * Convert rigid-body inertia to packed articulated-body inertia
+ * (coordinates).
+ *
+ * M^A = M
+ */
+void mc_rbi_to_abi_packed(
+        const struct mc_rbi *rbi,
+        struct mc_abi_packed *r);
+
+/**
+ * Transform packed inertia from pose's target frame to pose's reference frame
+ * (coordinates).
+ *
+ * X^T M^A X
+ */
+void mc_abi_packed_tf_tgt_to_ref(
+        const struct gc_pose *x,
+        const struct mc_abi_packed *m,
+        struct mc_abi_packed *r);
+
+/**
+ * Add two packed articulated-body inertias (coordinates).
+ *
+ * M^A_1 + M^A_2
+ */
+void mc_abi_packed_add(
+        const struct mc_abi_packed *m1,
+        const struct mc_abi_packed *m2,
+        struct mc_abi_packed *r);
+
+/**
+ * Map an acceleration twist into a wrench with packed inertia (coordinates).
+ *
+ * M^A Xdd
+ */
+void mc_abi_packed_map_acc_twist_to_wrench(
+        const struct mc_abi_packed *m,
+        const struct gc_acc_twist *xdd,
+        struct mc_wrench *f);
+
+/**
+ * Print packed articulated-body inertia (coordinates).
+ */
+void mc_abi_packed_log(
+        const struct mc_abi_packed *m);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,320 @@
+#ifndef DYN2B_FUNCTIONS_SOLVER_H
+#define DYN2B_FUNCTIONS_SOLVER_H
+
+#include <dyn2b/types/kinematic_chain.h>
+#include <dyn2b/types/solver_state.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Solvers that sweep over a complete kinematic chain.
+ *
+ * The solvers only operate on the coordinate representation. They neither
+ * allocate memory nor print anything: all intermediate results are stored in
+ * a preallocated solver state that must have been set up for the same chain.
+ *
+ * The joint positions of all segments are stored back to back in q and their
+ * velocities, accelerations and torques in the DoF-sized arrays, i.e. nq and
+ * nd are the sums of the joints' dimensions (see kcc_dimensions()).
+ *
+ * The chain may be a tree (see struct kcc_kinematic_chain). Body i is
+ * segment i - 1's link, body 0 the base, and p(i) the index of body i's parent
+ * body. The sweeps visit the bodies in index order from the base outwards and
+ * in reverse order inwards, hence every parent is visited before (after) its
+ * children.
+ */
+
+
+/**
+ * Cosines and sines of the joint positions.
+ *
+ * q: nq x 1
+ *
+ * Evaluates the cosines and sines of all of q in one vectorized pass (see
+ * la_dsincos()) and stores them in s->cos_q and s->sin_q for the sweeps of
+ * the same cycle: every sweep that composes the joints' poses (kinematics,
+ * dynamics) takes a joint's cosines and sines from there instead of libm as
+ * long as its positions equal those in s->q_trig. Built with ENABLE_FAST_TRIG
+ * off, the stage evaluates libm instead.
+ */
+void kcc_sincos(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s);
+
+
+/**
+ * Forward position kinematics (coordinates).
+ *
+ * q: nq x 1
+ *
+ * The poses i^X_{p(i)} of the links relative to their parents are written to
+ * s->x_rel[i - 1], the poses i^X_0 relative to the base to s->x_tot[i].
+ */
+void kcc_fpk(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s);
+
+/**
+ * Forward position kinematics that reuses the poses of the previous call.
+ *
+ * q: nq x 1
+ *
+ * Same as kcc_fpk(), but only the joints whose positions differ from the
+ * previous call's recompute their poses s->x_jnt and s->x_rel, and only the
+ * links downstream of such a joint recompute s->x_tot. The positions of the
+ * cached poses are kept in s->q_fpk, hence q may also be s->q. Every other
+ * solver that writes to the state's poses invalidates the cache, so that the
+ * next call recomputes all poses.
+ *
+ * Returns the number of links whose pose relative to the base was recomputed.
+ */
+int kcc_fpk_incremental(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s);
+
+/**
+ * Forward velocity kinematics (coordinates).
+ *
+ * q: nq x 1
+ * qd: nd x 1
+ *
+ * Same as kcc_fpk(), and the links' twists are written to s->xd[i]. The
+ * base's twist s->xd[0] is an input.
+ */
+void kcc_fvk(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        struct solver_state_c *s);
+
+/**
+ * Forward acceleration kinematics (coordinates).
+ *
+ * q: nq x 1
+ * qd: nd x 1
+ * qdd: nd x 1
+ *
+ * Same as kcc_fvk(), and the links' acceleration twists are written to
+ * s->xdd[i]. The base's acceleration twist s->xdd[0] is an input.
+ */
+void kcc_fak(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_acceleration *qdd,
+        struct solver_state_c *s);
+
+
+/**
+ * Forward dynamics with the articulated-body algorithm (coordinates).
+ *
+ * qdd = M(q)^{-1} (tau - C(q, qd) + J^T F_ext)
+ *
+ * q: nq x 1
+ * qd: nd x 1
+ * tau: nd x 1
+ * f_ext: external wrenches as structure of arrays, i.e. f_ext->torque and
+ *        f_ext->force hold nbody vectors, one per segment, acting on the
+ *        segment's link and expressed in the link's root frame (may be NULL)
+ * qdd: nd x 1 (may alias s->qdd)
+ *
+ * The base's twist s->xd[0] and acceleration twist s->xdd[0] are inputs. A
+ * gravitational field is modelled by accelerating the base in the opposite
+ * direction, e.g. s->xdd[0].linear_acceleration->z = 9.81.
+ *
+ * Reference:
+ * - [Featherstone2008]: p. 132, Table 7.1
+ */
+void kcc_aba(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        joint_acceleration *qdd);
+
+
+/**
+ * Inverse dynamics with the recursive Newton-Euler algorithm (coordinates).
+ *
+ * tau = M(q) qdd + C(q, qd) - J^T F_ext
+ *
+ * q: nq x 1
+ * qd: nd x 1 (may be NULL for a chain at rest)
+ * qdd: nd x 1 (may be NULL for an unaccelerated chain)
+ * f_ext: external wrenches as in kcc_aba() (may be NULL)
+ * tau: nd x 1
+ *
+ * As in kcc_aba(), the base's twist s->xd[0] and acceleration twist s->xdd[0]
+ * are inputs. Without qd all velocity-dependent terms are skipped and the
+ * base's twist is ignored, i.e. kcc_rnea(kc, q, NULL, NULL, NULL, s, tau)
+ * only computes the gravitational torques.
+ *
+ * Reference:
+ * - [Featherstone2008]: p. 96, Table 5.1
+ */
+void kcc_rnea(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_acceleration *qdd,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        joint_torque *tau);
+
+
+/**
+ * Joint-space mass matrix with the composite-rigid-body algorithm
+ * (coordinates).
+ *
+ * q: nq x 1
+ * m: nd x nd, row-major; both triangles are written
+ *
+ * The mass matrix includes the joints' own inertia, i.e. M(q) is the matrix
+ * that kcc_aba() inverts and kcc_rnea() applies.
+ *
+ * Reference:
+ * - [Featherstone2008]: p. 109, Table 6.2
+ */
+void kcc_crba(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s,
+        joint_inertia *m);
+
+/**
+ * Lower triangle of the joint-space mass matrix (coordinates).
+ *
+ * Same as kcc_crba() but only the lower triangle is written, packed row by
+ * row: M_ij with j <= i is stored at m[i (i + 1) / 2 + j].
+ *
+ * m: nd (nd + 1) / 2 x 1
+ */
+void kcc_crba_packed(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s,
+        joint_inertia *m);
+
+
+/**
+ * Geometric Jacobian of a frame on the chain (coordinates).
+ *
+ * q: nq x 1
+ * j: 6 x nd, column-major; column k is the twist (angular, linear) of the
+ *    frame for qd = e_k, i.e. J qd is the frame's twist relative to the base
+ *
+ * The body Jacobian expresses the twists in the frame's coordinates, the
+ * spatial Jacobian in the base's. The columns of the joints that do not move
+ * the frame are zero.
+ *
+ * The poses come from kcc_fpk_incremental(), hence they are only recomputed
+ * if q has changed since the last position sweep on s.
+ */
+void kcc_jacobian(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const struct kcc_frame *frame,
+        enum jacobian_type type,
+        struct solver_state_c *s,
+        double *j);
+
+/**
+ * Geometric Jacobians of several frames on the chain (coordinates).
+ *
+ * j: count x 6 x nd, the frames' Jacobians back to back
+ *
+ * Same as kcc_jacobian() for every frame, but the joints' motion subspaces
+ * are computed in one sweep that all frames share.
+ */
+void kcc_jacobian_batch(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        int count,
+        const struct kcc_frame *frame,
+        enum jacobian_type type,
+        struct solver_state_c *s,
+        double *j);
+
+/**
+ * Bias acceleration of a frame on the chain (coordinates).
+ *
+ * Jd qd, i.e. the frame's acceleration twist for qdd = 0
+ *
+ * q: nq x 1
+ * qd: nd x 1
+ * a: 6 x 1, the acceleration twist (angular, linear)
+ *
+ * Jd is the time derivative of the body or spatial Jacobian of kcc_jacobian(),
+ * hence J qdd + Jd qd is the frame's acceleration twist in the same
+ * coordinates. The base is at rest, i.e. s->xd[0] and s->xdd[0] are ignored.
+ *
+ * A velocity and bias acceleration sweep over the bodies up to the frame's,
+ * which overwrites their twists s->xd[i] and acceleration twists s->xdd[i]
+ * (the latter without the joint accelerations). The poses come from
+ * kcc_fpk_incremental() as for kcc_jacobian().
+ */
+void kcc_jacobian_dot_qd(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const struct kcc_frame *frame,
+        enum jacobian_type type,
+        struct solver_state_c *s,
+        double *a);
+
+
+/**
+ * Forward dynamics with the articulated-body algorithm on LA_LANES instances
+ * of the same chain at once (coordinates).
+ *
+ * Lane l of s->q, s->qd and s->tau holds the l-th instance's joint state, of
+ * s->xd[0] and s->xdd[0] its base motion. The result is written to s->qdd.
+ * All joints must be revolute, as checked by solver_state_init_lanes_c(), and
+ * no external forces are applied.
+ *
+ * The sweeps are the ones of kcc_aba() with every scalar operation replaced by
+ * a loop over the lanes, so that each instruction processes one lane per
+ * vector element. The build for the instruction set reported by la_get_isa()
+ * is used.
+ */
+void kcc_aba_lanes(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s);
+
+/**
+ * Forward dynamics for a batch of independent instances of the same chain
+ * (coordinates).
+ *
+ * count: number of instances
+ * q: count x nq, one row per instance
+ * qd: count x nd
+ * tau: count x nd
+ * xdd_base: acceleration twist of the base, shared by all instances (may be
+ *           NULL for an unaccelerated base); the base does not move
+ * qdd: count x nd
+ *
+ * The instances are solved with kcc_aba_lanes() in blocks of LA_LANES. A
+ * trailing partial block is padded with copies of the last instance.
+ */
+void kcc_aba_batch(
+        const struct kcc_kinematic_chain *kc,
+        int count,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct gc_acc_twist *xdd_base,
+        struct solver_state_lanes_c *s,
+        joint_acceleration *qdd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef DYN2B_FUNCTIONS_SOLVER_STATE_H
+#define DYN2B_FUNCTIONS_SOLVER_STATE_H
+
+#include <dyn2b/types/solver_state.h>
+#include <dyn2b/types/kinematic_chain.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Memory management of the solver state.
+ *
+ * The complete solver state of a kinematic chain lives in a single contiguous
+ * arena. Every array in the arena starts on a cache line so that the sweeps
+ * never share a cache line between two quantities.
+ *
+ * Spatial vectors and poses are stored as structure of arrays: the coordinates
+ * of all elements of one array form contiguous slabs, e.g. the wrenches in
+ * f_bias_art occupy one "double torque[nbody + 1][3]" and one
+ * "double force[nbody + 1][3]" slab. Hence, &s->f_bias_art[i] refers to the
+ * elements i, i + 1, ... when passed to the operations that accept a <count>,
+ * so that independent bodies are processed in a single, linear stream.
+ */
+
+
+/**
+ * Alignment (in bytes) of the arena and of every array within it.
+ */
+#define SOLVER_STATE_ALIGNMENT 64
+
+
+/**
+ * Number of bytes required by the arena of the solver state for a kinematic
+ * chain or tree (see struct kcc_kinematic_chain) (coordinates).
+ */
+size_t solver_state_size_c(
+        const struct kcc_kinematic_chain *kc);
+
+/**
+ * Lay out the solver state for a kinematic chain or tree (see struct
+ * kcc_kinematic_chain) in a caller-provided arena (coordinates).
+ *
+ * The arena must be aligned to SOLVER_STATE_ALIGNMENT and hold at least
+ * solver_state_size_c(kc) bytes. It is zeroed, except for the base's pose which
+ * is initialized to the identity. The caller keeps ownership of the arena.
+ *
+ * The chain must either be verified (see kcc_verify()) or pass
+ * kcc_verify_coordinates().
+ */
+void solver_state_init_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        void *memory);
+
+/**
+ * Allocate an arena and lay out the solver state for a kinematic chain or tree
+ * (see struct kcc_kinematic_chain) in it (coordinates).
+ *
+ * A chain that is not marked as verified (see kcc_verify()) is checked with
+ * kcc_verify_coordinates() first.
+ *
+ * Returns 0 on success and -1 if the chain is invalid or the arena could not be
+ * allocated.
+ */
+int solver_state_create_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s);
+
+/**
+ * Release the solver state (coordinates).
+ *
+ * The arena is only freed if it was allocated by solver_state_create_c().
+ */
+void solver_state_destroy_c(
+        struct solver_state_c *s);
+
+
+/**
+ * Number of bytes required by the arena of a batched solver state (coordinates).
+ */
+size_t solver_state_size_lanes_c(
+        const struct kcc_kinematic_chain *kc);
+
+/**
+ * Lay out a batched solver state in a caller-provided arena
+ * (coordinates). See solver_state_init_c().
+ *
+ * Returns 0 on success and -1 if the chain has a joint that is not revolute,
+ * which the lane solvers do not support.
+ */
+int solver_state_init_lanes_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s,
+        void *memory);
+
+/**
+ * Allocate an arena and lay out a batched solver state in it (coordinates).
+ * See solver_state_create_c().
+ *
+ * Returns 0 on success and -1 if the chain is invalid or has a joint that is
+ * not revolute, or if the arena could not be allocated.
+ */
+int solver_state_create_lanes_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s);
+
+/**
+ * Release a batched solver state (coordinates).
+ */
+void solver_state_destroy_lanes_c(
+        struct solver_state_lanes_c *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
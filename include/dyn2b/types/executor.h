@@ -0,0 +1,44 @@
+#ifndef DYN2B_TYPES_EXECUTOR_H
+#define DYN2B_TYPES_EXECUTOR_H
+
+#include <dyn2b/types/kinematic_chain.h>
+#include <dyn2b/types/solver_state.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Work item of an executor: process the sample with the given index using
+ * the worker's solver state.
+ */
+typedef void (*kcc_task)(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int index,
+        void *data);
+
+
+struct kcc_worker;
+struct kcc_pool;
+
+struct kcc_executor
+{
+    const struct kcc_kinematic_chain *kc;
+    int nthreads;                   // number of workers incl. the calling thread
+    struct kcc_worker *worker;      // per-thread queue and solver state   [nthreads]
+    struct kcc_pool *pool;          // job and synchronization shared by the workers
+
+    // The tree below its first branching body b for kcc_executor_aba_subtrees():
+    // the trunk's bodies 1, ..., b followed by the bodies of each subtree
+    int nsubtrees;                  // number of children of b
+    int *body;                      // trunk's and subtrees' bodies        [nbody]
+    int *subtree;                   // offset of each subtree in body      [nsubtrees + 1]
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
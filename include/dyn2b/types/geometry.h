@@ -40,6 +40,19 @@ struct gc_pose
     struct vector3 *translation;
 };
 
+/**
+ * Pose of an elementary rotation about one of the coordinate axes by an angle
+ * q, e.g. over a revolute joint. It has no translation and its rotation
+ * matrix has only four entries besides the zeros and the one, hence it is
+ * stored by value as the axis and the cosine and sine of q.
+ */
+struct gc_elementary_pose
+{
+    int axis;                       // 0: x, 1: y, 2: z
+    double cos_angle;
+    double sin_angle;
+};
+
 struct ga_pose
 {
     struct body *target_body;
@@ -78,6 +91,29 @@ struct ga_acc_twist
     struct frame *frame;
 };
 
+
+/**
+ * Batched coordinates: one instance per lane. Unlike the types above, the
+ * coordinates are stored by value so that a batch is one contiguous block.
+ */
+struct gc_pose_lanes
+{
+    struct matrix3x3_lanes rotation;
+    struct vector3_lanes translation;
+};
+
+struct gc_twist_lanes
+{
+    struct vector3_lanes angular_velocity;
+    struct vector3_lanes linear_velocity;
+};
+
+struct gc_acc_twist_lanes
+{
+    struct vector3_lanes angular_acceleration;
+    struct vector3_lanes linear_acceleration;
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,7 +18,27 @@ typedef double joint_inertia;
 
 enum joint_type
 {
-    JOINT_TYPE_REVOLUTE
+    JOINT_TYPE_REVOLUTE,
+    JOINT_TYPE_PRISMATIC,
+
+    // A fixed joint has no degree of freedom and no parameters (nq = nd = 0),
+    // hence it takes no slot in the joint arrays. The solvers still compose
+    // its identity transform unless the joint is merged away with
+    // kcc_merge_fixed_joints().
+    JOINT_TYPE_FIXED,
+
+    // A spherical joint rotates freely about the origin. Its position is a
+    // unit quaternion (x, y, z, w) of the target's orientation relative to the
+    // joint's reference frame (nq = 4), its velocity the target's angular
+    // velocity in the target's coordinates (nd = 3).
+    JOINT_TYPE_SPHERICAL,
+
+    // A free-flyer joint, e.g. the floating base of a mobile robot, moves
+    // freely in space. Its position is the target's origin in the reference
+    // frame's coordinates followed by a unit quaternion as for spherical
+    // joints (nq = 7), its velocity the target's twist (angular, linear) in
+    // the target's coordinates (nd = 6). Hence, qd is not the derivative of q.
+    JOINT_TYPE_FREE_FLYER
 };
 
 enum joint_axis
@@ -28,19 +48,38 @@ enum joint_axis
     JOINT_AXIS_Z = 2
 };
 
+enum jacobian_type
+{
+    // Columns are the frame's twists in the frame's coordinates
+    JACOBIAN_BODY,
+
+    // Columns are the frame's twists in the base's coordinates
+    JACOBIAN_SPATIAL
+};
+
 struct kcc_revolute_joint
 {
     enum joint_axis axis;
     joint_inertia *inertia;
 };
 
+struct kcc_prismatic_joint
+{
+    enum joint_axis axis;
+    joint_inertia *inertia;         // e.g. the reflected mass of the drive
+};
+
+struct kcc_joint_operators;
+
 struct kcc_joint
 {
     enum joint_type type;
+    const struct kcc_joint_operators *operators;    // set by kcc_compile()
 
     union
     {
         struct kcc_revolute_joint revolute_joint;
+        struct kcc_prismatic_joint prismatic_joint;
     };
 };
 
@@ -77,16 +116,30 @@ struct kca_segment
     struct kca_link link;
 };
 
+// A chain is a tree of segments in topological order: segment i is attached
+// to the link of segment parent[i] < i, or to the base if parent[i] is -1.
+// Without a parent array the chain is serial, i.e. parent[i] = i - 1.
 struct kca_kinematic_chain
 {
     int number_of_segments;
     struct kca_segment *segment;
+    const int *parent;              // [number_of_segments] (may be NULL)
 };
 
 struct kcc_kinematic_chain
 {
     int number_of_segments;
     struct kcc_segment *segment;
+    const int *parent;              // [number_of_segments] (may be NULL)
+    int verified;                   // set by kcc_verify()
+};
+
+// A frame that is rigidly attached to a body of a chain, e.g. a tool frame.
+// Body 0 is the base and body i segment i - 1's link.
+struct kcc_frame
+{
+    int body;
+    const struct gc_pose *pose;     // f^X_body (NULL: the body's own frame)
 };
 
 #ifdef __cplusplus
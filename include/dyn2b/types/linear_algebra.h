@@ -30,6 +30,54 @@ struct matrix3x3
     };
 };
 
+
+/**
+ * Number of independent problem instances ("lanes") that the batched
+ * representations below carry per scalar. Eight doubles fill one AVX-512 or
+ * two AVX2 registers.
+ */
+#define LA_LANES 8
+
+/**
+ * Vector with one 3-vector per lane, stored component-major so that each
+ * component is a contiguous lane vector.
+ */
+struct vector3_lanes
+{
+    union {
+        struct {
+            double x[LA_LANES];
+            double y[LA_LANES];
+            double z[LA_LANES];
+        };
+        double data[3][LA_LANES];
+    };
+};
+
+struct matrix3x3_lanes
+{
+    union {
+        struct {
+            struct vector3_lanes row_x;
+            struct vector3_lanes row_y;
+            struct vector3_lanes row_z;
+        };
+        struct vector3_lanes row[3];
+    };
+};
+
+
+/**
+ * Instruction sets of the vectorized linear algebra kernels
+ */
+enum la_isa
+{
+    LA_ISA_SCALAR = 0,
+    LA_ISA_SSE2,
+    LA_ISA_AVX2,        // AVX2 + FMA
+    LA_ISA_AVX512       // AVX-512F
+};
+
 #ifdef __cplusplus
 }
 #endif
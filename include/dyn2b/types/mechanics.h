@@ -87,6 +87,24 @@ struct mc_abi
     struct matrix3x3 second_moment_of_mass; // "rotational inertia"
 };
 
+/**
+ * Articulated-body inertia in packed storage (coordinates)
+ *
+ * The zeroth and second moments of mass are symmetric, hence only their upper
+ * triangles are stored row by row: xx, xy, xz, yy, yz, zz. Element (i, j) of
+ * either is at index MC_SYM33(i, j).
+ */
+struct mc_abi_packed
+{
+    double zeroth_moment_of_mass[6];        // "mass"
+    struct matrix3x3 first_moment_of_mass;  // "mass * centre of mass"
+    double second_moment_of_mass[6];        // "rotational inertia"
+};
+
+#define MC_SYM33(i, j) ((i) <= (j) \
+        ? (i) * (5 - (i)) / 2 + (j) \
+        : (j) * (5 - (j)) / 2 + (i))
+
 /**
  * Articulated-body inertia (ADT)
  */
@@ -97,6 +115,26 @@ struct ma_abi
     struct frame *frame;
 };
 
+
+/**
+ * Batched wrench (coordinates), one instance per lane
+ */
+struct mc_wrench_lanes
+{
+    struct vector3_lanes torque;
+    struct vector3_lanes force;
+};
+
+/**
+ * Batched articulated-body inertia (coordinates), one instance per lane
+ */
+struct mc_abi_lanes
+{
+    struct matrix3x3_lanes zeroth_moment_of_mass;
+    struct matrix3x3_lanes first_moment_of_mass;
+    struct matrix3x3_lanes second_moment_of_mass;
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,11 +79,23 @@ struct solver_state_c
     joint_position *q;              // joint position                           [nq]
     joint_velocity *qd;             // joint velocity                           [nd]
     joint_acceleration *qdd;        // joint acceleration                       [nd]
+    int *iq;                        // offset of the joint's positions in q     [nbody]
+    int *id;                        // offset of the joint's DoFs in qd         [nbody]
+
+    // pose cache of kcc_fpk_incremental()
+    int x_valid;                    // x_jnt, x_rel and x_tot are the poses at q_fpk
+    joint_position *q_fpk;          // joint position of the cached poses       [nq]
+    int *x_moved;                   // pose relative to base recomputed         [nbody + 1]
+
+    // joint trigonometry of kcc_sincos()
+    joint_position *q_trig;         // joint position of sin_q and cos_q        [nq]
+    double *sin_q;                  // sine of the joint position               [nq]
+    double *cos_q;                  // cosine of the joint position             [nq]
 
     // inertia
-    struct mc_abi *m_art;           // articulated-body inertia                 [nbody]
-    struct mc_abi *m_app;           // apparent inertia                         [nbody]
-    struct mc_abi *m_tf;            // tf'ed apparent inertia                   [nbody]
+    struct mc_abi_packed *m_art;    // articulated-body inertia                 [nbody]
+    struct mc_abi_packed *m_app;    // apparent inertia                         [nbody]
+    struct mc_abi_packed *m_tf;     // tf'ed apparent inertia                   [nbody]
     joint_inertia *d;               // constrained inertia                      [nd]
 
     // inertial force
@@ -110,6 +122,43 @@ struct solver_state_c
     joint_torque *tau_ext_art;      // torque due to art. external force        [nd]
 
     joint_torque *tau_ctrl;         // joint control torque                     [nd]
+
+    void *memory;                   // arena owned by the state (or NULL)
+};
+
+
+/**
+ * Solver state for LA_LANES instances of the same chain that are solved
+ * simultaneously, i.e. each scalar of solver_state_c is a lane vector here.
+ */
+struct solver_state_lanes_c
+{
+    int nbody;                      // number of bodies
+    int nq;                         // number of joint positions
+    int nd;                         // number of motion DoFs
+
+    // spatial motion state
+    struct gc_pose_lanes      *x_rel;     // pose w.r.t. to predecessor body    [nbody]
+    struct gc_twist_lanes     *xd;        // velocity                           [nbody + 1]
+    struct gc_acc_twist_lanes *xdd_bias;  // bias acceleration                  [nbody]
+    struct gc_acc_twist_lanes *xdd;       // acceleration                       [nbody + 1]
+
+    // joint motion state
+    double (*q)[LA_LANES];          // joint position                           [nq]
+    double (*qd)[LA_LANES];         // joint velocity                           [nd]
+    double (*qdd)[LA_LANES];        // joint acceleration                       [nd]
+
+    // inertia
+    struct mc_abi_lanes *m_art;     // articulated-body inertia                 [nbody + 1]
+    struct mc_wrench_lanes *m_jnt;  // articulated inertia over the joint M^A S [nbody]
+    double (*d)[LA_LANES];          // constrained inertia                      [nd]
+
+    // force
+    struct mc_wrench_lanes *f_bias_art;   // articulated bias force             [nbody + 1]
+    double (*tau)[LA_LANES];        // joint torque                             [nd]
+    double (*tau_ctrl)[LA_LANES];   // torque w/o articulated bias force        [nd]
+
+    void *memory;                   // arena owned by the state (or NULL)
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,720 @@
+#include <dyn2b/functions/executor.h>
+#include <dyn2b/functions/geometry.h>
+#include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/solver.h>
+#include <dyn2b/functions/solver_state.h>
+#include "solver_joint.h"
+#include "solver_subtree.h"
+
+#include <pthread.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+
+// Workers are padded to separate cache lines so that a thief locking one
+// range does not slow down the owners of the neighbouring ones
+#define WORKER_ALIGNMENT 64
+
+
+struct kcc_worker
+{
+    pthread_mutex_t lock;           // protects begin and end
+    int begin;                      // remaining samples of the current job
+    int end;
+
+    struct solver_state_c state;
+    struct kcc_executor *ex;
+    int id;
+    pthread_t thread;
+} __attribute__((aligned(WORKER_ALIGNMENT)));
+
+
+struct kcc_pool
+{
+    pthread_mutex_t lock;
+    pthread_cond_t start;           // a job was posted or the pool shuts down
+    pthread_cond_t done;            // the last worker thread finished a job
+
+    unsigned long generation;       // incremented for every posted job
+    int running;                    // worker threads busy with the current job
+    int shutdown;
+
+    // current job
+    kcc_task task;
+    void *data;
+    int grain;
+};
+
+
+// Take up to grain samples from the front of the worker's own range
+static int worker_pop(
+        struct kcc_worker *w,
+        int grain,
+        int *begin,
+        int *end)
+{
+    pthread_mutex_lock(&w->lock);
+    *begin = w->begin;
+    *end = w->begin + grain < w->end ? w->begin + grain : w->end;
+    w->begin = *end;
+    pthread_mutex_unlock(&w->lock);
+
+    return *begin < *end;
+}
+
+
+// Move the back half of another worker's range into the worker's own range
+static int worker_steal(
+        struct kcc_worker *w)
+{
+    struct kcc_executor *ex = w->ex;
+
+    for (int i = 1; i < ex->nthreads; i++) {
+        struct kcc_worker *victim = &ex->worker[(w->id + i) % ex->nthreads];
+
+        pthread_mutex_lock(&victim->lock);
+        int n = victim->end - victim->begin;
+        int begin = victim->end - (n + 1) / 2;
+        int end = victim->end;
+        if (n > 0) victim->end = begin;
+        pthread_mutex_unlock(&victim->lock);
+
+        if (n > 0) {
+            pthread_mutex_lock(&w->lock);
+            w->begin = begin;
+            w->end = end;
+            pthread_mutex_unlock(&w->lock);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+static void worker_run(
+        struct kcc_worker *w)
+{
+    const struct kcc_pool *pool = w->ex->pool;
+    const struct kcc_kinematic_chain *kc = w->ex->kc;
+
+    do {
+        int begin, end;
+        while (worker_pop(w, pool->grain, &begin, &end)) {
+            for (int i = begin; i < end; i++) {
+                pool->task(kc, &w->state, i, pool->data);
+            }
+        }
+    } while (worker_steal(w));
+}
+
+
+static void *worker_main(
+        void *arg)
+{
+    struct kcc_worker *w = arg;
+    struct kcc_pool *pool = w->ex->pool;
+    unsigned long generation = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->generation == generation && !pool->shutdown) {
+            pthread_cond_wait(&pool->start, &pool->lock);
+        }
+        generation = pool->generation;
+        int shutdown = pool->shutdown;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (shutdown) return NULL;
+
+        worker_run(w);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0) pthread_cond_signal(&pool->done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+
+static void executor_stop(
+        struct kcc_executor *ex,
+        int nstarted)
+{
+    pthread_mutex_lock(&ex->pool->lock);
+    ex->pool->shutdown = 1;
+    pthread_cond_broadcast(&ex->pool->start);
+    pthread_mutex_unlock(&ex->pool->lock);
+
+    for (int i = 1; i < nstarted; i++) {
+        pthread_join(ex->worker[i].thread, NULL);
+    }
+}
+
+
+static void executor_free(
+        struct kcc_executor *ex)
+{
+    free(ex->subtree);
+    free(ex->body);
+
+    for (int i = 0; i < ex->nthreads; i++) {
+        solver_state_destroy_c(&ex->worker[i].state);
+        pthread_mutex_destroy(&ex->worker[i].lock);
+    }
+
+    pthread_cond_destroy(&ex->pool->done);
+    pthread_cond_destroy(&ex->pool->start);
+    pthread_mutex_destroy(&ex->pool->lock);
+
+    free(ex->worker);
+    free(ex->pool);
+    memset(ex, 0, sizeof(*ex));
+}
+
+
+// Split the tree at its first branching body b. The trunk is the serial
+// path 1, ..., b, since every body before b has b's ancestor as only child;
+// all other bodies are descendants of b.
+static int executor_decompose(
+        struct kcc_executor *ex)
+{
+    const struct kcc_kinematic_chain *kc = ex->kc;
+    const int NR_BODIES = kc->number_of_segments;
+
+    ex->body = malloc((NR_BODIES > 0 ? NR_BODIES : 1) * sizeof(int));
+    ex->subtree = malloc((NR_BODIES + 1) * sizeof(int));
+    int *tmp = calloc(2 * (NR_BODIES + 1), sizeof(int));
+    if (!ex->body || !ex->subtree || !tmp) {
+        free(tmp);
+        return -1;
+    }
+
+    // Number of children of each body, then the subtree of each descendant
+    // of b
+    for (int i = 1; i < NR_BODIES + 1; i++) {
+        tmp[kc->parent ? kc->parent[i - 1] + 1 : i - 1]++;
+    }
+
+    int b = 0;
+    while (b < NR_BODIES && tmp[b] == 1) b++;
+
+    ex->nsubtrees = tmp[b];
+    for (int i = 0; i < b; i++) ex->body[i] = i + 1;
+
+    // The subtrees' sizes
+    int *size = &ex->subtree[1];
+    for (int k = 0; k < ex->nsubtrees; k++) size[k] = 0;
+    for (int i = b + 1, next = 0; i < NR_BODIES + 1; i++) {
+        int p = kc->parent[i - 1] + 1;
+        tmp[i] = (p == b) ? next++ : tmp[p];
+        size[tmp[i]]++;
+    }
+
+    ex->subtree[0] = b;
+    for (int k = 0; k < ex->nsubtrees; k++) ex->subtree[k + 1] += ex->subtree[k];
+
+    // Bodies of each subtree in index order
+    int *fill = &tmp[NR_BODIES + 1];
+    for (int k = 0; k < ex->nsubtrees; k++) fill[k] = ex->subtree[k];
+    for (int i = b + 1; i < NR_BODIES + 1; i++) {
+        ex->body[fill[tmp[i]]++] = i;
+    }
+
+    free(tmp);
+
+    return 0;
+}
+
+
+int kcc_executor_create(
+        const struct kcc_kinematic_chain *kc,
+        int nthreads,
+        struct kcc_executor *ex)
+{
+    assert(kc);
+    assert(ex);
+
+    if (nthreads <= 0) {
+        long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = ncpu > 0 ? (int)ncpu : 1;
+    }
+
+    ex->kc = kc;
+    ex->nthreads = nthreads;
+    ex->worker = aligned_alloc(WORKER_ALIGNMENT, nthreads * sizeof(struct kcc_worker));
+    ex->pool = calloc(1, sizeof(struct kcc_pool));
+    if (!ex->worker || !ex->pool) {
+        free(ex->worker);
+        free(ex->pool);
+        memset(ex, 0, sizeof(*ex));
+        return -1;
+    }
+    memset(ex->worker, 0, nthreads * sizeof(struct kcc_worker));
+
+    pthread_mutex_init(&ex->pool->lock, NULL);
+    pthread_cond_init(&ex->pool->start, NULL);
+    pthread_cond_init(&ex->pool->done, NULL);
+
+    int status = executor_decompose(ex);
+    for (int i = 0; i < nthreads; i++) {
+        struct kcc_worker *w = &ex->worker[i];
+
+        pthread_mutex_init(&w->lock, NULL);
+        w->ex = ex;
+        w->id = i;
+
+        if (solver_state_create_c(kc, &w->state) != 0) status = -1;
+    }
+
+    // Worker 0 is the thread that posts the jobs
+    int nstarted = 1;
+    while (status == 0 && nstarted < nthreads) {
+        struct kcc_worker *w = &ex->worker[nstarted];
+        if (pthread_create(&w->thread, NULL, worker_main, w) != 0) status = -1;
+        else nstarted++;
+    }
+
+    if (status != 0) {
+        executor_stop(ex, nstarted);
+        executor_free(ex);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void kcc_executor_destroy(
+        struct kcc_executor *ex)
+{
+    assert(ex);
+
+    executor_stop(ex, ex->nthreads);
+    executor_free(ex);
+}
+
+
+void kcc_executor_run(
+        struct kcc_executor *ex,
+        int count,
+        int grain,
+        kcc_task task,
+        void *data)
+{
+    assert(ex);
+    assert(count >= 0);
+    assert(task);
+
+    struct kcc_pool *pool = ex->pool;
+    const int NR_THREADS = ex->nthreads;
+
+    // Small enough for stealing to balance the load, large enough for the
+    // locks to be taken rarely
+    if (grain <= 0) {
+        grain = count / (8 * NR_THREADS);
+        if (grain < 1) grain = 1;
+    }
+
+    // The worker threads are idle, hence their ranges can be set without
+    // locking; posting the job under the pool's lock publishes them
+    for (int i = 0; i < NR_THREADS; i++) {
+        ex->worker[i].begin = (int)((long)count * i / NR_THREADS);
+        ex->worker[i].end = (int)((long)count * (i + 1) / NR_THREADS);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->data = data;
+    pool->grain = grain;
+    pool->running = NR_THREADS - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+
+    worker_run(&ex->worker[0]);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running > 0) {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+
+// The base does not move but may be accelerated, e.g. to model gravity
+static void executor_set_base(
+        struct kcc_executor *ex,
+        const struct gc_acc_twist *xdd_base)
+{
+    for (int i = 0; i < ex->nthreads; i++) {
+        struct solver_state_c *s = &ex->worker[i].state;
+
+        for (int j = 0; j < 3; j++) {
+            s->xd[0].angular_velocity->data[j] = 0.0;
+            s->xd[0].linear_velocity->data[j] = 0.0;
+            s->xdd[0].angular_acceleration->data[j] =
+                    xdd_base ? xdd_base->angular_acceleration->data[j] : 0.0;
+            s->xdd[0].linear_acceleration->data[j] =
+                    xdd_base ? xdd_base->linear_acceleration->data[j] : 0.0;
+        }
+    }
+}
+
+
+struct aba_job
+{
+    const joint_position *q;
+    const joint_velocity *qd;
+    const joint_torque *tau;
+    const struct mc_wrench *f_ext;
+    joint_acceleration *qdd;
+};
+
+
+static void aba_task(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int index,
+        void *data)
+{
+    const struct aba_job *job = data;
+
+    kcc_aba(kc,
+            &job->q[index * s->nq],
+            &job->qd[index * s->nd],
+            &job->tau[index * s->nd],
+            job->f_ext ? &job->f_ext[index] : NULL,
+            s,
+            &job->qdd[index * s->nd]);
+}
+
+
+void kcc_executor_aba(
+        struct kcc_executor *ex,
+        int count,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct mc_wrench *f_ext,
+        const struct gc_acc_twist *xdd_base,
+        joint_acceleration *qdd)
+{
+    assert(ex);
+    assert(q);
+    assert(qd);
+    assert(tau);
+    assert(qdd);
+
+    executor_set_base(ex, xdd_base);
+
+    struct aba_job job = {
+        .q = q,
+        .qd = qd,
+        .tau = tau,
+        .f_ext = f_ext,
+        .qdd = qdd
+    };
+
+    kcc_executor_run(ex, count, 0, aba_task, &job);
+}
+
+
+struct rnea_job
+{
+    const joint_position *q;
+    const joint_velocity *qd;
+    const joint_acceleration *qdd;
+    const struct mc_wrench *f_ext;
+    joint_torque *tau;
+};
+
+
+static void rnea_task(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int index,
+        void *data)
+{
+    const struct rnea_job *job = data;
+
+    kcc_rnea(kc,
+            &job->q[index * s->nq],
+            job->qd ? &job->qd[index * s->nd] : NULL,
+            job->qdd ? &job->qdd[index * s->nd] : NULL,
+            job->f_ext ? &job->f_ext[index] : NULL,
+            s,
+            &job->tau[index * s->nd]);
+}
+
+
+void kcc_executor_rnea(
+        struct kcc_executor *ex,
+        int count,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_acceleration *qdd,
+        const struct mc_wrench *f_ext,
+        const struct gc_acc_twist *xdd_base,
+        joint_torque *tau)
+{
+    assert(ex);
+    assert(q);
+    assert(tau);
+
+    executor_set_base(ex, xdd_base);
+
+    struct rnea_job job = {
+        .q = q,
+        .qd = qd,
+        .qdd = qdd,
+        .f_ext = f_ext,
+        .tau = tau
+    };
+
+    kcc_executor_run(ex, count, 0, rnea_task, &job);
+}
+
+
+struct subtree_job
+{
+    const joint_position *q;
+    const joint_velocity *qd;
+    const joint_torque *tau;
+    const struct mc_wrench *f_ext;
+    struct solver_state_c *s;
+    joint_acceleration *qdd;
+
+    const int *body;
+    const int *subtree;
+};
+
+
+// The worker's own solver state is not used; all subtrees share the caller's
+static void subtree_inward_task(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int index,
+        void *data)
+{
+    const struct subtree_job *job = data;
+    const int *body = &job->body[job->subtree[index]];
+    const int count = job->subtree[index + 1] - job->subtree[index];
+    (void)s;
+
+    kcc_aba_outward(kc, job->q, job->qd, job->f_ext, job->s, body, count);
+    kcc_aba_inward(kc, job->tau, job->s, body, count, job->subtree[0]);
+}
+
+
+static void subtree_accelerate_task(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int index,
+        void *data)
+{
+    const struct subtree_job *job = data;
+    const int *body = &job->body[job->subtree[index]];
+    const int count = job->subtree[index + 1] - job->subtree[index];
+    (void)s;
+
+    kcc_aba_accelerate(kc, job->tau, job->s, body, count, job->qdd);
+}
+
+
+void kcc_executor_aba_subtrees(
+        struct kcc_executor *ex,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        joint_acceleration *qdd)
+{
+    assert(ex);
+    assert(q);
+    assert(qd);
+    assert(tau);
+    assert(s);
+    assert(qdd);
+    assert(s->nbody == ex->kc->number_of_segments);
+
+    const struct kcc_kinematic_chain *kc = ex->kc;
+
+    if (ex->nsubtrees < 2) {
+        kcc_aba(kc, q, qd, tau, f_ext, s, qdd);
+        return;
+    }
+
+    const int NR_TRUNK = ex->subtree[0];
+
+    struct subtree_job job = {
+        .q = q,
+        .qd = qd,
+        .tau = tau,
+        .f_ext = f_ext,
+        .s = s,
+        .qdd = qdd,
+        .body = ex->body,
+        .subtree = ex->subtree
+    };
+
+    // The subtree tasks overwrite the poses concurrently
+    s->x_valid = 0;
+
+    kcc_aba_outward(kc, q, qd, f_ext, s, ex->body, NR_TRUNK);
+
+    kcc_executor_run(ex, ex->nsubtrees, 1, subtree_inward_task, &job);
+
+    // Join the subtrees at the branching body; each subtree's root is its
+    // first body
+    for (int k = 0; k < ex->nsubtrees; k++) {
+        kcc_aba_join(kc, s, ex->body[ex->subtree[k]]);
+    }
+
+    kcc_aba_inward(kc, tau, s, ex->body, NR_TRUNK, -1);
+    kcc_aba_accelerate(kc, tau, s, ex->body, NR_TRUNK, qdd);
+
+    kcc_executor_run(ex, ex->nsubtrees, 1, subtree_accelerate_task, &job);
+}
+
+
+struct scan_job
+{
+    const joint_position *q;
+    struct solver_state_c *s;
+    int nblocks;
+};
+
+
+// Bodies first, ..., last - 1 of the block
+static void scan_block(
+        const struct scan_job *job,
+        int index,
+        int *first,
+        int *last)
+{
+    const int NR_BODIES = job->s->nbody;
+
+    *first = 1 + (int)((long)NR_BODIES * index / job->nblocks);
+    *last = 1 + (int)((long)NR_BODIES * (index + 1) / job->nblocks);
+}
+
+
+// r = x
+static void pose_copy(
+        const struct gc_pose *x,
+        struct gc_pose *r)
+{
+    *r->rotation = *x->rotation;
+    *r->translation = *x->translation;
+}
+
+
+// The block's relative poses and their prefix products within the block,
+// i.e. the poses w.r.t. the parent of the block's first body
+static void scan_local_task(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *ws,
+        int index,
+        void *data)
+{
+    const struct scan_job *job = data;
+    struct solver_state_c *s = job->s;
+    int first, last;
+    (void)ws;
+
+    scan_block(job, index, &first, &last);
+
+    for (int i = first; i < last; i++) {
+        const struct kcc_joint_operators *op = joint_operators(&kc->segment[i - 1].joint);
+
+        // X_{J,i} and i^X_{i-1} = X_{J,i} X_{T,i}
+        joint_fpk_compose(kc, op, job->q, s, i, s->iq[i - 1]);
+
+        // i^X_{first-1} = i^X_{i-1} {i-1}^X_{first-1}; the first block's
+        // poses are relative to the base
+        if (i == first && index > 0) {
+            pose_copy(&s->x_rel[i - 1], &s->x_tot[i]);
+        } else {
+            gc_pose_compose(&s->x_rel[i - 1], &s->x_tot[i - 1], &s->x_tot[i]);
+        }
+    }
+}
+
+
+// The block's poses relative to the base except for the last one, which the
+// calling thread has already fixed
+static void scan_fix_task(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *ws,
+        int index,
+        void *data)
+{
+    const struct scan_job *job = data;
+    struct solver_state_c *s = job->s;
+    int first, last;
+    (void)kc;
+    (void)ws;
+
+    if (index == 0) return;
+
+    scan_block(job, index, &first, &last);
+
+    for (int i = first; i < last - 1; i++) {
+        struct matrix3x3 rotation;
+        struct vector3 translation;
+        struct gc_pose x = { .rotation = &rotation, .translation = &translation };
+
+        // i^X_0 = i^X_{first-1} {first-1}^X_0
+        gc_pose_compose(&s->x_tot[i], &s->x_tot[first - 1], &x);
+        pose_copy(&x, &s->x_tot[i]);
+    }
+}
+
+
+void kcc_executor_fpk(
+        struct kcc_executor *ex,
+        const joint_position *q,
+        struct solver_state_c *s)
+{
+    assert(ex);
+    assert(q);
+    assert(s);
+    assert(s->nbody == ex->kc->number_of_segments);
+
+    const struct kcc_kinematic_chain *kc = ex->kc;
+    const int NR_BODIES = kc->number_of_segments;
+
+    s->x_valid = 0;
+
+    // Every block must have at least two bodies to gain anything
+    int nblocks = ex->nthreads < NR_BODIES / 2 ? ex->nthreads : NR_BODIES / 2;
+    if (kc->parent || nblocks < 2) {
+        kcc_fpk(kc, q, s);
+        return;
+    }
+
+    struct scan_job job = {
+        .q = q,
+        .s = s,
+        .nblocks = nblocks
+    };
+
+    kcc_executor_run(ex, nblocks, 1, scan_local_task, &job);
+
+    // The last pose of every block relative to the base
+    for (int b = 1; b < nblocks; b++) {
+        struct matrix3x3 rotation;
+        struct vector3 translation;
+        struct gc_pose x = { .rotation = &rotation, .translation = &translation };
+        int first, last;
+
+        scan_block(&job, b, &first, &last);
+        gc_pose_compose(&s->x_tot[last - 1], &s->x_tot[first - 1], &x);
+        pose_copy(&x, &s->x_tot[last - 1]);
+    }
+
+    kcc_executor_run(ex, nblocks, 1, scan_fix_task, &job);
+}
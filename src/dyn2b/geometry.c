@@ -20,16 +20,130 @@ void gc_pose_compose(
     assert(r->rotation && r->translation);
 
     // E' = E_1 E_2
-    la_dgemm_nnos(3, 3, 3,
-            (double *)x1->rotation, 3,
-            (double *)x2->rotation, 3,
-            (double *)r->rotation, 3);
+    la_d33gemm_nnos(
+            (double *)x1->rotation,
+            (double *)x2->rotation,
+            (double *)r->rotation);
 
     // r' = r_2 + E_2^T r_1
-    la_dgemv_toe(3, 3,
-            1.0, (double *)x2->rotation, 3, (double *)x1->translation, 1,
-            1.0, (double *)x2->translation, 1,
-            (double *)r->translation, 1);
+    la_d33gemv_toe(
+            1.0, (double *)x2->rotation, (double *)x1->translation,
+            1.0, (double *)x2->translation,
+            (double *)r->translation);
+}
+
+
+// The kernels of the elementary rotations are instantiated for each axis k so
+// that the indexing folds to constants. (k, k1, k2) is a cyclic permutation of
+// (x, y, z), and the rotation only mixes the k1 and k2 entries:
+//     v'_k  =  v_k
+//     v'_k1 =  c v_k1 + s v_k2
+//     v'_k2 = -s v_k1 + c v_k2
+static inline void elementary_rotate_k(
+        double c,
+        double s,
+        const double *v,
+        double *r,
+        int k)
+{
+    const int k1 = (k + 1) % 3;
+    const int k2 = (k + 2) % 3;
+
+    double v1 = v[k1];
+    double v2 = v[k2];
+
+    r[k] = v[k];
+    r[k1] =  c * v1 + s * v2;
+    r[k2] = -s * v1 + c * v2;
+}
+
+
+static void elementary_rotate(
+        const struct gc_elementary_pose *x,
+        const double *v,
+        double *r)
+{
+    switch (x->axis) {
+        case 0: elementary_rotate_k(x->cos_angle, x->sin_angle, v, r, 0); break;
+        case 1: elementary_rotate_k(x->cos_angle, x->sin_angle, v, r, 1); break;
+        default: elementary_rotate_k(x->cos_angle, x->sin_angle, v, r, 2); break;
+    }
+}
+
+
+static inline void elementary_compose_k(
+        double c,
+        double s,
+        const struct gc_pose *x2,
+        struct gc_pose *r,
+        int k)
+{
+    const int k1 = (k + 1) % 3;
+    const int k2 = (k + 2) % 3;
+
+    // E' = E_1 E_2, where E_1 only mixes the rows k1 and k2 of E_2
+    for (int j = 0; j < 3; j++) {
+        double e1 = x2->rotation->row[k1].data[j];
+        double e2 = x2->rotation->row[k2].data[j];
+
+        r->rotation->row[k].data[j] = x2->rotation->row[k].data[j];
+        r->rotation->row[k1].data[j] =  c * e1 + s * e2;
+        r->rotation->row[k2].data[j] = -s * e1 + c * e2;
+    }
+
+    // r' = r_2 + E_2^T r_1 = r_2
+    for (int i = 0; i < 3; i++) {
+        r->translation->data[i] = x2->translation->data[i];
+    }
+}
+
+
+void gc_pose_compose_elementary(
+        const struct gc_elementary_pose *x1,
+        const struct gc_pose *x2,
+        struct gc_pose *r)
+{
+    assert(x1);
+    assert(x2);
+    assert(r);
+    assert(x1->axis >= 0 && x1->axis < 3);
+    assert(x2->rotation && x2->translation);
+    assert(r->rotation && r->translation);
+    assert(x2->rotation != r->rotation);
+
+    switch (x1->axis) {
+        case 0: elementary_compose_k(x1->cos_angle, x1->sin_angle, x2, r, 0); break;
+        case 1: elementary_compose_k(x1->cos_angle, x1->sin_angle, x2, r, 1); break;
+        default: elementary_compose_k(x1->cos_angle, x1->sin_angle, x2, r, 2); break;
+    }
+}
+
+
+void gc_elementary_pose_to_pose(
+        const struct gc_elementary_pose *x,
+        struct gc_pose *r)
+{
+    assert(x);
+    assert(r);
+    assert(x->axis >= 0 && x->axis < 3);
+    assert(r->rotation && r->translation);
+
+    const int k = x->axis;
+    const int k1 = (k + 1) % 3;
+    const int k2 = (k + 2) % 3;
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r->rotation->row[i].data[j] = 0.0;
+        }
+        r->translation->data[i] = 0.0;
+    }
+
+    r->rotation->row[k].data[k] = 1.0;
+    r->rotation->row[k1].data[k1] =  x->cos_angle;
+    r->rotation->row[k1].data[k2] =  x->sin_angle;
+    r->rotation->row[k2].data[k1] = -x->sin_angle;
+    r->rotation->row[k2].data[k2] =  x->cos_angle;
 }
 
 
@@ -115,16 +229,63 @@ void gc_twist_tf_ref_to_tgt(
             (double *)&v_rxw, 1);
 
     // v' = E(v - r x w)
-    la_dgemv_nos(3, 3,
-            (double *)x->rotation, 3,
-            (double *)xd->angular_velocity, 1,
-            (double *)r->angular_velocity, 1);
+    la_d33gemv_nos(
+            (double *)x->rotation,
+            (double *)xd->angular_velocity,
+            (double *)r->angular_velocity);
 
     // w' = E w
-    la_dgemv_nos(3, 3,
-            (double *)x->rotation, 3,
-            (double *)&v_rxw, 1,
-            (double *)r->linear_velocity, 1);
+    la_d33gemv_nos(
+            (double *)x->rotation,
+            (double *)&v_rxw,
+            (double *)r->linear_velocity);
+}
+
+
+void gc_twist_tf_tgt_to_ref(
+        const struct gc_pose *x,
+        const struct gc_twist *xd,
+        struct gc_twist *r)
+{
+    assert(x);
+    assert(xd);
+    assert(r);
+    assert(xd != r);
+
+    // w' = E^T w
+    la_d33gemv_tos(
+            (double *)x->rotation,
+            (double *)xd->angular_velocity,
+            (double *)r->angular_velocity);
+
+    // r x w'
+    struct vector3 rxw;
+    la_dcross_o((double *)x->translation, 1,
+            (double *)r->angular_velocity, 1,
+            (double *)&rxw, 1);
+
+    // v' = E^T v + r x w'
+    la_d33gemv_toe(
+            1.0, (double *)x->rotation, (double *)xd->linear_velocity,
+            1.0, (double *)&rxw,
+            (double *)r->linear_velocity);
+}
+
+
+void gc_twist_tf_ref_to_tgt_elementary(
+        const struct gc_elementary_pose *x,
+        const struct gc_twist *xd,
+        struct gc_twist *r)
+{
+    assert(x);
+    assert(xd);
+    assert(r);
+    assert(xd != r);
+    assert(x->axis >= 0 && x->axis < 3);
+
+    // Without a translation: w' = E w, v' = E v
+    elementary_rotate(x, (double *)xd->angular_velocity, (double *)r->angular_velocity);
+    elementary_rotate(x, (double *)xd->linear_velocity, (double *)r->linear_velocity);
 }
 
 
@@ -311,16 +472,33 @@ void gc_acc_twist_tf_ref_to_tgt(
             (double *)&v_rxw, 1);
 
     // v' = E(v - r x w)
-    la_dgemv_nos(3, 3,
-            (double *)x->rotation, 3,
-            (double *)xdd->angular_acceleration, 1,
-            (double *)r->angular_acceleration, 1);
+    la_d33gemv_nos(
+            (double *)x->rotation,
+            (double *)xdd->angular_acceleration,
+            (double *)r->angular_acceleration);
 
     // w' = E w
-    la_dgemv_nos(3, 3,
-            (double *)x->rotation, 3,
-            (double *)&v_rxw, 1,
-            (double *)r->linear_acceleration, 1);
+    la_d33gemv_nos(
+            (double *)x->rotation,
+            (double *)&v_rxw,
+            (double *)r->linear_acceleration);
+}
+
+
+void gc_acc_twist_tf_ref_to_tgt_elementary(
+        const struct gc_elementary_pose *x,
+        const struct gc_acc_twist *xdd,
+        struct gc_acc_twist *r)
+{
+    assert(x);
+    assert(xdd);
+    assert(r);
+    assert(xdd != r);
+    assert(x->axis >= 0 && x->axis < 3);
+
+    // Without a translation: w' = E w, v' = E v
+    elementary_rotate(x, (double *)xdd->angular_acceleration, (double *)r->angular_acceleration);
+    elementary_rotate(x, (double *)xdd->linear_acceleration, (double *)r->linear_acceleration);
 }
 
 
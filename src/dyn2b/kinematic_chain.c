@@ -1,6 +1,9 @@
 #include <dyn2b/functions/kinematic_chain.h>
 #include <dyn2b/functions/geometry.h>
+#include <dyn2b/functions/mechanics.h>
+#include <dyn2b/functions/linear_algebra.h>
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
@@ -148,102 +151,361 @@ void kca_project_wrench(
 }
 
 
-static void rev_fpk(
+// Index of segment i's parent segment or -1 for the base
+static inline int segment_parent(
+        const int *parent,
+        int i)
+{
+    return parent ? parent[i] : i - 1;
+}
+
+
+static int kca_segment_is_consistent(
+        const struct kca_segment *segment,
+        const struct kca_segment *parent)
+{
+    const struct ga_pose *x = &segment->joint_attachment;
+    const struct kca_joint *joint = &segment->joint;
+    const struct kca_link *link = &segment->link;
+
+    if (!x->target_frame || !x->reference_frame || !x->target_body || !x->reference_body) return 0;
+    if (!joint->target_frame || !joint->reference_frame || !joint->target_body || !joint->reference_body) return 0;
+    if (!link->root_frame || !link->root_frame->origin) return 0;
+
+    // The joint is attached to a frame on the predecessor's link...
+    if (x->target_body != x->reference_body) return 0;
+    if (parent && x->reference_frame != parent->link.root_frame) return 0;
+    if (parent && x->reference_body != parent->joint.target_body) return 0;
+
+    // ... and moves the successor's link w.r.t. that frame
+    if (joint->reference_frame != x->target_frame) return 0;
+    if (joint->reference_body != x->target_body) return 0;
+    if (joint->target_body == joint->reference_body) return 0;
+    if (link->root_frame != joint->target_frame) return 0;
+
+    // The inertia is expressed in the link's root frame at its origin
+    if (link->inertia.body != joint->target_body) return 0;
+    if (link->inertia.frame != link->root_frame) return 0;
+    if (link->inertia.point != link->root_frame->origin) return 0;
+
+    return 1;
+}
+
+
+int kca_verify(
+        const struct kca_kinematic_chain *kc,
+        int *segment)
+{
+    assert(kc);
+
+    for (int i = 0; i < kc->number_of_segments; i++) {
+        int p = segment_parent(kc->parent, i);
+        const struct kca_segment *parent = p >= 0 ? &kc->segment[p] : NULL;
+
+        // The segments must be in topological order
+        if (p < -1 || p >= i || !kca_segment_is_consistent(&kc->segment[i], parent)) {
+            if (segment) *segment = i;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+static int kcc_segment_is_complete(
+        const struct kcc_segment *segment)
+{
+    const struct kcc_joint *joint = &segment->joint;
+    double mass = segment->link.inertia.zeroth_moment_of_mass;
+
+    if (!segment->joint_attachment.rotation || !segment->joint_attachment.translation) return 0;
+    if (!(mass >= 0.0)) return 0;                   // also rejects NaN
+
+    switch (joint->type) {
+        case JOINT_TYPE_REVOLUTE:
+            return joint->revolute_joint.axis >= JOINT_AXIS_X
+                    && joint->revolute_joint.axis <= JOINT_AXIS_Z
+                    && joint->revolute_joint.inertia;
+        case JOINT_TYPE_PRISMATIC:
+            return joint->prismatic_joint.axis >= JOINT_AXIS_X
+                    && joint->prismatic_joint.axis <= JOINT_AXIS_Z
+                    && joint->prismatic_joint.inertia;
+        case JOINT_TYPE_FIXED:
+        case JOINT_TYPE_SPHERICAL:
+        case JOINT_TYPE_FREE_FLYER:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+
+int kcc_verify_coordinates(
+        const struct kcc_kinematic_chain *kc,
+        int *segment)
+{
+    assert(kc);
+
+    for (int i = 0; i < kc->number_of_segments; i++) {
+        int p = segment_parent(kc->parent, i);
+
+        if (p < -1 || p >= i || !kcc_segment_is_complete(&kc->segment[i])) {
+            if (segment) *segment = i;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+int kcc_verify(
+        const struct kca_kinematic_chain *kca,
+        struct kcc_kinematic_chain *kcc,
+        int *segment)
+{
+    assert(kca);
+    assert(kcc);
+
+    kcc->verified = 0;
+
+    if (kca->number_of_segments != kcc->number_of_segments) {
+        if (segment) *segment = -1;
+        return -1;
+    }
+
+    if (kca_verify(kca, segment) != 0) return -1;
+
+    for (int i = 0; i < kcc->number_of_segments; i++) {
+        if (segment_parent(kcc->parent, i) != segment_parent(kca->parent, i)
+                || !kcc_segment_is_complete(&kcc->segment[i])) {
+            if (segment) *segment = i;
+            return -1;
+        }
+    }
+
+    kcc->verified = 1;
+
+    return 0;
+}
+
+
+// Revolute joints
+//
+// The operators are specialized for each axis; the generic ones dispatch on
+// the joint's axis.
+
+static inline void rev_x_pose(
+        double cq,
+        double sq,
+        struct gc_pose *x)
+{
+    assert(x);
+    assert(x->rotation);
+    assert(x->translation);
+
+    // Note that the rotation for spatial transforms is inverted when compared
+    // to homogeneous transforms!
+    // |1  0  0 |
+    // |0  cq sq|
+    // |0 -sq cq|
+    x->rotation->row_x.x = 1.0;
+    x->rotation->row_x.y = 0.0;
+    x->rotation->row_x.z = 0.0;
+    x->rotation->row_y.x = 0.0;
+    x->rotation->row_y.y =  cq;
+    x->rotation->row_y.z =  sq;
+    x->rotation->row_z.x = 0.0;
+    x->rotation->row_z.y = -sq;
+    x->rotation->row_z.z =  cq;
+
+    x->translation->x = 0.0;
+    x->translation->y = 0.0;
+    x->translation->z = 0.0;
+}
+
+
+static void rev_x_fpk(
         const struct kcc_joint *joint,
         const joint_position *q,
         struct gc_pose *x)
 {
     assert(joint);
     assert(q);
+
+    rev_x_pose(cos(q[0]), sin(q[0]), x);
+}
+
+
+static inline void rev_y_pose(
+        double cq,
+        double sq,
+        struct gc_pose *x)
+{
     assert(x);
     assert(x->rotation);
     assert(x->translation);
 
-    double cq = cos(q[0]);
-    double sq = sin(q[0]);
+    // | cq 0 -sq|
+    // | 0  1  0 |
+    // | sq 0  cq|
+    x->rotation->row_x.x =  cq;
+    x->rotation->row_x.y = 0.0;
+    x->rotation->row_x.z = -sq;
+    x->rotation->row_y.x = 0.0;
+    x->rotation->row_y.y = 1.0;
+    x->rotation->row_y.z = 0.0;
+    x->rotation->row_z.x =  sq;
+    x->rotation->row_z.y = 0.0;
+    x->rotation->row_z.z =  cq;
+
+    x->translation->x = 0.0;
+    x->translation->y = 0.0;
+    x->translation->z = 0.0;
+}
 
-    // initialize all rotation matrix and position vector to 0.0
-    memset(x->rotation, 0, sizeof(*x->rotation));
-    memset(x->translation, 0, sizeof(*x->translation));
 
-    // Note that the rotation for spatial transforms is inverted when compared
-    // to homogeneous transforms!
-    if (joint->revolute_joint.axis == JOINT_AXIS_X) {
-        // |1  0  0 |
-        // |0  cq sq|
-        // |0 -sq cq|
-
-        x->rotation->row_x.x = 1.0;
-        x->rotation->row_y.y =  cq;
-        x->rotation->row_y.z =  sq;
-        x->rotation->row_z.y = -sq;
-        x->rotation->row_z.z =  cq;
-    } else if (joint->revolute_joint.axis == JOINT_AXIS_Y) {
-        // | cq 0 -sq|
-        // | 0  1  0 |
-        // | sq 0  cq|
-
-        x->rotation->row_y.y = 1.0;
-        x->rotation->row_x.x =  cq;
-        x->rotation->row_x.z = -sq;
-        x->rotation->row_z.x =  sq;
-        x->rotation->row_z.z =  cq;
-    } else if (joint->revolute_joint.axis == JOINT_AXIS_Z) {
-        // | cq sq 0|
-        // |-sq cq 0|
-        // | 0  0  1|
-
-        x->rotation->row_z.z = 1.0;
-        x->rotation->row_x.x =  cq;
-        x->rotation->row_x.y =  sq;
-        x->rotation->row_y.x = -sq;
-        x->rotation->row_y.y =  cq;
-    } else {
-        assert(0);
-    }
-}
-
-
-static void rev_fvk(
+static void rev_y_fpk(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        struct gc_pose *x)
+{
+    assert(joint);
+    assert(q);
+
+    rev_y_pose(cos(q[0]), sin(q[0]), x);
+}
+
+
+static inline void rev_z_pose(
+        double cq,
+        double sq,
+        struct gc_pose *x)
+{
+    assert(x);
+    assert(x->rotation);
+    assert(x->translation);
+
+    // | cq sq 0|
+    // |-sq cq 0|
+    // | 0  0  1|
+    x->rotation->row_x.x =  cq;
+    x->rotation->row_x.y =  sq;
+    x->rotation->row_x.z = 0.0;
+    x->rotation->row_y.x = -sq;
+    x->rotation->row_y.y =  cq;
+    x->rotation->row_y.z = 0.0;
+    x->rotation->row_z.x = 0.0;
+    x->rotation->row_z.y = 0.0;
+    x->rotation->row_z.z = 1.0;
+
+    x->translation->x = 0.0;
+    x->translation->y = 0.0;
+    x->translation->z = 0.0;
+}
+
+
+static void rev_z_fpk(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        struct gc_pose *x)
+{
+    assert(joint);
+    assert(q);
+
+    rev_z_pose(cos(q[0]), sin(q[0]), x);
+}
+
+
+// The joint's pose is an elementary rotation, hence the composition only
+// mixes two rows of X_T
+#define REV_FPK_COMPOSE(a, k) \
+    static void rev_##a##_fpk_compose_trig( \
+            const struct kcc_joint *joint, \
+            const double *cq, \
+            const double *sq, \
+            const struct gc_pose *x_t, \
+            struct gc_pose *x, \
+            struct gc_pose *r) \
+    { \
+        assert(joint); \
+        assert(cq); \
+        assert(sq); \
+        struct gc_elementary_pose e = { \
+            .axis = k, \
+            .cos_angle = cq[0], \
+            .sin_angle = sq[0] \
+        }; \
+        rev_##a##_pose(e.cos_angle, e.sin_angle, x); \
+        gc_pose_compose_elementary(&e, x_t, r); \
+    } \
+    static void rev_##a##_fpk_compose( \
+            const struct kcc_joint *joint, \
+            const joint_position *q, \
+            const struct gc_pose *x_t, \
+            struct gc_pose *x, \
+            struct gc_pose *r) \
+    { \
+        assert(q); \
+        double cq = cos(q[0]); \
+        double sq = sin(q[0]); \
+        rev_##a##_fpk_compose_trig(joint, &cq, &sq, x_t, x, r); \
+    }
+
+REV_FPK_COMPOSE(x, JOINT_AXIS_X)
+REV_FPK_COMPOSE(y, JOINT_AXIS_Y)
+REV_FPK_COMPOSE(z, JOINT_AXIS_Z)
+
+#undef REV_FPK_COMPOSE
+
+
+// Xd = e_k qd
+static inline void rev_k_fvk(
         const struct kcc_joint *joint,
         const joint_velocity *qd,
-        struct gc_twist *xd)
+        struct gc_twist *xd,
+        int k)
 {
     assert(joint);
     assert(qd);
     assert(xd);
     assert(xd->angular_velocity);
+    assert(xd->linear_velocity);
 
-    memset(xd->linear_velocity, 0, sizeof(*xd->linear_velocity));
-
-    enum joint_axis axis = joint->revolute_joint.axis;
-    xd->angular_velocity->x = (axis == JOINT_AXIS_X) ? qd[0] : 0.0;
-    xd->angular_velocity->y = (axis == JOINT_AXIS_Y) ? qd[0] : 0.0;
-    xd->angular_velocity->z = (axis == JOINT_AXIS_Z) ? qd[0] : 0.0;
+    for (int i = 0; i < 3; i++) {
+        xd->angular_velocity->data[i] = (i == k) ? qd[0] : 0.0;
+        xd->linear_velocity->data[i] = 0.0;
+    }
 }
 
 
-static void rev_fak(
+// Xdd = e_k qdd
+static inline void rev_k_fak(
         const struct kcc_joint *joint,
         const joint_acceleration *qdd,
-        struct gc_acc_twist *xdd)
+        struct gc_acc_twist *xdd,
+        int k)
 {
-    // initialize to 0.0
-    memset(xdd->angular_acceleration, 0, sizeof(*xdd->angular_acceleration));
-    memset(xdd->linear_acceleration, 0, sizeof(*xdd->linear_acceleration));
+    assert(joint);
+    assert(qdd);
+    assert(xdd);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
 
-    enum joint_axis axis = joint->revolute_joint.axis;
-    xdd->angular_acceleration->x = (axis == JOINT_AXIS_X) ? qdd[0] : 0.0;
-    xdd->angular_acceleration->y = (axis == JOINT_AXIS_Y) ? qdd[0] : 0.0;
-    xdd->angular_acceleration->z = (axis == JOINT_AXIS_Z) ? qdd[0] : 0.0;
+    for (int i = 0; i < 3; i++) {
+        xdd->angular_acceleration->data[i] = (i == k) ? qdd[0] : 0.0;
+        xdd->linear_acceleration->data[i] = 0.0;
+    }
 }
 
 
-static void rev_inertial_acceleration(
+static inline void rev_k_inertial_acceleration(
         const struct kcc_joint *joint,
         const struct gc_twist *xd,
         const joint_velocity *qd,
-        struct gc_acc_twist *xdd)
+        struct gc_acc_twist *xdd,
+        int k)
 {
     assert(joint);
     assert(xd);
@@ -257,152 +519,158 @@ static void rev_inertial_acceleration(
     // Bias acceleration
     //       w_1 x w_2       -> e.g. w_1 x [0, 0, 1]
     // w_1 x v_2 + v_1 x w_2 -> e.g. w_1 x [0, 0, 0] + v_1 x [0, 0, 1] = v_1 x [0, 0, 1]
-    if (joint->revolute_joint.axis == JOINT_AXIS_X) {
-        double w3m1 = xd->angular_velocity->z * qd[0];
-        double w2m1 = xd->angular_velocity->y * qd[0];
-        double v3m1 = xd->linear_velocity->z * qd[0];
-        double v2m1 = xd->linear_velocity->y * qd[0];
-
-        xdd->angular_acceleration->x =  0.0;
-        xdd->angular_acceleration->y =  w3m1;
-        xdd->angular_acceleration->z = -w2m1;
-        xdd->linear_acceleration->x =  0.0;
-        xdd->linear_acceleration->y =  v3m1;
-        xdd->linear_acceleration->z = -v2m1;
-    } else if (joint->revolute_joint.axis == JOINT_AXIS_Y) {
-        double w3m2 = xd->angular_velocity->z * qd[0];
-        double w1m2 = xd->angular_velocity->x * qd[0];
-        double v3m2 = xd->linear_velocity->z * qd[0];
-        double v1m2 = xd->linear_velocity->x * qd[0];
-
-        xdd->angular_acceleration->x = -w3m2;
-        xdd->angular_acceleration->y =  0.0;
-        xdd->angular_acceleration->z =  w1m2;
-        xdd->linear_acceleration->x = -v3m2;
-        xdd->linear_acceleration->y =  0.0;
-        xdd->linear_acceleration->z =  v1m2;
-    } else if (joint->revolute_joint.axis == JOINT_AXIS_Z) {
-        double w2m3 = xd->angular_velocity->y * qd[0];
-        double w1m3 = xd->angular_velocity->x * qd[0];
-        double v2m3 = xd->linear_velocity->y * qd[0];
-        double v1m3 = xd->linear_velocity->x * qd[0];
-
-        xdd->angular_acceleration->x =  w2m3;
-        xdd->angular_acceleration->y = -w1m3;
-        xdd->angular_acceleration->z =  0.0;
-        xdd->linear_acceleration->x =  v2m3;
-        xdd->linear_acceleration->y = -v1m3;
-        xdd->linear_acceleration->z =  0.0;
-    } else {
-        assert(0);
-    }
-}
-
-
-static void rev_ifk(
+    //
+    // With e_k the joint's axis and (k, k1, k2) a cyclic permutation of
+    // (x, y, z): w x e_k = w_k2 e_k1 - w_k1 e_k2
+    int k1 = (k + 1) % 3;
+    int k2 = (k + 2) % 3;
+
+    xdd->angular_acceleration->data[k] = 0.0;
+    xdd->angular_acceleration->data[k1] =  xd->angular_velocity->data[k2] * qd[0];
+    xdd->angular_acceleration->data[k2] = -xd->angular_velocity->data[k1] * qd[0];
+    xdd->linear_acceleration->data[k] = 0.0;
+    xdd->linear_acceleration->data[k1] =  xd->linear_velocity->data[k2] * qd[0];
+    xdd->linear_acceleration->data[k2] = -xd->linear_velocity->data[k1] * qd[0];
+}
+
+
+static inline void rev_k_ifk(
         const struct kcc_joint *joint,
         const struct mc_wrench *f,
         joint_torque *tau,
-        int count)
+        int count,
+        int k)
 {
     assert(joint);
     assert(f);
     assert(tau);
 
-    int k = joint->revolute_joint.axis;
-
     for (int i = 0; i < count; i++) {
         tau[i] = f->torque[i].data[k];
     }
 }
 
 
-static void rev_ffd(
+static void rev_inertial_torque(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        joint_torque *tau,
+        int count)
+{
+    assert(joint);
+    assert(qdd);
+    assert(tau);
+
+    double inertia = joint->revolute_joint.inertia[0];
+
+    for (int i = 0; i < count; i++) {
+        tau[i] = inertia * qdd[i];
+    }
+}
+
+
+static inline void rev_k_ffd(
         const struct kcc_joint *joint,
-        const struct mc_abi *m,
+        const struct mc_abi_packed *m,
         const joint_torque *tau,
         struct mc_wrench *f,
-        int count)
+        int count,
+        int k)
 {
     assert(joint);
     assert(m);
     assert(tau);
     assert(f);
 
-    int k = joint->revolute_joint.axis;
-    double d = m->second_moment_of_mass.row[k].data[k]
+    double d = m->second_moment_of_mass[MC_SYM33(k, k)]
             + joint->revolute_joint.inertia[0];
 
     for (int i = 0; i < count; i++) {
         double qdd = tau[i] / d;
         for (int j = 0; j < 3; j++) {
-            f->torque[i].data[j] = m->second_moment_of_mass.row[j].data[k] * qdd;
+            f->torque[i].data[j] = m->second_moment_of_mass[MC_SYM33(j, k)] * qdd;
             f->force[i].data[j] = m->first_moment_of_mass.row[k].data[j] * qdd;    // consider transpose, thus [k, j]
         }
     }
 }
 
 
-static void rev_project_inertia(
+static inline void rev_k_fad(
         const struct kcc_joint *joint,
-        const struct mc_abi *m,
-        struct mc_abi *r)
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        joint_acceleration *qdd,
+        int count,
+        int k)
 {
     assert(joint);
     assert(m);
-    assert(r);
-    assert(m != r);
-
-    int k = joint->revolute_joint.axis;
+    assert(tau);
+    assert(qdd);
 
-    double d = m->second_moment_of_mass.row[k].data[k]
+    double d = m->second_moment_of_mass[MC_SYM33(k, k)]
             + joint->revolute_joint.inertia[0];
     assert(d != 0.0);
 
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            // The (__ik/d) element represents an entry in the projection matrix P
-            // The __ij and __kj elements represent the entries of the inertia matrix M
-            //     __ij is associated with the diagonal one-element of the projection matrix (the "identity" matrix part)
-            //     -__kj is associated with the non-zero column of the projection matrix
+    for (int i = 0; i < count; i++) {
+        qdd[i] = tau[i] / d;
+    }
+}
 
-            // 0th moment of mass matrix
-            double m0ij = m->zeroth_moment_of_mass.row[i].data[j];
-            double m0ik = m->first_moment_of_mass.row[k].data[i];    // consider transpose, thus [k, i]
-            double m0kj = m->first_moment_of_mass.row[k].data[j];
 
-            double pm0 = m0ij - (m0ik * m0kj) / d;
+static inline void rev_k_project_inertia(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        struct mc_abi_packed *r,
+        int k)
+{
+    assert(joint);
+    assert(m);
+    assert(r);
+    assert(m != r);
 
-            r->zeroth_moment_of_mass.row[i].data[j] = pm0;
+    double d = m->second_moment_of_mass[MC_SYM33(k, k)]
+            + joint->revolute_joint.inertia[0];
+    assert(d != 0.0);
 
+    // The (__ik/d) element represents an entry in the projection matrix P
+    // The __ij and __kj elements represent the entries of the inertia matrix M
+    //     __ij is associated with the diagonal one-element of the projection matrix (the "identity" matrix part)
+    //     -__kj is associated with the non-zero column of the projection matrix
+    for (int i = 0; i < 3; i++) {
+        double m0ik = m->first_moment_of_mass.row[k].data[i];    // consider transpose, thus [k, i]
+        double m1ik = m->second_moment_of_mass[MC_SYM33(i, k)];
 
+        for (int j = 0; j < 3; j++) {
             // 1st moment of mass matrix
             double m1ij = m->first_moment_of_mass.row[i].data[j];
-            double m1ik = m->second_moment_of_mass.row[i].data[k];
             double m1kj = m->first_moment_of_mass.row[k].data[j];
-            double pm1 = m1ij - (m1ik * m1kj) / d;
-
-            r->first_moment_of_mass.row[i].data[j] = pm1;
+            r->first_moment_of_mass.row[i].data[j] = m1ij - (m1ik * m1kj) / d;
+        }
 
+        // The 0th and 2nd moments of mass matrices are symmetric
+        for (int j = i; j < 3; j++) {
+            // 0th moment of mass matrix
+            double m0ij = m->zeroth_moment_of_mass[MC_SYM33(i, j)];
+            double m0kj = m->first_moment_of_mass.row[k].data[j];
+            r->zeroth_moment_of_mass[MC_SYM33(i, j)] = m0ij - (m0ik * m0kj) / d;
 
             // 2nd moment of mass matrix
-            double mij = m->second_moment_of_mass.row[i].data[j];
-            double mik = m->second_moment_of_mass.row[i].data[k];
-            double mkj = m->second_moment_of_mass.row[k].data[j];
-            double pm = mij - (mik * mkj) / d;
-
-            r->second_moment_of_mass.row[i].data[j] = pm;
+            double mij = m->second_moment_of_mass[MC_SYM33(i, j)];
+            double mkj = m->second_moment_of_mass[MC_SYM33(k, j)];
+            r->second_moment_of_mass[MC_SYM33(i, j)] = mij - (m1ik * mkj) / d;
         }
     }
 }
 
 
-static void rev_project_wrench(
+static inline void rev_k_project_wrench(
         const struct kcc_joint *joint,
-        const struct mc_abi *m,
+        const struct mc_abi_packed *m,
         const struct mc_wrench *f,
         struct mc_wrench *r,
-        int count)
+        int count,
+        int k)
 {
     assert(joint);
     assert(m);
@@ -410,9 +678,7 @@ static void rev_project_wrench(
     assert(r);
     assert(f != r);
 
-    int k = joint->revolute_joint.axis;
-
-    double d = m->second_moment_of_mass.row[k].data[k]
+    double d = m->second_moment_of_mass[MC_SYM33(k, k)]
             + joint->revolute_joint.inertia[0];
     assert(d != 0.0);
 
@@ -420,7 +686,7 @@ static void rev_project_wrench(
         double qdd = f->torque[j].data[k] / d;
 
         for (int i = 0; i < 3; i++) {
-            double m2 = m->second_moment_of_mass.row[i].data[k];
+            double m2 = m->second_moment_of_mass[MC_SYM33(i, k)];
             r->torque[j].data[i] = f->torque[j].data[i] - (m2 * qdd);
 
             double m1 = m->first_moment_of_mass.row[k].data[i];               // consider transpose, thus [k, i]
@@ -430,15 +696,1344 @@ static void rev_project_wrench(
 }
 
 
-const struct kcc_joint_operators kcc_joint[] = {
-    [JOINT_TYPE_REVOLUTE] = {
-        .fpk = rev_fpk,
-        .fvk = rev_fvk,
-        .fak = rev_fak,
-        .inertial_acceleration = rev_inertial_acceleration,
-        .ifk = rev_ifk,
-        .ffd = rev_ffd,
-        .project_inertia = rev_project_inertia,
-        .project_wrench = rev_project_wrench
+// Instantiate the axis-generic operators for a constant axis, so that the
+// compiler folds the indexing and the branches on the axis
+#define REV_AXIS_OPERATORS(a, k) \
+    static void rev_##a##_fvk(const struct kcc_joint *joint, \
+            const joint_velocity *qd, struct gc_twist *xd) \
+    { rev_k_fvk(joint, qd, xd, k); } \
+    static void rev_##a##_fak(const struct kcc_joint *joint, \
+            const joint_acceleration *qdd, struct gc_acc_twist *xdd) \
+    { rev_k_fak(joint, qdd, xdd, k); } \
+    static void rev_##a##_inertial_acceleration(const struct kcc_joint *joint, \
+            const struct gc_twist *xd, const joint_velocity *qd, struct gc_acc_twist *xdd) \
+    { rev_k_inertial_acceleration(joint, xd, qd, xdd, k); } \
+    static void rev_##a##_ifk(const struct kcc_joint *joint, \
+            const struct mc_wrench *f, joint_torque *tau, int count) \
+    { rev_k_ifk(joint, f, tau, count, k); } \
+    static void rev_##a##_ffd(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const joint_torque *tau, struct mc_wrench *f, int count) \
+    { rev_k_ffd(joint, m, tau, f, count, k); } \
+    static void rev_##a##_fad(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const joint_torque *tau, joint_acceleration *qdd, int count) \
+    { rev_k_fad(joint, m, tau, qdd, count, k); } \
+    static void rev_##a##_project_inertia(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, struct mc_abi_packed *r) \
+    { rev_k_project_inertia(joint, m, r, k); } \
+    static void rev_##a##_project_wrench(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const struct mc_wrench *f, struct mc_wrench *r, int count) \
+    { rev_k_project_wrench(joint, m, f, r, count, k); }
+
+REV_AXIS_OPERATORS(x, JOINT_AXIS_X)
+REV_AXIS_OPERATORS(y, JOINT_AXIS_Y)
+REV_AXIS_OPERATORS(z, JOINT_AXIS_Z)
+
+#undef REV_AXIS_OPERATORS
+
+
+#define REV_AXIS_TABLE(a) { \
+        .nq = 1, \
+        .nd = 1, \
+        .fpk = rev_##a##_fpk, \
+        .fpk_compose = rev_##a##_fpk_compose, \
+        .fpk_compose_trig = rev_##a##_fpk_compose_trig, \
+        .fvk = rev_##a##_fvk, \
+        .fak = rev_##a##_fak, \
+        .inertial_acceleration = rev_##a##_inertial_acceleration, \
+        .ifk = rev_##a##_ifk, \
+        .inertial_torque = rev_inertial_torque, \
+        .ffd = rev_##a##_ffd, \
+        .fad = rev_##a##_fad, \
+        .project_inertia = rev_##a##_project_inertia, \
+        .project_wrench = rev_##a##_project_wrench \
     }
+
+const struct kcc_joint_operators kcc_revolute_joint[] = {
+    [JOINT_AXIS_X] = REV_AXIS_TABLE(x),
+    [JOINT_AXIS_Y] = REV_AXIS_TABLE(y),
+    [JOINT_AXIS_Z] = REV_AXIS_TABLE(z)
 };
+
+#undef REV_AXIS_TABLE
+
+
+// Prismatic joints
+//
+// X_J translates along the joint's axis k: E_J = 1, r_J = q e_k and
+// S = [0; e_k], i.e. the unit wrench's force along k is the joint's force.
+
+static inline void pri_k_fpk(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        struct gc_pose *x,
+        int k)
+{
+    assert(joint);
+    assert(q);
+    assert(x);
+    assert(x->rotation);
+    assert(x->translation);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            x->rotation->row[i].data[j] = (i == j) ? 1.0 : 0.0;
+        }
+        x->translation->data[i] = (i == k) ? q[0] : 0.0;
+    }
+}
+
+
+// E' = E_T, r' = r_T + E_T^T r_J = r_T + q (row k of E_T)
+static inline void pri_k_fpk_compose(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        const struct gc_pose *x_t,
+        struct gc_pose *x,
+        struct gc_pose *r,
+        int k)
+{
+    assert(x_t);
+    assert(r);
+    assert(x_t->rotation && x_t->translation);
+    assert(r->rotation && r->translation);
+
+    pri_k_fpk(joint, q, x, k);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r->rotation->row[i].data[j] = x_t->rotation->row[i].data[j];
+        }
+        r->translation->data[i] = x_t->translation->data[i]
+                + q[0] * x_t->rotation->row[k].data[i];
+    }
+}
+
+
+// Xd = [0; e_k] qd
+static inline void pri_k_fvk(
+        const struct kcc_joint *joint,
+        const joint_velocity *qd,
+        struct gc_twist *xd,
+        int k)
+{
+    assert(joint);
+    assert(qd);
+    assert(xd);
+    assert(xd->angular_velocity);
+    assert(xd->linear_velocity);
+
+    for (int i = 0; i < 3; i++) {
+        xd->angular_velocity->data[i] = 0.0;
+        xd->linear_velocity->data[i] = (i == k) ? qd[0] : 0.0;
+    }
+}
+
+
+// Xdd = [0; e_k] qdd
+static inline void pri_k_fak(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        struct gc_acc_twist *xdd,
+        int k)
+{
+    assert(joint);
+    assert(qdd);
+    assert(xdd);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
+
+    for (int i = 0; i < 3; i++) {
+        xdd->angular_acceleration->data[i] = 0.0;
+        xdd->linear_acceleration->data[i] = (i == k) ? qdd[0] : 0.0;
+    }
+}
+
+
+static inline void pri_k_inertial_acceleration(
+        const struct kcc_joint *joint,
+        const struct gc_twist *xd,
+        const joint_velocity *qd,
+        struct gc_acc_twist *xdd,
+        int k)
+{
+    assert(joint);
+    assert(xd);
+    assert(qd);
+    assert(xdd);
+    assert(xd->angular_velocity);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
+
+    // Bias acceleration
+    //       w_1 x 0         -> 0
+    // w_1 x v_2 + v_1 x 0   -> w_1 x e_k
+    int k1 = (k + 1) % 3;
+    int k2 = (k + 2) % 3;
+
+    xdd->angular_acceleration->data[0] = 0.0;
+    xdd->angular_acceleration->data[1] = 0.0;
+    xdd->angular_acceleration->data[2] = 0.0;
+    xdd->linear_acceleration->data[k] = 0.0;
+    xdd->linear_acceleration->data[k1] =  xd->angular_velocity->data[k2] * qd[0];
+    xdd->linear_acceleration->data[k2] = -xd->angular_velocity->data[k1] * qd[0];
+}
+
+
+static inline void pri_k_ifk(
+        const struct kcc_joint *joint,
+        const struct mc_wrench *f,
+        joint_torque *tau,
+        int count,
+        int k)
+{
+    assert(joint);
+    assert(f);
+    assert(tau);
+
+    for (int i = 0; i < count; i++) {
+        tau[i] = f->force[i].data[k];
+    }
+}
+
+
+static void pri_inertial_torque(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        joint_torque *tau,
+        int count)
+{
+    assert(joint);
+    assert(qdd);
+    assert(tau);
+
+    double inertia = joint->prismatic_joint.inertia[0];
+
+    for (int i = 0; i < count; i++) {
+        tau[i] = inertia * qdd[i];
+    }
+}
+
+
+// M^A S = [H e_k; M e_k], i.e. the k-th columns of the first and zeroth
+// moments of mass
+static inline void pri_k_ffd(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        struct mc_wrench *f,
+        int count,
+        int k)
+{
+    assert(joint);
+    assert(m);
+    assert(tau);
+    assert(f);
+
+    double d = m->zeroth_moment_of_mass[MC_SYM33(k, k)]
+            + joint->prismatic_joint.inertia[0];
+
+    for (int i = 0; i < count; i++) {
+        double qdd = tau[i] / d;
+        for (int j = 0; j < 3; j++) {
+            f->torque[i].data[j] = m->first_moment_of_mass.row[j].data[k] * qdd;
+            f->force[i].data[j] = m->zeroth_moment_of_mass[MC_SYM33(j, k)] * qdd;
+        }
+    }
+}
+
+
+static inline void pri_k_fad(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        joint_acceleration *qdd,
+        int count,
+        int k)
+{
+    assert(joint);
+    assert(m);
+    assert(tau);
+    assert(qdd);
+
+    double d = m->zeroth_moment_of_mass[MC_SYM33(k, k)]
+            + joint->prismatic_joint.inertia[0];
+    assert(d != 0.0);
+
+    for (int i = 0; i < count; i++) {
+        qdd[i] = tau[i] / d;
+    }
+}
+
+
+static inline void pri_k_project_inertia(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        struct mc_abi_packed *r,
+        int k)
+{
+    assert(joint);
+    assert(m);
+    assert(r);
+    assert(m != r);
+
+    double d = m->zeroth_moment_of_mass[MC_SYM33(k, k)]
+            + joint->prismatic_joint.inertia[0];
+    assert(d != 0.0);
+
+    // M^a = M^A - U U^T / d with U = M^A S = [u; v], where u is the k-th
+    // column of the first moment of mass and v the one of the zeroth moment
+    for (int i = 0; i < 3; i++) {
+        double ui = m->first_moment_of_mass.row[i].data[k];
+        double vi = m->zeroth_moment_of_mass[MC_SYM33(i, k)];
+
+        for (int j = 0; j < 3; j++) {
+            // 1st moment of mass matrix
+            double vj = m->zeroth_moment_of_mass[MC_SYM33(j, k)];
+            r->first_moment_of_mass.row[i].data[j] =
+                    m->first_moment_of_mass.row[i].data[j] - (ui * vj) / d;
+        }
+
+        // The 0th and 2nd moments of mass matrices are symmetric
+        for (int j = i; j < 3; j++) {
+            double uj = m->first_moment_of_mass.row[j].data[k];
+            double vj = m->zeroth_moment_of_mass[MC_SYM33(j, k)];
+
+            r->zeroth_moment_of_mass[MC_SYM33(i, j)] =
+                    m->zeroth_moment_of_mass[MC_SYM33(i, j)] - (vi * vj) / d;
+            r->second_moment_of_mass[MC_SYM33(i, j)] =
+                    m->second_moment_of_mass[MC_SYM33(i, j)] - (ui * uj) / d;
+        }
+    }
+}
+
+
+static inline void pri_k_project_wrench(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const struct mc_wrench *f,
+        struct mc_wrench *r,
+        int count,
+        int k)
+{
+    assert(joint);
+    assert(m);
+    assert(f);
+    assert(r);
+    assert(f != r);
+
+    double d = m->zeroth_moment_of_mass[MC_SYM33(k, k)]
+            + joint->prismatic_joint.inertia[0];
+    assert(d != 0.0);
+
+    for (int j = 0; j < count; j++) {
+        double qdd = f->force[j].data[k] / d;
+
+        for (int i = 0; i < 3; i++) {
+            double u = m->first_moment_of_mass.row[i].data[k];
+            r->torque[j].data[i] = f->torque[j].data[i] - (u * qdd);
+
+            double v = m->zeroth_moment_of_mass[MC_SYM33(i, k)];
+            r->force[j].data[i] = f->force[j].data[i] - (v * qdd);
+        }
+    }
+}
+
+
+#define PRI_AXIS_OPERATORS(a, k) \
+    static void pri_##a##_fpk(const struct kcc_joint *joint, \
+            const joint_position *q, struct gc_pose *x) \
+    { pri_k_fpk(joint, q, x, k); } \
+    static void pri_##a##_fpk_compose(const struct kcc_joint *joint, \
+            const joint_position *q, const struct gc_pose *x_t, struct gc_pose *x, struct gc_pose *r) \
+    { pri_k_fpk_compose(joint, q, x_t, x, r, k); } \
+    static void pri_##a##_fvk(const struct kcc_joint *joint, \
+            const joint_velocity *qd, struct gc_twist *xd) \
+    { pri_k_fvk(joint, qd, xd, k); } \
+    static void pri_##a##_fak(const struct kcc_joint *joint, \
+            const joint_acceleration *qdd, struct gc_acc_twist *xdd) \
+    { pri_k_fak(joint, qdd, xdd, k); } \
+    static void pri_##a##_inertial_acceleration(const struct kcc_joint *joint, \
+            const struct gc_twist *xd, const joint_velocity *qd, struct gc_acc_twist *xdd) \
+    { pri_k_inertial_acceleration(joint, xd, qd, xdd, k); } \
+    static void pri_##a##_ifk(const struct kcc_joint *joint, \
+            const struct mc_wrench *f, joint_torque *tau, int count) \
+    { pri_k_ifk(joint, f, tau, count, k); } \
+    static void pri_##a##_ffd(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const joint_torque *tau, struct mc_wrench *f, int count) \
+    { pri_k_ffd(joint, m, tau, f, count, k); } \
+    static void pri_##a##_fad(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const joint_torque *tau, joint_acceleration *qdd, int count) \
+    { pri_k_fad(joint, m, tau, qdd, count, k); } \
+    static void pri_##a##_project_inertia(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, struct mc_abi_packed *r) \
+    { pri_k_project_inertia(joint, m, r, k); } \
+    static void pri_##a##_project_wrench(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const struct mc_wrench *f, struct mc_wrench *r, int count) \
+    { pri_k_project_wrench(joint, m, f, r, count, k); }
+
+PRI_AXIS_OPERATORS(x, JOINT_AXIS_X)
+PRI_AXIS_OPERATORS(y, JOINT_AXIS_Y)
+PRI_AXIS_OPERATORS(z, JOINT_AXIS_Z)
+
+#undef PRI_AXIS_OPERATORS
+
+
+#define PRI_AXIS_TABLE(a) { \
+        .nq = 1, \
+        .nd = 1, \
+        .fpk = pri_##a##_fpk, \
+        .fpk_compose = pri_##a##_fpk_compose, \
+        .fvk = pri_##a##_fvk, \
+        .fak = pri_##a##_fak, \
+        .inertial_acceleration = pri_##a##_inertial_acceleration, \
+        .ifk = pri_##a##_ifk, \
+        .inertial_torque = pri_inertial_torque, \
+        .ffd = pri_##a##_ffd, \
+        .fad = pri_##a##_fad, \
+        .project_inertia = pri_##a##_project_inertia, \
+        .project_wrench = pri_##a##_project_wrench \
+    }
+
+const struct kcc_joint_operators kcc_prismatic_joint[] = {
+    [JOINT_AXIS_X] = PRI_AXIS_TABLE(x),
+    [JOINT_AXIS_Y] = PRI_AXIS_TABLE(y),
+    [JOINT_AXIS_Z] = PRI_AXIS_TABLE(z)
+};
+
+#undef PRI_AXIS_TABLE
+
+
+// Fixed joints
+//
+// X_J = 1 and S is empty, hence the joint has no coordinates to read or write.
+
+static void fix_fpk(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        struct gc_pose *x)
+{
+    assert(joint);
+    assert(x);
+    assert(x->rotation);
+    assert(x->translation);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            x->rotation->row[i].data[j] = (i == j) ? 1.0 : 0.0;
+        }
+        x->translation->data[i] = 0.0;
+    }
+}
+
+
+static void fix_fpk_compose(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        const struct gc_pose *x_t,
+        struct gc_pose *x,
+        struct gc_pose *r)
+{
+    assert(x_t);
+    assert(r);
+    assert(x_t->rotation && x_t->translation);
+    assert(r->rotation && r->translation);
+
+    fix_fpk(joint, q, x);
+
+    *r->rotation = *x_t->rotation;
+    *r->translation = *x_t->translation;
+}
+
+
+static void fix_fvk(
+        const struct kcc_joint *joint,
+        const joint_velocity *qd,
+        struct gc_twist *xd)
+{
+    assert(joint);
+    assert(xd);
+    assert(xd->angular_velocity);
+    assert(xd->linear_velocity);
+
+    memset(xd->angular_velocity, 0, sizeof(*xd->angular_velocity));
+    memset(xd->linear_velocity, 0, sizeof(*xd->linear_velocity));
+}
+
+
+static void fix_fak(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        struct gc_acc_twist *xdd)
+{
+    assert(joint);
+    assert(xdd);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
+
+    memset(xdd->angular_acceleration, 0, sizeof(*xdd->angular_acceleration));
+    memset(xdd->linear_acceleration, 0, sizeof(*xdd->linear_acceleration));
+}
+
+
+static void fix_inertial_acceleration(
+        const struct kcc_joint *joint,
+        const struct gc_twist *xd,
+        const joint_velocity *qd,
+        struct gc_acc_twist *xdd)
+{
+    fix_fak(joint, qd, xdd);
+}
+
+
+static void fix_ifk(
+        const struct kcc_joint *joint,
+        const struct mc_wrench *f,
+        joint_torque *tau,
+        int count)
+{
+    assert(joint);
+}
+
+
+static void fix_inertial_torque(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        joint_torque *tau,
+        int count)
+{
+    fix_ifk(joint, NULL, tau, count);
+}
+
+
+static void fix_ffd(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        struct mc_wrench *f,
+        int count)
+{
+    assert(joint);
+    assert(f);
+
+    memset(f->torque, 0, count * sizeof(*f->torque));
+    memset(f->force, 0, count * sizeof(*f->force));
+}
+
+
+static void fix_fad(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        joint_acceleration *qdd,
+        int count)
+{
+    fix_ifk(joint, NULL, qdd, count);
+}
+
+
+// Without a degree of freedom the projection is the identity
+static void fix_project_inertia(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        struct mc_abi_packed *r)
+{
+    assert(joint);
+    assert(m);
+    assert(r);
+    assert(m != r);
+
+    *r = *m;
+}
+
+
+static void fix_project_wrench(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const struct mc_wrench *f,
+        struct mc_wrench *r,
+        int count)
+{
+    assert(joint);
+    assert(f);
+    assert(r);
+    assert(f != r);
+
+    memcpy(r->torque, f->torque, count * sizeof(*f->torque));
+    memcpy(r->force, f->force, count * sizeof(*f->force));
+}
+
+
+// Multi-DoF joints
+//
+// Spherical and free-flyer joints move in the target's coordinates, hence S
+// is constant: S = [1; 0] for spherical and S = 1 for free-flyer joints. Their
+// orientation is a quaternion and D = S^T M^A S is a 3x3 or 6x6 block of M^A,
+// which is inverted with an LDL^T factorization.
+
+// E_J = R(quat)^T, i.e. the transpose of the rotation that maps the target's
+// coordinates to the reference frame's. The quaternion does not have to be
+// normalized exactly, so that integration drift does not distort the pose.
+static void quaternion_pose(
+        const joint_position *quat,
+        struct matrix3x3 *e)
+{
+    double x = quat[0];
+    double y = quat[1];
+    double z = quat[2];
+    double w = quat[3];
+
+    double n = x * x + y * y + z * z + w * w;
+    assert(n > 0.0);
+    double s = 2.0 / n;
+
+    e->row_x.x = 1.0 - s * (y * y + z * z);
+    e->row_x.y = s * (x * y + z * w);
+    e->row_x.z = s * (x * z - y * w);
+    e->row_y.x = s * (x * y - z * w);
+    e->row_y.y = 1.0 - s * (x * x + z * z);
+    e->row_y.z = s * (y * z + x * w);
+    e->row_z.x = s * (x * z + y * w);
+    e->row_z.y = s * (y * z - x * w);
+    e->row_z.z = 1.0 - s * (x * x + y * y);
+}
+
+
+// Leading n x n block of M^A = [I H; H^T M] (n = 3 or 6), factorized as
+// L D L^T
+static void abi_factorize(
+        const struct mc_abi_packed *m,
+        int n,
+        double *ld)
+{
+    double d[36];
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            d[i * n + j] = m->second_moment_of_mass[MC_SYM33(i, j)];
+            if (n == 6) {
+                d[i * n + j + 3] = m->first_moment_of_mass.row[i].data[j];
+                d[(i + 3) * n + j] = m->first_moment_of_mass.row[j].data[i];
+                d[(i + 3) * n + j + 3] = m->zeroth_moment_of_mass[MC_SYM33(i, j)];
+            }
+        }
+    }
+
+    la_dsytrf_los(n, d, n, ld, n);
+}
+
+
+// x = (L D L^T)^{-1} b
+static void abi_solve(
+        int n,
+        const double *ld,
+        const double *b,
+        double *x)
+{
+    la_trsv_lnd(n, ld, n, b, 1, x, 1);
+    for (int i = 0; i < n; i++) {
+        x[i] /= ld[i * n + i];
+    }
+    la_trsv_ltd(n, ld, n, x, 1, x, 1);
+}
+
+
+// Spherical joints
+
+static void sph_fpk(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        struct gc_pose *x)
+{
+    assert(joint);
+    assert(q);
+    assert(x);
+    assert(x->rotation);
+    assert(x->translation);
+
+    quaternion_pose(q, x->rotation);
+
+    x->translation->x = 0.0;
+    x->translation->y = 0.0;
+    x->translation->z = 0.0;
+}
+
+
+static void sph_fpk_compose(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        const struct gc_pose *x_t,
+        struct gc_pose *x,
+        struct gc_pose *r)
+{
+    sph_fpk(joint, q, x);
+    gc_pose_compose(x, x_t, r);
+}
+
+
+// Xd = [qd; 0]
+static void sph_fvk(
+        const struct kcc_joint *joint,
+        const joint_velocity *qd,
+        struct gc_twist *xd)
+{
+    assert(joint);
+    assert(qd);
+    assert(xd);
+    assert(xd->angular_velocity);
+    assert(xd->linear_velocity);
+
+    for (int i = 0; i < 3; i++) {
+        xd->angular_velocity->data[i] = qd[i];
+        xd->linear_velocity->data[i] = 0.0;
+    }
+}
+
+
+// Xdd = [qdd; 0]
+static void sph_fak(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        struct gc_acc_twist *xdd)
+{
+    assert(joint);
+    assert(qdd);
+    assert(xdd);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
+
+    for (int i = 0; i < 3; i++) {
+        xdd->angular_acceleration->data[i] = qdd[i];
+        xdd->linear_acceleration->data[i] = 0.0;
+    }
+}
+
+
+// Xd x [qd; 0] = [w x qd; v x qd]
+static void sph_inertial_acceleration(
+        const struct kcc_joint *joint,
+        const struct gc_twist *xd,
+        const joint_velocity *qd,
+        struct gc_acc_twist *xdd)
+{
+    assert(joint);
+    assert(xd);
+    assert(qd);
+    assert(xdd);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
+
+    la_dcross_o(xd->angular_velocity->data, 1, qd, 1, xdd->angular_acceleration->data, 1);
+    la_dcross_o(xd->linear_velocity->data, 1, qd, 1, xdd->linear_acceleration->data, 1);
+}
+
+
+// tau = torque
+static void sph_ifk(
+        const struct kcc_joint *joint,
+        const struct mc_wrench *f,
+        joint_torque *tau,
+        int count)
+{
+    assert(joint);
+    assert(f);
+    assert(tau);
+
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < 3; j++) {
+            tau[i * 3 + j] = f->torque[i].data[j];
+        }
+    }
+}
+
+
+// A spherical joint has no drive of its own
+static void sph_inertial_torque(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        joint_torque *tau,
+        int count)
+{
+    assert(joint);
+    assert(tau);
+
+    memset(tau, 0, count * 3 * sizeof(*tau));
+}
+
+
+// D = I^A, the articulated second moment of mass. Since M^A S D^{-1} = [1;
+// H^T I^{-1}], the torque passes the joint unchanged and only the force
+// depends on the inverse.
+static void sph_ffd(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        struct mc_wrench *f,
+        int count)
+{
+    assert(joint);
+    assert(m);
+    assert(tau);
+    assert(f);
+
+    double ld[9];
+    abi_factorize(m, 3, ld);
+
+    for (int i = 0; i < count; i++) {
+        double qdd[3];
+        abi_solve(3, ld, &tau[i * 3], qdd);
+
+        for (int j = 0; j < 3; j++) {
+            f->torque[i].data[j] = tau[i * 3 + j];
+            f->force[i].data[j] = m->first_moment_of_mass.row[0].data[j] * qdd[0]
+                    + m->first_moment_of_mass.row[1].data[j] * qdd[1]
+                    + m->first_moment_of_mass.row[2].data[j] * qdd[2];
+        }
+    }
+}
+
+
+static void sph_fad(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        joint_acceleration *qdd,
+        int count)
+{
+    assert(joint);
+    assert(m);
+    assert(tau);
+    assert(qdd);
+
+    double ld[9];
+    abi_factorize(m, 3, ld);
+
+    for (int i = 0; i < count; i++) {
+        abi_solve(3, ld, &tau[i * 3], &qdd[i * 3]);
+    }
+}
+
+
+// M^a = M^A - [I; H^T] I^{-1} [I H] = [0 0; 0 M - H^T I^{-1} H]
+static void sph_project_inertia(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        struct mc_abi_packed *r)
+{
+    assert(joint);
+    assert(m);
+    assert(r);
+    assert(m != r);
+
+    double ld[9];
+    abi_factorize(m, 3, ld);
+
+    // Y = I^{-1} H, column by column
+    double y[3][3];
+    for (int j = 0; j < 3; j++) {
+        double h[3] = {
+            m->first_moment_of_mass.row[0].data[j],
+            m->first_moment_of_mass.row[1].data[j],
+            m->first_moment_of_mass.row[2].data[j]
+        };
+        abi_solve(3, ld, h, y[j]);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r->first_moment_of_mass.row[i].data[j] = 0.0;
+        }
+
+        for (int j = i; j < 3; j++) {
+            r->zeroth_moment_of_mass[MC_SYM33(i, j)] = m->zeroth_moment_of_mass[MC_SYM33(i, j)]
+                    - m->first_moment_of_mass.row[0].data[i] * y[j][0]
+                    - m->first_moment_of_mass.row[1].data[i] * y[j][1]
+                    - m->first_moment_of_mass.row[2].data[i] * y[j][2];
+            r->second_moment_of_mass[MC_SYM33(i, j)] = 0.0;
+        }
+    }
+}
+
+
+// F^a = F - [I; H^T] I^{-1} torque = [0; force - H^T I^{-1} torque]
+static void sph_project_wrench(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const struct mc_wrench *f,
+        struct mc_wrench *r,
+        int count)
+{
+    assert(joint);
+    assert(m);
+    assert(f);
+    assert(r);
+    assert(f != r);
+
+    double ld[9];
+    abi_factorize(m, 3, ld);
+
+    for (int i = 0; i < count; i++) {
+        double x[3];
+        abi_solve(3, ld, f->torque[i].data, x);
+
+        for (int j = 0; j < 3; j++) {
+            r->torque[i].data[j] = 0.0;
+            r->force[i].data[j] = f->force[i].data[j]
+                    - m->first_moment_of_mass.row[0].data[j] * x[0]
+                    - m->first_moment_of_mass.row[1].data[j] * x[1]
+                    - m->first_moment_of_mass.row[2].data[j] * x[2];
+        }
+    }
+}
+
+
+// Free-flyer joints
+//
+// S = 1, hence the joint transmits no wrench: the projections vanish and the
+// wrench that accelerates the target is the joint's "torque" itself.
+
+static void ffl_fpk(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        struct gc_pose *x)
+{
+    assert(joint);
+    assert(q);
+    assert(x);
+    assert(x->rotation);
+    assert(x->translation);
+
+    quaternion_pose(&q[3], x->rotation);
+
+    x->translation->x = q[0];
+    x->translation->y = q[1];
+    x->translation->z = q[2];
+}
+
+
+static void ffl_fpk_compose(
+        const struct kcc_joint *joint,
+        const joint_position *q,
+        const struct gc_pose *x_t,
+        struct gc_pose *x,
+        struct gc_pose *r)
+{
+    ffl_fpk(joint, q, x);
+    gc_pose_compose(x, x_t, r);
+}
+
+
+// Xd = qd
+static void ffl_fvk(
+        const struct kcc_joint *joint,
+        const joint_velocity *qd,
+        struct gc_twist *xd)
+{
+    assert(joint);
+    assert(qd);
+    assert(xd);
+    assert(xd->angular_velocity);
+    assert(xd->linear_velocity);
+
+    for (int i = 0; i < 3; i++) {
+        xd->angular_velocity->data[i] = qd[i];
+        xd->linear_velocity->data[i] = qd[i + 3];
+    }
+}
+
+
+// Xdd = qdd
+static void ffl_fak(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        struct gc_acc_twist *xdd)
+{
+    assert(joint);
+    assert(qdd);
+    assert(xdd);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
+
+    for (int i = 0; i < 3; i++) {
+        xdd->angular_acceleration->data[i] = qdd[i];
+        xdd->linear_acceleration->data[i] = qdd[i + 3];
+    }
+}
+
+
+// Xd x qd = [w x w_J; w x v_J + v x w_J]
+static void ffl_inertial_acceleration(
+        const struct kcc_joint *joint,
+        const struct gc_twist *xd,
+        const joint_velocity *qd,
+        struct gc_acc_twist *xdd)
+{
+    assert(joint);
+    assert(xd);
+    assert(qd);
+    assert(xdd);
+    assert(xdd->angular_acceleration);
+    assert(xdd->linear_acceleration);
+
+    double wv[3];
+    double vw[3];
+    la_dcross_o(xd->angular_velocity->data, 1, &qd[3], 1, wv, 1);
+    la_dcross_o(xd->linear_velocity->data, 1, &qd[0], 1, vw, 1);
+    la_dcross_o(xd->angular_velocity->data, 1, &qd[0], 1, xdd->angular_acceleration->data, 1);
+
+    for (int i = 0; i < 3; i++) {
+        xdd->linear_acceleration->data[i] = wv[i] + vw[i];
+    }
+}
+
+
+// tau = [torque; force]
+static void ffl_ifk(
+        const struct kcc_joint *joint,
+        const struct mc_wrench *f,
+        joint_torque *tau,
+        int count)
+{
+    assert(joint);
+    assert(f);
+    assert(tau);
+
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < 3; j++) {
+            tau[i * 6 + j] = f->torque[i].data[j];
+            tau[i * 6 + j + 3] = f->force[i].data[j];
+        }
+    }
+}
+
+
+// A free-flyer joint has no drive of its own
+static void ffl_inertial_torque(
+        const struct kcc_joint *joint,
+        const joint_acceleration *qdd,
+        joint_torque *tau,
+        int count)
+{
+    assert(joint);
+    assert(tau);
+
+    memset(tau, 0, count * 6 * sizeof(*tau));
+}
+
+
+// F = M^A (M^A)^{-1} tau = tau
+static void ffl_ffd(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        struct mc_wrench *f,
+        int count)
+{
+    assert(joint);
+    assert(tau);
+    assert(f);
+
+    for (int i = 0; i < count; i++) {
+        for (int j = 0; j < 3; j++) {
+            f->torque[i].data[j] = tau[i * 6 + j];
+            f->force[i].data[j] = tau[i * 6 + j + 3];
+        }
+    }
+}
+
+
+static void ffl_fad(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const joint_torque *tau,
+        joint_acceleration *qdd,
+        int count)
+{
+    assert(joint);
+    assert(m);
+    assert(tau);
+    assert(qdd);
+
+    double ld[36];
+    abi_factorize(m, 6, ld);
+
+    for (int i = 0; i < count; i++) {
+        abi_solve(6, ld, &tau[i * 6], &qdd[i * 6]);
+    }
+}
+
+
+static void ffl_project_inertia(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        struct mc_abi_packed *r)
+{
+    assert(joint);
+    assert(r);
+
+    memset(r, 0, sizeof(*r));
+}
+
+
+static void ffl_project_wrench(
+        const struct kcc_joint *joint,
+        const struct mc_abi_packed *m,
+        const struct mc_wrench *f,
+        struct mc_wrench *r,
+        int count)
+{
+    assert(joint);
+    assert(r);
+
+    memset(r->torque, 0, count * sizeof(*r->torque));
+    memset(r->force, 0, count * sizeof(*r->force));
+}
+
+
+// Generic operators
+//
+// The operators of the joint types with an axis dispatch to the table of the
+// joint's axis.
+
+#define AXIS_DISPATCH(pre, member, table) \
+    static const struct kcc_joint_operators *pre##_operators( \
+            const struct kcc_joint *joint) \
+    { \
+        assert(joint); \
+        assert(joint->member.axis >= JOINT_AXIS_X); \
+        assert(joint->member.axis <= JOINT_AXIS_Z); \
+        return &table[joint->member.axis]; \
+    } \
+    static void pre##_fpk(const struct kcc_joint *joint, \
+            const joint_position *q, struct gc_pose *x) \
+    { pre##_operators(joint)->fpk(joint, q, x); } \
+    static void pre##_fpk_compose(const struct kcc_joint *joint, \
+            const joint_position *q, const struct gc_pose *x_t, struct gc_pose *x, struct gc_pose *r) \
+    { pre##_operators(joint)->fpk_compose(joint, q, x_t, x, r); } \
+    static void pre##_fvk(const struct kcc_joint *joint, \
+            const joint_velocity *qd, struct gc_twist *xd) \
+    { pre##_operators(joint)->fvk(joint, qd, xd); } \
+    static void pre##_fak(const struct kcc_joint *joint, \
+            const joint_acceleration *qdd, struct gc_acc_twist *xdd) \
+    { pre##_operators(joint)->fak(joint, qdd, xdd); } \
+    static void pre##_inertial_acceleration(const struct kcc_joint *joint, \
+            const struct gc_twist *xd, const joint_velocity *qd, struct gc_acc_twist *xdd) \
+    { pre##_operators(joint)->inertial_acceleration(joint, xd, qd, xdd); } \
+    static void pre##_ifk(const struct kcc_joint *joint, \
+            const struct mc_wrench *f, joint_torque *tau, int count) \
+    { pre##_operators(joint)->ifk(joint, f, tau, count); } \
+    static void pre##_ffd(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const joint_torque *tau, struct mc_wrench *f, int count) \
+    { pre##_operators(joint)->ffd(joint, m, tau, f, count); } \
+    static void pre##_fad(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const joint_torque *tau, joint_acceleration *qdd, int count) \
+    { pre##_operators(joint)->fad(joint, m, tau, qdd, count); } \
+    static void pre##_project_inertia(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, struct mc_abi_packed *r) \
+    { pre##_operators(joint)->project_inertia(joint, m, r); } \
+    static void pre##_project_wrench(const struct kcc_joint *joint, \
+            const struct mc_abi_packed *m, const struct mc_wrench *f, struct mc_wrench *r, int count) \
+    { pre##_operators(joint)->project_wrench(joint, m, f, r, count); }
+
+AXIS_DISPATCH(rev, revolute_joint, kcc_revolute_joint)
+AXIS_DISPATCH(pri, prismatic_joint, kcc_prismatic_joint)
+
+#undef AXIS_DISPATCH
+
+
+static void rev_fpk_compose_trig(
+        const struct kcc_joint *joint,
+        const double *cq,
+        const double *sq,
+        const struct gc_pose *x_t,
+        struct gc_pose *x,
+        struct gc_pose *r)
+{
+    rev_operators(joint)->fpk_compose_trig(joint, cq, sq, x_t, x, r);
+}
+
+
+#define JOINT_TABLE(pre, nq_, nd_, trig) { \
+        .nq = nq_, \
+        .nd = nd_, \
+        .fpk = pre##_fpk, \
+        .fpk_compose = pre##_fpk_compose, \
+        .fpk_compose_trig = trig, \
+        .fvk = pre##_fvk, \
+        .fak = pre##_fak, \
+        .inertial_acceleration = pre##_inertial_acceleration, \
+        .ifk = pre##_ifk, \
+        .inertial_torque = pre##_inertial_torque, \
+        .ffd = pre##_ffd, \
+        .fad = pre##_fad, \
+        .project_inertia = pre##_project_inertia, \
+        .project_wrench = pre##_project_wrench \
+    }
+
+const struct kcc_joint_operators kcc_joint[] = {
+    [JOINT_TYPE_REVOLUTE] = JOINT_TABLE(rev, 1, 1, rev_fpk_compose_trig),
+    [JOINT_TYPE_PRISMATIC] = JOINT_TABLE(pri, 1, 1, NULL),
+    [JOINT_TYPE_FIXED] = JOINT_TABLE(fix, 0, 0, NULL),
+    [JOINT_TYPE_SPHERICAL] = JOINT_TABLE(sph, 4, 3, NULL),
+    [JOINT_TYPE_FREE_FLYER] = JOINT_TABLE(ffl, 7, 6, NULL)
+};
+
+#undef JOINT_TABLE
+
+
+const struct kcc_joint_operators *kcc_joint_resolve(
+        const struct kcc_joint *joint)
+{
+    assert(joint);
+
+    switch (joint->type) {
+        case JOINT_TYPE_REVOLUTE:
+            return rev_operators(joint);
+        case JOINT_TYPE_PRISMATIC:
+            return pri_operators(joint);
+        default:
+            return &kcc_joint[joint->type];
+    }
+}
+
+
+int kcc_compile(
+        struct kcc_kinematic_chain *kc)
+{
+    assert(kc);
+
+    for (int i = 0; i < kc->number_of_segments; i++) {
+        if (kc->segment[i].joint.type == JOINT_TYPE_FIXED) return -1;
+    }
+
+    for (int i = 0; i < kc->number_of_segments; i++) {
+        struct kcc_joint *joint = &kc->segment[i].joint;
+        joint->operators = kcc_joint_resolve(joint);
+    }
+
+    return 0;
+}
+
+
+void kcc_dimensions(
+        const struct kcc_kinematic_chain *kc,
+        int *nq,
+        int *nd)
+{
+    assert(kc);
+    assert(nq);
+    assert(nd);
+
+    *nq = 0;
+    *nd = 0;
+    for (int i = 0; i < kc->number_of_segments; i++) {
+        const struct kcc_joint_operators *op = &kcc_joint[kc->segment[i].joint.type];
+        *nq += op->nq;
+        *nd += op->nd;
+    }
+}
+
+
+// The merged chain's segments, the storage of their attachments and their
+// parent indices are one block, hence the segments' address is the one to free
+struct merged_attachment
+{
+    struct matrix3x3 rotation;
+    struct vector3 translation;
+};
+
+
+int kcc_merge_fixed_joints(
+        const struct kcc_kinematic_chain *kc,
+        struct kcc_kinematic_chain *r)
+{
+    assert(kc);
+    assert(r);
+
+    const int NR_SEGMENTS = kc->number_of_segments;
+
+    int nseg = 0;
+    for (int i = 0; i < NR_SEGMENTS; i++) {
+        if (kc->segment[i].joint.type != JOINT_TYPE_FIXED) nseg++;
+    }
+
+    size_t size = nseg * (sizeof(struct kcc_segment) + sizeof(struct merged_attachment) + sizeof(int));
+    struct kcc_segment *segment = malloc(size > 0 ? size : 1);
+
+    // Per original segment: the pose of its link w.r.t. the link of its
+    // nearest moving ancestor-or-self, i.e. the product of the attachments of
+    // the fixed joints in between, and the merged index of that link
+    size_t tmp_size = NR_SEGMENTS * (sizeof(struct merged_attachment) + sizeof(int));
+    struct merged_attachment *acc = malloc(tmp_size > 0 ? tmp_size : 1);
+
+    if (!segment || !acc) {
+        free(segment);
+        free(acc);
+        return -1;
+    }
+
+    struct merged_attachment *attachment = (struct merged_attachment *)&segment[nseg];
+    int *parent = (int *)&attachment[nseg];
+    int *moving = (int *)&acc[NR_SEGMENTS];
+
+    const struct merged_attachment identity = {
+        .rotation = { .row_x = { 1.0, 0.0, 0.0 }, .row_y = { 0.0, 1.0, 0.0 }, .row_z = { 0.0, 0.0, 1.0 } }
+    };
+    struct merged_attachment base = identity;
+
+    int n = 0;
+    for (int i = 0; i < NR_SEGMENTS; i++) {
+        const struct kcc_segment *s = &kc->segment[i];
+        int p = segment_parent(kc->parent, i);
+        int m = p >= 0 ? moving[p] : -1;
+
+        // X_T X_acc: the attachment w.r.t. the moving ancestor's link
+        struct merged_attachment *a = p >= 0 ? &acc[p] : &base;
+        struct gc_pose x_acc = { .rotation = &a->rotation, .translation = &a->translation };
+        struct gc_pose x = { .rotation = &acc[i].rotation, .translation = &acc[i].translation };
+        gc_pose_compose(&s->joint_attachment, &x_acc, &x);
+
+        if (s->joint.type == JOINT_TYPE_FIXED) {
+            // The link moves with the moving ancestor's link. Links that are
+            // fixed to the base do not contribute to the dynamics.
+            moving[i] = m;
+            if (m >= 0) {
+                struct mc_rbi inertia;
+                mc_rbi_tf_tgt_to_ref(&x, &s->link.inertia, &inertia);
+                mc_rbi_add(&segment[m].link.inertia, &inertia, &segment[m].link.inertia);
+            }
+        } else {
+            attachment[n] = acc[i];
+            segment[n] = *s;
+            segment[n].joint_attachment.rotation = &attachment[n].rotation;
+            segment[n].joint_attachment.translation = &attachment[n].translation;
+            parent[n] = m;
+            moving[i] = n;
+            n++;
+
+            acc[i] = identity;
+        }
+    }
+
+    free(acc);
+
+    // The merged segments of a serial chain form a serial chain again
+    r->number_of_segments = nseg;
+    r->segment = segment;
+    r->parent = kc->parent ? parent : NULL;
+    r->verified = kc->verified;
+    kcc_compile(r);
+
+    return 0;
+}
+
+
+void kcc_merged_destroy(
+        struct kcc_kinematic_chain *r)
+{
+    assert(r);
+
+    free(r->segment);
+    r->segment = NULL;
+    r->parent = NULL;
+    r->number_of_segments = 0;
+}
@@ -10,5 +10,9 @@ void kcc_fpk_nbx(
     assert(nbx);
     assert(nbx->joint);
 
-    kcc_joint[nbx->joint->type].fpk(nbx->joint, nbx->q, nbx->x);
+    const struct kcc_joint_operators *op = nbx->joint->operators
+            ? nbx->joint->operators
+            : &kcc_joint[nbx->joint->type];
+
+    op->fpk(nbx->joint, nbx->q, nbx->x);
 }
@@ -1,4 +1,5 @@
 #include <dyn2b/functions/linear_algebra.h>
+#include "linear_algebra_kernels.h"
 
 #include <assert.h>
 
@@ -11,6 +12,11 @@ void la_dscal_o(
 {
     assert(x);
 
+    if (incx == 1 && incy == 1) {
+        la_kernel.dscal(n, alpha, x, y);
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         y[i * incy] = alpha * x[i * incx];
     }
@@ -24,6 +30,11 @@ void la_dscal_i(
 {
     assert(x);
 
+    if (incx == 1) {
+        la_kernel.dscal(n, alpha, x, x);
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         x[i * incx] = alpha * x[i * incx];
     }
@@ -43,10 +54,14 @@ void la_dgeadd_os(
     assert(ldb >= 1 && ldb >= n);
     assert(ldc >= 1 && ldc >= n);
 
+    // Contiguous matrices are added as one vector
+    if (lda == n && ldb == n && ldc == n) {
+        la_kernel.daxpy(m * n, 1.0, a, b, c);
+        return;
+    }
+
     for (int i = 0; i < m; i++) {
-        for (int j = 0; j < n; j++) {
-            c[i * ldc + j] = a[i * lda + j] + b[i * ldb + j];
-        }
+        la_kernel.daxpy(n, 1.0, &a[i * lda], &b[i * ldb], &c[i * ldc]);
     }
 }
 
@@ -61,10 +76,14 @@ void la_dgeadd_is(
     assert(lda >= 1 && lda >= n);
     assert(ldb >= 1 && ldb >= n);
 
+    // Contiguous matrices are added as one vector
+    if (lda == n && ldb == n) {
+        la_kernel.daxpy(m * n, 1.0, a, b, b);
+        return;
+    }
+
     for (int i = 0; i < m; i++) {
-        for (int j = 0; j < n; j++) {
-            b[i * ldb + j] += a[i * lda + j];
-        }
+        la_kernel.daxpy(n, 1.0, &a[i * lda], &b[i * ldb], &b[i * ldb]);
     }
 }
 
@@ -80,6 +99,11 @@ void la_daxpy_oe(
     assert(y);
     assert(z);
 
+    if (incx == 1 && incy == 1 && incz == 1) {
+        la_kernel.daxpy(n, alpha, x, y, z);
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         z[i * incz] = alpha * x[i * incx] + y[i * incy];
     }
@@ -96,6 +120,11 @@ void la_daxpy_ie(
     assert(y);
     assert(x != y);
 
+    if (incx == 1 && incy == 1) {
+        la_kernel.daxpy(n, alpha, x, y, y);
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         y[i * incy] = alpha * x[i * incx] + y[i * incy];
     }
@@ -111,6 +140,11 @@ void la_ddot(
     assert(x);
     assert(y);
 
+    if (incx == 1 && incy == 1) {
+        *alpha = la_kernel.ddot(n, x, y);
+        return;
+    }
+
     *alpha = 0.0;
     for (int i = 0; i < n; i++) {
         *alpha += x[i * incx] * y[i * incy];
@@ -118,6 +152,27 @@ void la_ddot(
 }
 
 
+void la_dsincos(
+        int n,
+        const double *x, int incx,
+        double *s, int incs,
+        double *c, int incc)
+{
+    assert(x);
+    assert(s);
+    assert(c);
+
+    if (incx == 1 && incs == 1 && incc == 1) {
+        la_kernel.dsincos(n, x, s, c);
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        la_sincos(x[i * incx], &s[i * incs], &c[i * incc]);
+    }
+}
+
+
 void la_dcross_o(
         const double *x, int incx,
         const double *y, int incy,
@@ -167,6 +222,14 @@ void la_dgemv_nos(
     assert(incx > 0);
     assert(incy > 0);
 
+    // Dot products of the rows with x
+    if (incx == 1) {
+        for (int i = 0; i < n; i++) {
+            y[i * incy] = la_kernel.ddot(m, &a[i * lda], x);
+        }
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         double yi = 0.0;
         for (int j = 0; j < m; j++) {
@@ -191,6 +254,15 @@ void la_dgemv_tos(
     assert(incx > 0);
     assert(incy > 0);
 
+    // Linear combination of the rows weighted by x
+    if (incy == 1 && m > 0) {
+        la_kernel.dscal(n, x[0], &a[0], y);
+        for (int j = 1; j < m; j++) {
+            la_kernel.daxpy(n, x[j * incx], &a[j * lda], y, y);
+        }
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         double yi = 0.0;
         for (int j = 0; j < m; j++) {
@@ -221,6 +293,14 @@ void la_dgemv_noe(
     assert(incy > 0);
     assert(incz > 0);
 
+    // Dot products of the rows with x
+    if (incx == 1) {
+        for (int i = 0; i < n; i++) {
+            z[i * incz] = beta * y[i * incy] + alpha * la_kernel.ddot(m, &a[i * lda], x);
+        }
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         double zi = beta * y[i * incy];
         for (int j = 0; j < m; j++) {
@@ -251,6 +331,15 @@ void la_dgemv_toe(
     assert(incy > 0);
     assert(incz > 0);
 
+    // Linear combination of the rows weighted by x
+    if (incy == 1 && incz == 1) {
+        la_kernel.dscal(n, beta, y, z);
+        for (int j = 0; j < m; j++) {
+            la_kernel.daxpy(n, alpha * x[j * incx], &a[j * lda], z, z);
+        }
+        return;
+    }
+
     for (int i = 0; i < n; i++) {
         double zi = beta * y[i * incy];
         for (int j = 0; j < m; j++) {
@@ -279,6 +368,18 @@ void la_dgemm_nnos(
     assert(ldb >= 1 && ldb >= n);
     assert(ldc >= 1 && ldc >= n);
 
+    // Rows of C as linear combinations of the rows of B
+    if (k > 0) {
+        for (int i_ = 0; i_ < m; i_++) {
+            double *ci = &c[i_ * ldc];
+            la_kernel.dscal(n, a[i_ * lda], &b[0], ci);
+            for (int k_ = 1; k_ < k; k_++) {
+                la_kernel.daxpy(n, a[i_ * lda + k_], &b[k_ * ldb], ci, ci);
+            }
+        }
+        return;
+    }
+
     for (int i_ = 0; i_ < m; i_++) {
         for (int j_ = 0; j_ < n; j_++) {
             double cij = 0.0;
@@ -309,13 +410,10 @@ void la_dgemm_ntos(
     assert(ldb >= 1 && ldb >= n);
     assert(ldc >= 1 && ldc >= n);
 
+    // Dot products of the rows of A and B
     for (int i_ = 0; i_ < m; i_++) {
         for (int j_ = 0; j_ < n; j_++) {
-            double cij = 0.0;
-            for (int k_ = 0; k_ < k; k_++) {
-                cij += a[i_ * lda + k_] * b[j_ * ldb + k_];
-            }
-            c[i_ * ldc + j_] = cij;
+            c[i_ * ldc + j_] = la_kernel.ddot(k, &a[i_ * lda], &b[j_ * ldb]);
         }
     }
 }
@@ -339,6 +437,18 @@ void la_dgemm_tnos(
     assert(ldb >= 1 && ldb >= n);
     assert(ldc >= 1 && ldc >= n);
 
+    // Rows of C as linear combinations of the rows of B
+    if (k > 0) {
+        for (int i_ = 0; i_ < m; i_++) {
+            double *ci = &c[i_ * ldc];
+            la_kernel.dscal(n, a[i_], &b[0], ci);
+            for (int k_ = 1; k_ < k; k_++) {
+                la_kernel.daxpy(n, a[k_ * lda + i_], &b[k_ * ldb], ci, ci);
+            }
+        }
+        return;
+    }
+
     for (int i_ = 0; i_ < m; i_++) {
         for (int j_ = 0; j_ < n; j_++) {
             double cij = 0.0;
@@ -404,13 +514,12 @@ void la_dgemm_nnoe(
     assert(ldc >= 1 && ldc >= n);
     assert(ldd >= 1 && ldd >= n);
 
+    // Rows of D as linear combinations of the rows of C and B
     for (int i_ = 0; i_ < m; i_++) {
-        for (int j_ = 0; j_ < n; j_++) {
-            double dij = beta * c[i_ * ldc + j_];
-            for (int k_ = 0; k_ < k; k_++) {
-                dij += alpha * a[i_ * lda + k_] * b[k_ * ldb + j_];
-            }
-            d[i_ * ldc + j_] = dij;
+        double *di = &d[i_ * ldd];
+        la_kernel.dscal(n, beta, &c[i_ * ldc], di);
+        for (int k_ = 0; k_ < k; k_++) {
+            la_kernel.daxpy(n, alpha * a[i_ * lda + k_], &b[k_ * ldb], di, di);
         }
     }
 }
@@ -439,13 +548,12 @@ void la_dgemm_tnoe(
     assert(ldc >= 1 && ldc >= n);
     assert(ldd >= 1 && ldd >= n);
 
+    // Rows of D as linear combinations of the rows of C and B
     for (int i_ = 0; i_ < m; i_++) {
-        for (int j_ = 0; j_ < n; j_++) {
-            double dij = beta * c[i_ * ldc + j_];
-            for (int k_ = 0; k_ < k; k_++) {
-                dij += alpha * a[k_ * lda + i_] * b[k_ * ldb + j_];
-            }
-            d[i_ * ldc + j_] = dij;
+        double *di = &d[i_ * ldd];
+        la_kernel.dscal(n, beta, &c[i_ * ldc], di);
+        for (int k_ = 0; k_ < k; k_++) {
+            la_kernel.daxpy(n, alpha * a[k_ * lda + i_], &b[k_ * ldb], di, di);
         }
     }
 }
@@ -474,13 +582,376 @@ void la_dgemm_ntoe(
     assert(ldc >= 1 && ldc >= n);
     assert(ldd >= 1 && ldd >= n);
 
+    // Dot products of the rows of A and B
     for (int i_ = 0; i_ < m; i_++) {
         for (int j_ = 0; j_ < n; j_++) {
-            double dij = beta * c[i_ * ldc + j_];
-            for (int k_ = 0; k_ < k; k_++) {
-                dij += alpha * a[i_ * lda + k_] * b[j_ * ldb + k_];
+            d[i_ * ldd + j_] = beta * c[i_ * ldc + j_]
+                    + alpha * la_kernel.ddot(k, &a[i_ * lda], &b[j_ * ldb]);
+        }
+    }
+}
+
+
+void la_d33gemv_nos(
+        const double *a,
+        const double *x,
+        double *y)
+{
+    assert(a);
+    assert(x);
+    assert(y);
+
+    double r[3];
+    for (int i = 0; i < 3; i++) {
+        r[i] = a[i * 3 + 0] * x[0] + a[i * 3 + 1] * x[1] + a[i * 3 + 2] * x[2];
+    }
+
+    for (int i = 0; i < 3; i++) y[i] = r[i];
+}
+
+
+void la_d33gemv_tos(
+        const double *a,
+        const double *x,
+        double *y)
+{
+    assert(a);
+    assert(x);
+    assert(y);
+
+    double r[3];
+    for (int i = 0; i < 3; i++) {
+        r[i] = a[0 * 3 + i] * x[0] + a[1 * 3 + i] * x[1] + a[2 * 3 + i] * x[2];
+    }
+
+    for (int i = 0; i < 3; i++) y[i] = r[i];
+}
+
+
+void la_d33gemv_noe(
+        double alpha,
+        const double *a,
+        const double *x,
+        double beta,
+        const double *y,
+        double *z)
+{
+    assert(a);
+    assert(x);
+    assert(y);
+    assert(z);
+
+    double r[3];
+    for (int i = 0; i < 3; i++) {
+        r[i] = alpha * (a[i * 3 + 0] * x[0] + a[i * 3 + 1] * x[1] + a[i * 3 + 2] * x[2])
+                + beta * y[i];
+    }
+
+    for (int i = 0; i < 3; i++) z[i] = r[i];
+}
+
+
+void la_d33gemv_toe(
+        double alpha,
+        const double *a,
+        const double *x,
+        double beta,
+        const double *y,
+        double *z)
+{
+    assert(a);
+    assert(x);
+    assert(y);
+    assert(z);
+
+    double r[3];
+    for (int i = 0; i < 3; i++) {
+        r[i] = alpha * (a[0 * 3 + i] * x[0] + a[1 * 3 + i] * x[1] + a[2 * 3 + i] * x[2])
+                + beta * y[i];
+    }
+
+    for (int i = 0; i < 3; i++) z[i] = r[i];
+}
+
+
+void la_d33gemm_nnos(
+        const double *a,
+        const double *b,
+        double *c)
+{
+    assert(a);
+    assert(b);
+    assert(c);
+
+    double r[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i * 3 + j] = a[i * 3 + 0] * b[0 * 3 + j]
+                         + a[i * 3 + 1] * b[1 * 3 + j]
+                         + a[i * 3 + 2] * b[2 * 3 + j];
+        }
+    }
+
+    for (int i = 0; i < 9; i++) c[i] = r[i];
+}
+
+
+void la_d33gemm_tnos(
+        const double *a,
+        const double *b,
+        double *c)
+{
+    assert(a);
+    assert(b);
+    assert(c);
+
+    double r[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i * 3 + j] = a[0 * 3 + i] * b[0 * 3 + j]
+                         + a[1 * 3 + i] * b[1 * 3 + j]
+                         + a[2 * 3 + i] * b[2 * 3 + j];
+        }
+    }
+
+    for (int i = 0; i < 9; i++) c[i] = r[i];
+}
+
+
+void la_d33gemm_nnoe(
+        double alpha,
+        const double *a,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d)
+{
+    assert(a);
+    assert(b);
+    assert(c);
+    assert(d);
+
+    double r[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i * 3 + j] = alpha * (a[i * 3 + 0] * b[0 * 3 + j]
+                                  + a[i * 3 + 1] * b[1 * 3 + j]
+                                  + a[i * 3 + 2] * b[2 * 3 + j])
+                         + beta * c[i * 3 + j];
+        }
+    }
+
+    for (int i = 0; i < 9; i++) d[i] = r[i];
+}
+
+
+void la_d33gemm_ntoe(
+        double alpha,
+        const double *a,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d)
+{
+    assert(a);
+    assert(b);
+    assert(c);
+    assert(d);
+
+    double r[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i * 3 + j] = alpha * (a[i * 3 + 0] * b[j * 3 + 0]
+                                  + a[i * 3 + 1] * b[j * 3 + 1]
+                                  + a[i * 3 + 2] * b[j * 3 + 2])
+                         + beta * c[i * 3 + j];
+        }
+    }
+
+    for (int i = 0; i < 9; i++) d[i] = r[i];
+}
+
+
+void la_d33gecongr_tos(
+        const double *e,
+        const double *a,
+        double *c)
+{
+    assert(e);
+    assert(a);
+    assert(c);
+
+    // A E
+    double ae[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ae[i * 3 + j] = a[i * 3 + 0] * e[0 * 3 + j]
+                          + a[i * 3 + 1] * e[1 * 3 + j]
+                          + a[i * 3 + 2] * e[2 * 3 + j];
+        }
+    }
+
+    // E^T (A E)
+    double r[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r[i * 3 + j] = e[0 * 3 + i] * ae[0 * 3 + j]
+                         + e[1 * 3 + i] * ae[1 * 3 + j]
+                         + e[2 * 3 + i] * ae[2 * 3 + j];
+        }
+    }
+
+    for (int i = 0; i < 9; i++) c[i] = r[i];
+}
+
+
+void la_d33crossgemm_noe(
+        double alpha,
+        const double *x,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d)
+{
+    assert(x);
+    assert(b);
+    assert(c);
+    assert(d);
+
+    // The columns of [x]_x B are x x b_j
+    double r[9];
+    for (int j = 0; j < 3; j++) {
+        r[0 * 3 + j] = alpha * (x[1] * b[2 * 3 + j] - x[2] * b[1 * 3 + j]) + beta * c[0 * 3 + j];
+        r[1 * 3 + j] = alpha * (x[2] * b[0 * 3 + j] - x[0] * b[2 * 3 + j]) + beta * c[1 * 3 + j];
+        r[2 * 3 + j] = alpha * (x[0] * b[1 * 3 + j] - x[1] * b[0 * 3 + j]) + beta * c[2 * 3 + j];
+    }
+
+    for (int i = 0; i < 9; i++) d[i] = r[i];
+}
+
+
+void la_d33crossgemm_toe(
+        double alpha,
+        const double *x,
+        const double *b,
+        double beta,
+        const double *c,
+        double *d)
+{
+    assert(x);
+    assert(b);
+    assert(c);
+    assert(d);
+
+    // The columns of [x]_x B^T are x x b_j, with b_j being the rows of B
+    double r[9];
+    for (int j = 0; j < 3; j++) {
+        r[0 * 3 + j] = alpha * (x[1] * b[j * 3 + 2] - x[2] * b[j * 3 + 1]) + beta * c[0 * 3 + j];
+        r[1 * 3 + j] = alpha * (x[2] * b[j * 3 + 0] - x[0] * b[j * 3 + 2]) + beta * c[1 * 3 + j];
+        r[2 * 3 + j] = alpha * (x[0] * b[j * 3 + 1] - x[1] * b[j * 3 + 0]) + beta * c[2 * 3 + j];
+    }
+
+    for (int i = 0; i < 9; i++) d[i] = r[i];
+}
+
+
+void la_d33gemmcross_noe(
+        double alpha,
+        const double *a,
+        const double *x,
+        double beta,
+        const double *c,
+        double *d)
+{
+    assert(a);
+    assert(x);
+    assert(c);
+    assert(d);
+
+    // The rows of A [x]_x are a_i x x, with a_i being the rows of A
+    double r[9];
+    for (int i = 0; i < 3; i++) {
+        r[i * 3 + 0] = alpha * (a[i * 3 + 1] * x[2] - a[i * 3 + 2] * x[1]) + beta * c[i * 3 + 0];
+        r[i * 3 + 1] = alpha * (a[i * 3 + 2] * x[0] - a[i * 3 + 0] * x[2]) + beta * c[i * 3 + 1];
+        r[i * 3 + 2] = alpha * (a[i * 3 + 0] * x[1] - a[i * 3 + 1] * x[0]) + beta * c[i * 3 + 2];
+    }
+
+    for (int i = 0; i < 9; i++) d[i] = r[i];
+}
+
+
+void la_dsytrf_los(
+        int n,
+        const double *a, int lda,
+        double *b, int ldb)
+{
+    assert(a);
+    assert(b);
+    assert(lda >= 1 && lda >= n);
+    assert(ldb >= 1 && ldb >= n);
+
+    // Column by column with v_k = l_jk d_k: d_j = a_jj - sum_k l_jk v_k and
+    // l_ij = (a_ij - sum_k l_ik v_k) / d_j for i > j
+    double v[n > 0 ? n : 1];
+    for (int j = 0; j < n; j++) {
+        double d = a[j * lda + j];
+        for (int k = 0; k < j; k++) {
+            v[k] = b[j * ldb + k] * b[k * ldb + k];
+            d -= b[j * ldb + k] * v[k];
+        }
+        assert(d != 0.0);
+        b[j * ldb + j] = d;
+
+        double d_inv = 1.0 / d;
+        for (int i = j + 1; i < n; i++) {
+            double l = a[i * lda + j];
+            for (int k = 0; k < j; k++) {
+                l -= b[i * ldb + k] * v[k];
             }
-            d[i_ * ldc + j_] = dij;
+            b[i * ldb + j] = l * d_inv;
+        }
+    }
+}
+
+
+void la_trsv_lnd(
+        int n,
+        const double *a, int lda,
+        const double *b, int incb,
+        double *x, int incx)
+{
+    assert(a);
+    assert(b);
+    assert(x);
+    assert(lda >= 1 && lda >= n);
+
+    for (int i = 0; i < n; i++) {
+        double xi = b[i * incb];
+        for (int j = 0; j < i; j++) {
+            xi -= a[i * lda + j] * x[j * incx];
+        }
+        x[i * incx] = xi;
+    }
+}
+
+
+void la_trsv_ltd(
+        int n,
+        const double *a, int lda,
+        const double *b, int incb,
+        double *x, int incx)
+{
+    assert(a);
+    assert(b);
+    assert(x);
+    assert(lda >= 1 && lda >= n);
+
+    // The rows of A^T are the columns of A
+    for (int i = n - 1; i >= 0; i--) {
+        double xi = b[i * incb];
+        for (int j = i + 1; j < n; j++) {
+            xi -= a[j * lda + i] * x[j * incx];
         }
+        x[i * incx] = xi;
     }
 }
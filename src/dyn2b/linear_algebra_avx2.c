@@ -0,0 +1,141 @@
+#include "linear_algebra_kernels.h"
+
+#include <immintrin.h>
+
+
+static void daxpy_avx2(
+        int n,
+        double alpha,
+        const double *x,
+        const double *y,
+        double *z)
+{
+    __m256d a = _mm256_set1_pd(alpha);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d xi = _mm256_loadu_pd(&x[i]);
+        __m256d yi = _mm256_loadu_pd(&y[i]);
+        _mm256_storeu_pd(&z[i], _mm256_fmadd_pd(a, xi, yi));
+    }
+    for (; i < n; i++) {
+        z[i] = alpha * x[i] + y[i];
+    }
+}
+
+
+static void dscal_avx2(
+        int n,
+        double alpha,
+        const double *x,
+        double *y)
+{
+    __m256d a = _mm256_set1_pd(alpha);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(&y[i], _mm256_mul_pd(a, _mm256_loadu_pd(&x[i])));
+    }
+    for (; i < n; i++) {
+        y[i] = alpha * x[i];
+    }
+}
+
+
+static double ddot_avx2(
+        int n,
+        const double *x,
+        const double *y)
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(&x[i]), _mm256_loadu_pd(&y[i]), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(&x[i + 4]), _mm256_loadu_pd(&y[i + 4]), s1);
+    }
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(&x[i]), _mm256_loadu_pd(&y[i]), s0);
+    }
+
+    __m256d s = _mm256_add_pd(s0, s1);
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(s), _mm256_extractf128_pd(s, 1));
+    double r = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+
+    for (; i < n; i++) {
+        r += x[i] * y[i];
+    }
+
+    return r;
+}
+
+
+static void dsincos_avx2(
+        int n,
+        const double *x,
+        double *s,
+        double *c)
+{
+    const __m256d abs = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    const __m256d limit = _mm256_set1_pd(LA_SINCOS_LIMIT);
+    const __m256d round = _mm256_set1_pd(LA_SINCOS_ROUND);
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d xi = _mm256_loadu_pd(&x[i]);
+
+        // Large or non-finite arguments
+        __m256d in = _mm256_cmp_pd(_mm256_and_pd(xi, abs), limit, _CMP_LE_OQ);
+        if (_mm256_movemask_pd(in) != 0xf) {
+            for (int k = i; k < i + 4; k++) la_sincos(x[k], &s[k], &c[k]);
+            continue;
+        }
+
+        __m256d t = _mm256_fmadd_pd(xi, _mm256_set1_pd(LA_SINCOS_2_PI), round);
+        __m256d j = _mm256_sub_pd(t, round);
+        __m256d r = _mm256_fnmadd_pd(j, _mm256_set1_pd(LA_SINCOS_PIO2_1), xi);
+        r = _mm256_fnmadd_pd(j, _mm256_set1_pd(LA_SINCOS_PIO2_2), r);
+        r = _mm256_fnmadd_pd(j, _mm256_set1_pd(LA_SINCOS_PIO2_3), r);
+        __m256d z = _mm256_mul_pd(r, r);
+
+        __m256d ps = _mm256_fmadd_pd(z, _mm256_set1_pd(LA_SINCOS_S6), _mm256_set1_pd(LA_SINCOS_S5));
+        ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(LA_SINCOS_S4));
+        ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(LA_SINCOS_S3));
+        ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(LA_SINCOS_S2));
+        ps = _mm256_fmadd_pd(z, ps, _mm256_set1_pd(LA_SINCOS_S1));
+        ps = _mm256_fmadd_pd(_mm256_mul_pd(r, z), ps, r);
+
+        __m256d pc = _mm256_fmadd_pd(z, _mm256_set1_pd(LA_SINCOS_C6), _mm256_set1_pd(LA_SINCOS_C5));
+        pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(LA_SINCOS_C4));
+        pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(LA_SINCOS_C3));
+        pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(LA_SINCOS_C2));
+        pc = _mm256_fmadd_pd(z, pc, _mm256_set1_pd(LA_SINCOS_C1));
+        pc = _mm256_fmadd_pd(_mm256_mul_pd(z, z), pc,
+                _mm256_fnmadd_pd(_mm256_set1_pd(0.5), z, _mm256_set1_pd(1.0)));
+
+        // The quadrant j mod 4 is in the low bits of t: odd quadrants swap
+        // sine and cosine, the sine changes sign in quadrants 2 and 3, the
+        // cosine in 1 and 2
+        __m256i q = _mm256_castpd_si256(t);
+        __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, one), one));
+        __m256d sign_s = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_srli_epi64(q, 1), 63));
+        __m256d sign_c = _mm256_castsi256_pd(
+                _mm256_slli_epi64(_mm256_srli_epi64(_mm256_add_epi64(q, one), 1), 63));
+
+        _mm256_storeu_pd(&s[i], _mm256_xor_pd(_mm256_blendv_pd(ps, pc, swap), sign_s));
+        _mm256_storeu_pd(&c[i], _mm256_xor_pd(_mm256_blendv_pd(pc, ps, swap), sign_c));
+    }
+    for (; i < n; i++) {
+        la_sincos(x[i], &s[i], &c[i]);
+    }
+}
+
+
+const struct la_kernels la_kernels_avx2 = {
+    .daxpy = daxpy_avx2,
+    .dscal = dscal_avx2,
+    .ddot = ddot_avx2,
+    .dsincos = dsincos_avx2
+};
@@ -0,0 +1,144 @@
+#include "linear_algebra_kernels.h"
+
+#include <immintrin.h>
+
+
+static __mmask8 tail_mask(int n)
+{
+    return (__mmask8)((1u << n) - 1u);
+}
+
+
+static void daxpy_avx512(
+        int n,
+        double alpha,
+        const double *x,
+        const double *y,
+        double *z)
+{
+    __m512d a = _mm512_set1_pd(alpha);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d xi = _mm512_loadu_pd(&x[i]);
+        __m512d yi = _mm512_loadu_pd(&y[i]);
+        _mm512_storeu_pd(&z[i], _mm512_fmadd_pd(a, xi, yi));
+    }
+    if (i < n) {
+        __mmask8 m = tail_mask(n - i);
+        __m512d xi = _mm512_maskz_loadu_pd(m, &x[i]);
+        __m512d yi = _mm512_maskz_loadu_pd(m, &y[i]);
+        _mm512_mask_storeu_pd(&z[i], m, _mm512_fmadd_pd(a, xi, yi));
+    }
+}
+
+
+static void dscal_avx512(
+        int n,
+        double alpha,
+        const double *x,
+        double *y)
+{
+    __m512d a = _mm512_set1_pd(alpha);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(&y[i], _mm512_mul_pd(a, _mm512_loadu_pd(&x[i])));
+    }
+    if (i < n) {
+        __mmask8 m = tail_mask(n - i);
+        _mm512_mask_storeu_pd(&y[i], m, _mm512_mul_pd(a, _mm512_maskz_loadu_pd(m, &x[i])));
+    }
+}
+
+
+static double ddot_avx512(
+        int n,
+        const double *x,
+        const double *y)
+{
+    __m512d s0 = _mm512_setzero_pd();
+    __m512d s1 = _mm512_setzero_pd();
+
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i]), _mm512_loadu_pd(&y[i]), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i + 8]), _mm512_loadu_pd(&y[i + 8]), s1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(&x[i]), _mm512_loadu_pd(&y[i]), s0);
+    }
+    if (i < n) {
+        __mmask8 m = tail_mask(n - i);
+        s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, &x[i]), _mm512_maskz_loadu_pd(m, &y[i]), s1);
+    }
+
+    return _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+}
+
+
+static void dsincos_avx512(
+        int n,
+        const double *x,
+        double *s,
+        double *c)
+{
+    const __m512d limit = _mm512_set1_pd(LA_SINCOS_LIMIT);
+    const __m512d round = _mm512_set1_pd(LA_SINCOS_ROUND);
+    const __m512i one = _mm512_set1_epi64(1);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d xi = _mm512_loadu_pd(&x[i]);
+
+        // Large or non-finite arguments
+        if (_mm512_cmp_pd_mask(_mm512_abs_pd(xi), limit, _CMP_LE_OQ) != 0xff) {
+            for (int k = i; k < i + 8; k++) la_sincos(x[k], &s[k], &c[k]);
+            continue;
+        }
+
+        __m512d t = _mm512_fmadd_pd(xi, _mm512_set1_pd(LA_SINCOS_2_PI), round);
+        __m512d j = _mm512_sub_pd(t, round);
+        __m512d r = _mm512_fnmadd_pd(j, _mm512_set1_pd(LA_SINCOS_PIO2_1), xi);
+        r = _mm512_fnmadd_pd(j, _mm512_set1_pd(LA_SINCOS_PIO2_2), r);
+        r = _mm512_fnmadd_pd(j, _mm512_set1_pd(LA_SINCOS_PIO2_3), r);
+        __m512d z = _mm512_mul_pd(r, r);
+
+        __m512d ps = _mm512_fmadd_pd(z, _mm512_set1_pd(LA_SINCOS_S6), _mm512_set1_pd(LA_SINCOS_S5));
+        ps = _mm512_fmadd_pd(z, ps, _mm512_set1_pd(LA_SINCOS_S4));
+        ps = _mm512_fmadd_pd(z, ps, _mm512_set1_pd(LA_SINCOS_S3));
+        ps = _mm512_fmadd_pd(z, ps, _mm512_set1_pd(LA_SINCOS_S2));
+        ps = _mm512_fmadd_pd(z, ps, _mm512_set1_pd(LA_SINCOS_S1));
+        ps = _mm512_fmadd_pd(_mm512_mul_pd(r, z), ps, r);
+
+        __m512d pc = _mm512_fmadd_pd(z, _mm512_set1_pd(LA_SINCOS_C6), _mm512_set1_pd(LA_SINCOS_C5));
+        pc = _mm512_fmadd_pd(z, pc, _mm512_set1_pd(LA_SINCOS_C4));
+        pc = _mm512_fmadd_pd(z, pc, _mm512_set1_pd(LA_SINCOS_C3));
+        pc = _mm512_fmadd_pd(z, pc, _mm512_set1_pd(LA_SINCOS_C2));
+        pc = _mm512_fmadd_pd(z, pc, _mm512_set1_pd(LA_SINCOS_C1));
+        pc = _mm512_fmadd_pd(_mm512_mul_pd(z, z), pc,
+                _mm512_fnmadd_pd(_mm512_set1_pd(0.5), z, _mm512_set1_pd(1.0)));
+
+        // The quadrant j mod 4 is in the low bits of t, see dsincos_avx2()
+        __m512i q = _mm512_castpd_si512(t);
+        __mmask8 swap = _mm512_test_epi64_mask(q, one);
+        __m512i sign_s = _mm512_slli_epi64(_mm512_srli_epi64(q, 1), 63);
+        __m512i sign_c = _mm512_slli_epi64(_mm512_srli_epi64(_mm512_add_epi64(q, one), 1), 63);
+
+        __m512i si = _mm512_castpd_si512(_mm512_mask_blend_pd(swap, ps, pc));
+        __m512i ci = _mm512_castpd_si512(_mm512_mask_blend_pd(swap, pc, ps));
+        _mm512_storeu_pd(&s[i], _mm512_castsi512_pd(_mm512_xor_si512(si, sign_s)));
+        _mm512_storeu_pd(&c[i], _mm512_castsi512_pd(_mm512_xor_si512(ci, sign_c)));
+    }
+    for (; i < n; i++) {
+        la_sincos(x[i], &s[i], &c[i]);
+    }
+}
+
+
+const struct la_kernels la_kernels_avx512 = {
+    .daxpy = daxpy_avx512,
+    .dscal = dscal_avx512,
+    .ddot = ddot_avx512,
+    .dsincos = dsincos_avx512
+};
@@ -0,0 +1,129 @@
+#include "linear_algebra_kernels.h"
+
+#include <stddef.h>
+
+
+static void daxpy_scalar(
+        int n,
+        double alpha,
+        const double *x,
+        const double *y,
+        double *z)
+{
+    for (int i = 0; i < n; i++) {
+        z[i] = alpha * x[i] + y[i];
+    }
+}
+
+
+static void dscal_scalar(
+        int n,
+        double alpha,
+        const double *x,
+        double *y)
+{
+    for (int i = 0; i < n; i++) {
+        y[i] = alpha * x[i];
+    }
+}
+
+
+static double ddot_scalar(
+        int n,
+        const double *x,
+        const double *y)
+{
+    double r = 0.0;
+    for (int i = 0; i < n; i++) {
+        r += x[i] * y[i];
+    }
+
+    return r;
+}
+
+
+static void dsincos_scalar(
+        int n,
+        const double *x,
+        double *s,
+        double *c)
+{
+    for (int i = 0; i < n; i++) {
+        la_sincos(x[i], &s[i], &c[i]);
+    }
+}
+
+
+const struct la_kernels la_kernels_scalar = {
+    .daxpy = daxpy_scalar,
+    .dscal = dscal_scalar,
+    .ddot = ddot_scalar,
+    .dsincos = dsincos_scalar
+};
+
+
+// The scalar kernels are in place before any constructor has run
+struct la_kernels la_kernel = {
+    .daxpy = daxpy_scalar,
+    .dscal = dscal_scalar,
+    .ddot = ddot_scalar,
+    .dsincos = dsincos_scalar
+};
+
+static enum la_isa la_isa = LA_ISA_SCALAR;
+
+
+static const struct la_kernels *la_isa_kernels(
+        enum la_isa isa)
+{
+    switch (isa) {
+        case LA_ISA_SCALAR:
+            return &la_kernels_scalar;
+#ifdef DYN2B_SIMD_X86
+        case LA_ISA_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2") ? &la_kernels_sse2 : NULL;
+        case LA_ISA_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+                    ? &la_kernels_avx2 : NULL;
+        case LA_ISA_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f") ? &la_kernels_avx512 : NULL;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+
+enum la_isa la_get_isa(void)
+{
+    return la_isa;
+}
+
+
+int la_set_isa(
+        enum la_isa isa)
+{
+    const struct la_kernels *kernels = la_isa_kernels(isa);
+    if (!kernels) return -1;
+
+    la_kernel = *kernels;
+    la_isa = isa;
+
+    return 0;
+}
+
+
+#ifdef DYN2B_SIMD_X86
+__attribute__((constructor))
+static void la_select_isa(void)
+{
+    enum la_isa isa[] = { LA_ISA_AVX512, LA_ISA_AVX2, LA_ISA_SSE2 };
+
+    for (size_t i = 0; i < sizeof(isa) / sizeof(isa[0]); i++) {
+        if (la_set_isa(isa[i]) == 0) return;
+    }
+}
+#endif
@@ -0,0 +1,103 @@
+#ifndef DYN2B_LINEAR_ALGEBRA_KERNELS_H
+#define DYN2B_LINEAR_ALGEBRA_KERNELS_H
+
+#include <dyn2b/functions/linear_algebra.h>
+
+#include <math.h>
+
+/**
+ * Internal vector kernels behind the linear algebra operations.
+ *
+ * The kernels only operate on contiguous vectors (unit increments) and are
+ * implemented once per instruction set. The operations in linear_algebra.c
+ * decompose their unit-stride cases into calls to the kernels of the active
+ * instruction set and keep their scalar loops for all other cases.
+ *
+ * z may alias x or y, y may alias x.
+ */
+struct la_kernels
+{
+    // z = alpha * x + y
+    void (*daxpy)(int n, double alpha, const double *x, const double *y, double *z);
+    // y = alpha * x
+    void (*dscal)(int n, double alpha, const double *x, double *y);
+    // x^T y
+    double (*ddot)(int n, const double *x, const double *y);
+    // s = sin(x), c = cos(x)
+    void (*dsincos)(int n, const double *x, double *s, double *c);
+};
+
+/**
+ * Kernels of the active instruction set.
+ */
+extern struct la_kernels la_kernel;
+
+extern const struct la_kernels la_kernels_scalar;
+extern const struct la_kernels la_kernels_sse2;
+extern const struct la_kernels la_kernels_avx2;
+extern const struct la_kernels la_kernels_avx512;
+
+
+/**
+ * Sine and cosine by reduction to [-pi/4, pi/4] and the minimax polynomials of
+ * fdlibm's __kernel_sin() and __kernel_cos(). x = j pi/2 + r, where pi/2 is
+ * split into three parts of which the first two have 33 significant bits, so
+ * that j pi/2 is exact up to the third part for |x| <= LA_SINCOS_LIMIT.
+ * Larger and non-finite arguments are evaluated by libm.
+ */
+#define LA_SINCOS_LIMIT 1.0e5
+
+#define LA_SINCOS_2_PI   6.36619772367581382433e-01
+#define LA_SINCOS_PIO2_1 1.57079632673412561417e+00
+#define LA_SINCOS_PIO2_2 6.07710050630396597660e-11
+#define LA_SINCOS_PIO2_3 2.02226624871116645580e-21
+
+// 1.5 * 2^52: adding it rounds to an integer in the low bits of the mantissa
+#define LA_SINCOS_ROUND  6755399441055744.0
+
+#define LA_SINCOS_S1 -1.66666666666666324348e-01
+#define LA_SINCOS_S2  8.33333333332248946124e-03
+#define LA_SINCOS_S3 -1.98412698298579493134e-04
+#define LA_SINCOS_S4  2.75573137070700676789e-06
+#define LA_SINCOS_S5 -2.50507602534068634195e-08
+#define LA_SINCOS_S6  1.58969099521155010221e-10
+
+#define LA_SINCOS_C1  4.16666666666666019037e-02
+#define LA_SINCOS_C2 -1.38888888888741095749e-03
+#define LA_SINCOS_C3  2.48015872894767294178e-05
+#define LA_SINCOS_C4 -2.75573143513906633035e-07
+#define LA_SINCOS_C5  2.08757232129817482790e-09
+#define LA_SINCOS_C6 -1.13596475577881948265e-11
+
+
+// The scalar reference of the vector kernels, which also handles their tails
+static inline void la_sincos(
+        double x,
+        double *s,
+        double *c)
+{
+    if (!(fabs(x) <= LA_SINCOS_LIMIT)) {
+        *s = sin(x);
+        *c = cos(x);
+        return;
+    }
+
+    double j = (x * LA_SINCOS_2_PI + LA_SINCOS_ROUND) - LA_SINCOS_ROUND;
+    double r = ((x - j * LA_SINCOS_PIO2_1) - j * LA_SINCOS_PIO2_2) - j * LA_SINCOS_PIO2_3;
+    double z = r * r;
+
+    double ps = r + r * z * (LA_SINCOS_S1 + z * (LA_SINCOS_S2 + z * (LA_SINCOS_S3
+            + z * (LA_SINCOS_S4 + z * (LA_SINCOS_S5 + z * LA_SINCOS_S6)))));
+    double pc = 1.0 - 0.5 * z + z * z * (LA_SINCOS_C1 + z * (LA_SINCOS_C2 + z * (LA_SINCOS_C3
+            + z * (LA_SINCOS_C4 + z * (LA_SINCOS_C5 + z * LA_SINCOS_C6)))));
+
+    // sin(x) and cos(x) in the quadrant j mod 4
+    switch ((long long)j & 3) {
+        case 0: *s =  ps; *c =  pc; break;
+        case 1: *s =  pc; *c = -ps; break;
+        case 2: *s = -ps; *c = -pc; break;
+        default: *s = -pc; *c =  ps; break;
+    }
+}
+
+#endif
@@ -0,0 +1,147 @@
+#include "linear_algebra_kernels.h"
+
+#include <emmintrin.h>
+
+
+static void daxpy_sse2(
+        int n,
+        double alpha,
+        const double *x,
+        const double *y,
+        double *z)
+{
+    __m128d a = _mm_set1_pd(alpha);
+
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d xi = _mm_loadu_pd(&x[i]);
+        __m128d yi = _mm_loadu_pd(&y[i]);
+        _mm_storeu_pd(&z[i], _mm_add_pd(_mm_mul_pd(a, xi), yi));
+    }
+    for (; i < n; i++) {
+        z[i] = alpha * x[i] + y[i];
+    }
+}
+
+
+static void dscal_sse2(
+        int n,
+        double alpha,
+        const double *x,
+        double *y)
+{
+    __m128d a = _mm_set1_pd(alpha);
+
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(&y[i], _mm_mul_pd(a, _mm_loadu_pd(&x[i])));
+    }
+    for (; i < n; i++) {
+        y[i] = alpha * x[i];
+    }
+}
+
+
+static double ddot_sse2(
+        int n,
+        const double *x,
+        const double *y)
+{
+    __m128d s0 = _mm_setzero_pd();
+    __m128d s1 = _mm_setzero_pd();
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(&x[i]), _mm_loadu_pd(&y[i])));
+        s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(&x[i + 2]), _mm_loadu_pd(&y[i + 2])));
+    }
+    for (; i + 2 <= n; i += 2) {
+        s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(&x[i]), _mm_loadu_pd(&y[i])));
+    }
+
+    double s[2];
+    _mm_storeu_pd(s, _mm_add_pd(s0, s1));
+
+    double r = s[0] + s[1];
+    for (; i < n; i++) {
+        r += x[i] * y[i];
+    }
+
+    return r;
+}
+
+
+// p(z) = a[0] + z (a[1] + z (... + z a[5]))
+static inline __m128d horner6_sse2(
+        __m128d z,
+        double a0, double a1, double a2, double a3, double a4, double a5)
+{
+    __m128d p = _mm_add_pd(_mm_mul_pd(z, _mm_set1_pd(a5)), _mm_set1_pd(a4));
+    p = _mm_add_pd(_mm_mul_pd(z, p), _mm_set1_pd(a3));
+    p = _mm_add_pd(_mm_mul_pd(z, p), _mm_set1_pd(a2));
+    p = _mm_add_pd(_mm_mul_pd(z, p), _mm_set1_pd(a1));
+    return _mm_add_pd(_mm_mul_pd(z, p), _mm_set1_pd(a0));
+}
+
+
+static void dsincos_sse2(
+        int n,
+        const double *x,
+        double *s,
+        double *c)
+{
+    const __m128d abs = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d limit = _mm_set1_pd(LA_SINCOS_LIMIT);
+    const __m128d round = _mm_set1_pd(LA_SINCOS_ROUND);
+    const __m128i one = _mm_set1_epi64x(1);
+
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d xi = _mm_loadu_pd(&x[i]);
+
+        // Large or non-finite arguments
+        if (_mm_movemask_pd(_mm_cmple_pd(_mm_and_pd(xi, abs), limit)) != 0x3) {
+            for (int k = i; k < i + 2; k++) la_sincos(x[k], &s[k], &c[k]);
+            continue;
+        }
+
+        __m128d t = _mm_add_pd(_mm_mul_pd(xi, _mm_set1_pd(LA_SINCOS_2_PI)), round);
+        __m128d j = _mm_sub_pd(t, round);
+        __m128d r = _mm_sub_pd(xi, _mm_mul_pd(j, _mm_set1_pd(LA_SINCOS_PIO2_1)));
+        r = _mm_sub_pd(r, _mm_mul_pd(j, _mm_set1_pd(LA_SINCOS_PIO2_2)));
+        r = _mm_sub_pd(r, _mm_mul_pd(j, _mm_set1_pd(LA_SINCOS_PIO2_3)));
+        __m128d z = _mm_mul_pd(r, r);
+
+        __m128d ps = horner6_sse2(z, LA_SINCOS_S1, LA_SINCOS_S2, LA_SINCOS_S3,
+                LA_SINCOS_S4, LA_SINCOS_S5, LA_SINCOS_S6);
+        ps = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, z), ps));
+
+        __m128d pc = horner6_sse2(z, LA_SINCOS_C1, LA_SINCOS_C2, LA_SINCOS_C3,
+                LA_SINCOS_C4, LA_SINCOS_C5, LA_SINCOS_C6);
+        pc = _mm_add_pd(_mm_sub_pd(_mm_set1_pd(1.0), _mm_mul_pd(_mm_set1_pd(0.5), z)),
+                _mm_mul_pd(_mm_mul_pd(z, z), pc));
+
+        // The quadrant j mod 4 is in the low bits of t, see dsincos_avx2()
+        __m128i q = _mm_castpd_si128(t);
+        __m128d swap = _mm_castsi128_pd(_mm_sub_epi64(_mm_setzero_si128(), _mm_and_si128(q, one)));
+        __m128d sign_s = _mm_castsi128_pd(_mm_slli_epi64(_mm_srli_epi64(q, 1), 63));
+        __m128d sign_c = _mm_castsi128_pd(
+                _mm_slli_epi64(_mm_srli_epi64(_mm_add_epi64(q, one), 1), 63));
+
+        __m128d si = _mm_or_pd(_mm_and_pd(swap, pc), _mm_andnot_pd(swap, ps));
+        __m128d ci = _mm_or_pd(_mm_and_pd(swap, ps), _mm_andnot_pd(swap, pc));
+        _mm_storeu_pd(&s[i], _mm_xor_pd(si, sign_s));
+        _mm_storeu_pd(&c[i], _mm_xor_pd(ci, sign_c));
+    }
+    for (; i < n; i++) {
+        la_sincos(x[i], &s[i], &c[i]);
+    }
+}
+
+
+const struct la_kernels la_kernels_sse2 = {
+    .daxpy = daxpy_sse2,
+    .dscal = dscal_sse2,
+    .ddot = ddot_sse2,
+    .dsincos = dsincos_sse2
+};
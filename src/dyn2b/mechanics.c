@@ -8,33 +8,41 @@
 void mc_momentum_derive(
         const struct gc_twist *xd,
         const struct mc_momentum *p,
-        struct mc_wrench *r)
+        struct mc_wrench *r,
+        int count)
 {
-    // w x n
-    struct vector3 wxn;
-    la_dcross_o(
-            (double *)xd->angular_velocity, 1,
-            (double *)p->angular_momentum, 1,
-            (double *)&wxn, 1);
+    assert(xd);
+    assert(p);
+    assert(r);
+    assert(count >= 0);
 
-    // v x f
-    struct vector3 vxf;
-    la_dcross_o(
-            (double *)xd->linear_velocity, 1,
-            (double *)p->linear_momentum, 1,
-            (double *)&vxf, 1);
+    for (int i = 0; i < count; i++) {
+        // w x n
+        struct vector3 wxn;
+        la_dcross_o(
+                (double *)&xd->angular_velocity[i], 1,
+                (double *)&p->angular_momentum[i], 1,
+                (double *)&wxn, 1);
 
-    // n' = w x n + v x f
-    la_daxpy_oe(3,
-            1.0, (double *)&wxn, 1,
-            (double *)&vxf, 1,
-            (double *)r->torque, 1);
+        // v x f
+        struct vector3 vxf;
+        la_dcross_o(
+                (double *)&xd->linear_velocity[i], 1,
+                (double *)&p->linear_momentum[i], 1,
+                (double *)&vxf, 1);
 
-    // f' = w x f
-    la_dcross_o(
-            (double *)xd->angular_velocity, 1,
-            (double *)p->linear_momentum, 1,
-            (double *)r->force, 1);
+        // n' = w x n + v x f
+        la_daxpy_oe(3,
+                1.0, (double *)&wxn, 1,
+                (double *)&vxf, 1,
+                (double *)&r->torque[i], 1);
+
+        // f' = w x f
+        la_dcross_o(
+                (double *)&xd->angular_velocity[i], 1,
+                (double *)&p->linear_momentum[i], 1,
+                (double *)&r->force[i], 1);
+    }
 }
 
 
@@ -75,26 +83,26 @@ void mc_wrench_tf_tgt_to_ref(
     assert(r->torque && r->force);
     assert(count >= 0);
 
-    // f' = E^T f
-    la_dgemm_nnos(count, 3, 3,
-            (double *)f->force, 3,
-            (double *)x->rotation, 3,
-            (double *)r->force, 3);
-
-    // rx E^T f = r x f'
-    struct vector3 rxetf[count];
     for (int i = 0; i < count; i++) {
+        // f' = E^T f
+        la_d33gemv_tos(
+                (double *)x->rotation,
+                (double *)&f->force[i],
+                (double *)&r->force[i]);
+
+        // rx E^T f = r x f'
+        struct vector3 rxetf;
         la_dcross_o(
                 (double *)x->translation, 1,
                 (double *)&r->force[i], 1,
-                (double *)&rxetf[i], 1);
-    }
+                (double *)&rxetf, 1);
 
-    // n' = E^T n + rx E^T f
-    la_dgemm_nnoe(count, 3, 3,
-            1.0, (double *)f->torque, 3, (double *)x->rotation, 3,
-            1.0, (double *)&rxetf[0], 3,
-            (double *)r->torque, 3);
+        // n' = E^T n + rx E^T f
+        la_d33gemv_toe(
+                1.0, (double *)x->rotation, (double *)&f->torque[i],
+                1.0, (double *)&rxetf,
+                (double *)&r->torque[i]);
+    }
 }
 
 
@@ -282,10 +290,10 @@ void mc_rbi_map_twist_to_momentum(
             (double *)&hxv, 1);
 
     // n = I w + h x v
-    la_dgemv_noe(3, 3,
-            1.0, (double *)&m->second_moment_of_mass, 3, (double *)xd->angular_velocity, 1,
-            1.0, (double *)&hxv, 1,
-            (double *)r->angular_momentum, 1);
+    la_d33gemv_noe(
+            1.0, (double *)&m->second_moment_of_mass, (double *)xd->angular_velocity,
+            1.0, (double *)&hxv,
+            (double *)r->angular_momentum);
 
     // h x w
     struct vector3 hxw;
@@ -327,6 +335,68 @@ void ma_rbi_map_twist_to_momentum(
 }
 
 
+void mc_rbi_map_acc_twist_to_wrench(
+        const struct mc_rbi *m,
+        const struct gc_acc_twist *xdd,
+        struct mc_wrench *r)
+{
+    assert(m);
+    assert(xdd);
+    assert(r);
+
+    // h x v
+    struct vector3 hxv;
+    la_dcross_o(
+            (double *)&m->first_moment_of_mass, 1,
+            (double *)xdd->linear_acceleration, 1,
+            (double *)&hxv, 1);
+
+    // n = I w + h x v
+    la_d33gemv_noe(
+            1.0, (double *)&m->second_moment_of_mass, (double *)xdd->angular_acceleration,
+            1.0, (double *)&hxv,
+            (double *)r->torque);
+
+    // h x w
+    struct vector3 hxw;
+    la_dcross_o(
+            (double *)&m->first_moment_of_mass, 1,
+            (double *)xdd->angular_acceleration, 1,
+            (double *)&hxw, 1);
+
+    // m v
+    la_dscal_o(3,
+            m->zeroth_moment_of_mass,
+            (double *)xdd->linear_acceleration, 1,
+            (double *)r->force, 1);
+
+    // f = m v - h x w
+    la_daxpy_ie(3,
+            -1.0, (double *)&hxw, 1,
+            (double *)r->force, 1);
+}
+
+
+void ma_rbi_map_acc_twist_to_wrench(
+        const struct ma_rbi *m,
+        const struct ga_acc_twist *xdd,
+        struct ma_wrench *r)
+{
+    assert(m);
+    assert(xdd);
+    assert(r);
+    assert(xdd->frame);
+    assert(xdd->frame->origin == xdd->point);     // screw twist
+    assert(m->body == xdd->target_body);
+    assert(m->point == xdd->point);
+    assert(m->frame == xdd->frame);
+
+    r->body = xdd->target_body;
+    r->point = xdd->point;
+    r->frame = xdd->frame;
+}
+
+
 void mc_rbi_to_abi(
         const struct mc_rbi *rbi,
         struct mc_abi *r)
@@ -362,6 +432,78 @@ void ma_rbi_to_abi(
 }
 
 
+void mc_rbi_tf_tgt_to_ref(
+        const struct gc_pose *x,
+        const struct mc_rbi *m,
+        struct mc_rbi *r)
+{
+    assert(x);
+    assert(m);
+    assert(r);
+    assert(m != r);
+    assert(x->rotation && x->translation);
+
+    const double *p = x->translation->data;
+    const double mass = m->zeroth_moment_of_mass;
+
+    // Reference: [Featherstone2008]: p. 34, Table 2.5
+    //
+    // g = E^T h
+    struct vector3 g;
+    la_d33gemv_tos(
+            (double *)x->rotation,
+            (double *)&m->first_moment_of_mass,
+            (double *)&g);
+
+    // E^T I E
+    la_d33gecongr_tos(
+            (double *)x->rotation,
+            (double *)&m->second_moment_of_mass,
+            (double *)&r->second_moment_of_mass);
+
+    // I' = E^T I E - r x g x - (g + m r) x r x
+    //    = E^T I E - (g r^T + r g^T) - m r r^T + (2 r.g + m r.r) 1
+    double pg = p[0] * g.data[0] + p[1] * g.data[1] + p[2] * g.data[2];
+    double pp = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r->second_moment_of_mass.row[i].data[j] -=
+                    g.data[i] * p[j] + p[i] * g.data[j] + mass * p[i] * p[j];
+        }
+        r->second_moment_of_mass.row[i].data[i] += 2.0 * pg + mass * pp;
+    }
+
+    // h' = g + m r
+    for (int i = 0; i < 3; i++) {
+        r->first_moment_of_mass.data[i] = g.data[i] + mass * p[i];
+    }
+
+    r->zeroth_moment_of_mass = mass;
+}
+
+
+void mc_rbi_add(
+        const struct mc_rbi *m1,
+        const struct mc_rbi *m2,
+        struct mc_rbi *r)
+{
+    assert(m1);
+    assert(m2);
+    assert(r);
+
+    r->zeroth_moment_of_mass = m1->zeroth_moment_of_mass + m2->zeroth_moment_of_mass;
+    for (int i = 0; i < 3; i++) {
+        r->first_moment_of_mass.data[i] =
+                m1->first_moment_of_mass.data[i] + m2->first_moment_of_mass.data[i];
+        for (int j = 0; j < 3; j++) {
+            r->second_moment_of_mass.row[i].data[j] =
+                    m1->second_moment_of_mass.row[i].data[j]
+                    + m2->second_moment_of_mass.row[i].data[j];
+        }
+    }
+}
+
+
 void mc_rbi_log(
         const struct mc_rbi *m)
 {
@@ -408,63 +550,43 @@ void mc_abi_tf_tgt_to_ref(
     assert(m != r);
 
     // M' = E^T M E
-    struct matrix3x3 me;
-    la_dgemm_nnos(3, 3, 3,
-            (double *)&m->zeroth_moment_of_mass, 3,
-            (double *)x->rotation, 3,
-            (double *)&me, 3);
-    la_dgemm_tnos(3, 3, 3,
-            (double *)x->rotation, 3,
-            (double *)&me, 3,
-            (double *)&r->zeroth_moment_of_mass, 3);
+    la_d33gecongr_tos(
+            (double *)x->rotation,
+            (double *)&m->zeroth_moment_of_mass,
+            (double *)&r->zeroth_moment_of_mass);
 
     // H' = E^T H E + rxM'
-    struct matrix3x3 he;
     struct matrix3x3 ethe;
-    struct matrix3x3 rx;
-
-    la_dgemm_nnos(3, 3, 3,
-            (double *)&m->first_moment_of_mass, 3,
-            (double *)x->rotation, 3,
-            (double *)&he, 3);
-    la_dgemm_tnos(3, 3, 3,
-            (double *)x->rotation, 3,
-            (double *)&he, 3,
-            (double *)&ethe, 3);
-    la_dcrossop(
-            (double *)x->translation, 1,
-            (double *)&rx, 3);
-    la_dgemm_nnoe(3, 3, 3,
-            1.0, (double *)&rx, 3, (double *)&r->zeroth_moment_of_mass, 3,
-            1.0, (double *)&ethe, 3,
-            (double *)&r->first_moment_of_mass, 3);
+    la_d33gecongr_tos(
+            (double *)x->rotation,
+            (double *)&m->first_moment_of_mass,
+            (double *)&ethe);
+    la_d33crossgemm_noe(
+            1.0, (double *)x->translation, (double *)&r->zeroth_moment_of_mass,
+            1.0, (double *)&ethe,
+            (double *)&r->first_moment_of_mass);
 
     // I' = E^T I E + rx(E^T H E)^T - H'rx
-    struct matrix3x3 ie;
     struct matrix3x3 etie;
     struct matrix3x3 etie_rxethet;
 
     // E^T I E
-    la_dgemm_nnos(3, 3, 3,
-            (double *)&m->second_moment_of_mass, 3,
-            (double *)x->rotation, 3,
-            (double *)&ie, 3);
-    la_dgemm_tnos(3, 3, 3,
-            (double *)x->rotation, 3,
-            (double *)&ie, 3,
-            (double *)&etie, 3);
+    la_d33gecongr_tos(
+            (double *)x->rotation,
+            (double *)&m->second_moment_of_mass,
+            (double *)&etie);
 
     // + rx(E^T H E)^T
-    la_dgemm_ntoe(3, 3, 3,
-            1.0, (double *)&rx, 3, (double *)&ethe, 3,
-            1.0, (double *)&etie, 3,
-            (double *)&etie_rxethet, 3);
+    la_d33crossgemm_toe(
+            1.0, (double *)x->translation, (double *)&ethe,
+            1.0, (double *)&etie,
+            (double *)&etie_rxethet);
 
     // - H'rx
-    la_dgemm_nnoe(3, 3, 3,
-            -1.0, (double *)&r->first_moment_of_mass, 3, (double *)&rx, 3,
-            1.0, (double *)&etie_rxethet, 3,
-            (double *)&r->second_moment_of_mass, 3);
+    la_d33gemmcross_noe(
+            -1.0, (double *)&r->first_moment_of_mass, (double *)x->translation,
+            1.0, (double *)&etie_rxethet,
+            (double *)&r->second_moment_of_mass);
 }
 
 
@@ -539,29 +661,29 @@ void mc_abi_map_acc_twist_to_wrench(
 
     // H v
     struct vector3 hv;
-    la_dgemv_nos(3, 3,
-            (double *)&m->first_moment_of_mass, 3,
-            (double *)xdd->linear_acceleration, 1,
-            (double *)&hv, 1);
+    la_d33gemv_nos(
+            (double *)&m->first_moment_of_mass,
+            (double *)xdd->linear_acceleration,
+            (double *)&hv);
 
     // n = I w + H v
-    la_dgemv_noe(3, 3,
-            1.0, (double *)&m->second_moment_of_mass, 3, (double *)xdd->angular_acceleration, 1,
-            1.0, (double *)&hv, 1,
-            (double *)f->torque, 1);
+    la_d33gemv_noe(
+            1.0, (double *)&m->second_moment_of_mass, (double *)xdd->angular_acceleration,
+            1.0, (double *)&hv,
+            (double *)f->torque);
 
     // H^T w
     struct vector3 htw;
-    la_dgemv_tos(3, 3,
-            (double *)&m->first_moment_of_mass, 3,
-            (double *)xdd->angular_acceleration, 1,
-            (double *)&htw, 1);
+    la_d33gemv_tos(
+            (double *)&m->first_moment_of_mass,
+            (double *)xdd->angular_acceleration,
+            (double *)&htw);
 
     // f = M v + H^T w
-    la_dgemv_noe(3, 3,
-            1.0, (double *)&m->zeroth_moment_of_mass, 3, (double *)xdd->linear_acceleration, 1,
-            1.0, (double *)&htw, 1,
-            (double *)f->force, 1);
+    la_d33gemv_noe(
+            1.0, (double *)&m->zeroth_moment_of_mass, (double *)xdd->linear_acceleration,
+            1.0, (double *)&htw,
+            (double *)f->force);
 }
 
 
@@ -624,3 +746,210 @@ void ma_abi_log(
         m->body->name,
         m->frame->name);
 }
+
+
+void mc_abi_pack(
+        const struct mc_abi *m,
+        struct mc_abi_packed *r)
+{
+    assert(m);
+    assert(r);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            r->zeroth_moment_of_mass[MC_SYM33(i, j)] = m->zeroth_moment_of_mass.row[i].data[j];
+            r->second_moment_of_mass[MC_SYM33(i, j)] = m->second_moment_of_mass.row[i].data[j];
+        }
+    }
+    r->first_moment_of_mass = m->first_moment_of_mass;
+}
+
+
+void mc_abi_unpack(
+        const struct mc_abi_packed *m,
+        struct mc_abi *r)
+{
+    assert(m);
+    assert(r);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r->zeroth_moment_of_mass.row[i].data[j] = m->zeroth_moment_of_mass[MC_SYM33(i, j)];
+            r->second_moment_of_mass.row[i].data[j] = m->second_moment_of_mass[MC_SYM33(i, j)];
+        }
+    }
+    r->first_moment_of_mass = m->first_moment_of_mass;
+}
+
+
+void mc_rbi_to_abi_packed(
+        const struct mc_rbi *rbi,
+        struct mc_abi_packed *r)
+{
+    assert(rbi);
+    assert(r);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            r->zeroth_moment_of_mass[MC_SYM33(i, j)] = i == j ? rbi->zeroth_moment_of_mass : 0.0;
+            r->second_moment_of_mass[MC_SYM33(i, j)] = rbi->second_moment_of_mass.row[i].data[j];
+        }
+    }
+    la_dcrossop(
+            (double *)&rbi->first_moment_of_mass, 1,
+            (double *)&r->first_moment_of_mass, 3);
+}
+
+
+// Upper triangle of the congruence E^T S E of a packed symmetric matrix S
+static void sym33_congruence(
+        const struct matrix3x3 *e,
+        const double *s,
+        double *r)
+{
+    // S E
+    double se[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            se[i][j] = s[MC_SYM33(i, 0)] * e->row[0].data[j]
+                    + s[MC_SYM33(i, 1)] * e->row[1].data[j]
+                    + s[MC_SYM33(i, 2)] * e->row[2].data[j];
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            r[MC_SYM33(i, j)] = e->row[0].data[i] * se[0][j]
+                    + e->row[1].data[i] * se[1][j]
+                    + e->row[2].data[i] * se[2][j];
+        }
+    }
+}
+
+
+void mc_abi_packed_tf_tgt_to_ref(
+        const struct gc_pose *x,
+        const struct mc_abi_packed *m,
+        struct mc_abi_packed *r)
+{
+    assert(x);
+    assert(m);
+    assert(r);
+    assert(m != r);
+
+    const struct matrix3x3 *e = x->rotation;
+    const double *p = x->translation->data;
+
+    // rx
+    const double rx[3][3] = {
+        {   0.0, -p[2],  p[1] },
+        {  p[2],   0.0, -p[0] },
+        { -p[1],  p[0],   0.0 }
+    };
+
+    // M' = E^T M E
+    sym33_congruence(e, m->zeroth_moment_of_mass, r->zeroth_moment_of_mass);
+
+    // E^T H E
+    struct matrix3x3 ethe;
+    la_d33gecongr_tos(
+            (double *)e,
+            (double *)&m->first_moment_of_mass,
+            (double *)&ethe);
+
+    // H' = E^T H E + rxM'
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            r->first_moment_of_mass.row[i].data[j] = ethe.row[i].data[j]
+                    + rx[i][0] * r->zeroth_moment_of_mass[MC_SYM33(0, j)]
+                    + rx[i][1] * r->zeroth_moment_of_mass[MC_SYM33(1, j)]
+                    + rx[i][2] * r->zeroth_moment_of_mass[MC_SYM33(2, j)];
+        }
+    }
+
+    // I' = E^T I E + rx(E^T H E)^T - H'rx
+    sym33_congruence(e, m->second_moment_of_mass, r->second_moment_of_mass);
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            double rxetht = 0.0;
+            double hrx = 0.0;
+            for (int k = 0; k < 3; k++) {
+                rxetht += rx[i][k] * ethe.row[j].data[k];
+                hrx += r->first_moment_of_mass.row[i].data[k] * rx[k][j];
+            }
+            r->second_moment_of_mass[MC_SYM33(i, j)] += rxetht - hrx;
+        }
+    }
+}
+
+
+void mc_abi_packed_add(
+        const struct mc_abi_packed *m1,
+        const struct mc_abi_packed *m2,
+        struct mc_abi_packed *r)
+{
+    assert(m1);
+    assert(m2);
+    assert(r);
+
+    for (int i = 0; i < 6; i++) {
+        r->zeroth_moment_of_mass[i] = m1->zeroth_moment_of_mass[i] + m2->zeroth_moment_of_mass[i];
+        r->second_moment_of_mass[i] = m1->second_moment_of_mass[i] + m2->second_moment_of_mass[i];
+    }
+    la_dgeadd_os(3, 3,
+            (double *)&m1->first_moment_of_mass, 3,
+            (double *)&m2->first_moment_of_mass, 3,
+            (double *)&r->first_moment_of_mass, 3);
+}
+
+
+void mc_abi_packed_map_acc_twist_to_wrench(
+        const struct mc_abi_packed *m,
+        const struct gc_acc_twist *xdd,
+        struct mc_wrench *f)
+{
+    assert(m);
+    assert(xdd);
+    assert(f);
+
+    const double *w = xdd->angular_acceleration->data;
+    const double *v = xdd->linear_acceleration->data;
+
+    // H v
+    struct vector3 hv;
+    la_d33gemv_nos(
+            (double *)&m->first_moment_of_mass,
+            (double *)v,
+            (double *)&hv);
+
+    // H^T w
+    struct vector3 htw;
+    la_d33gemv_tos(
+            (double *)&m->first_moment_of_mass,
+            (double *)w,
+            (double *)&htw);
+
+    // n = I w + H v
+    // f = M v + H^T w
+    for (int i = 0; i < 3; i++) {
+        f->torque->data[i] = hv.data[i]
+                + m->second_moment_of_mass[MC_SYM33(i, 0)] * w[0]
+                + m->second_moment_of_mass[MC_SYM33(i, 1)] * w[1]
+                + m->second_moment_of_mass[MC_SYM33(i, 2)] * w[2];
+        f->force->data[i] = htw.data[i]
+                + m->zeroth_moment_of_mass[MC_SYM33(i, 0)] * v[0]
+                + m->zeroth_moment_of_mass[MC_SYM33(i, 1)] * v[1]
+                + m->zeroth_moment_of_mass[MC_SYM33(i, 2)] * v[2];
+    }
+}
+
+
+void mc_abi_packed_log(
+        const struct mc_abi_packed *m)
+{
+    assert(m);
+
+    struct mc_abi r;
+    mc_abi_unpack(m, &r);
+    mc_abi_log(&r);
+}
@@ -0,0 +1,1065 @@
+#include <dyn2b/functions/solver.h>
+#include <dyn2b/functions/geometry.h>
+#include <dyn2b/functions/mechanics.h>
+#include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/linear_algebra.h>
+#include "solver_joint.h"
+#include "solver_lanes.h"
+#include "solver_subtree.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <assert.h>
+
+
+// Index of body i's parent body; the base is body 0
+static inline int parent_body(
+        const struct kcc_kinematic_chain *kc,
+        int i)
+{
+    return kc->parent ? kc->parent[i - 1] + 1 : i - 1;
+}
+
+
+void kcc_sincos(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s)
+{
+    assert(kc);
+    assert(q);
+    assert(s);
+    assert(s->nbody == kc->number_of_segments);
+
+#ifdef DYN2B_LIBM_TRIG
+    for (int k = 0; k < s->nq; k++) {
+        s->sin_q[k] = sin(q[k]);
+        s->cos_q[k] = cos(q[k]);
+    }
+#else
+    la_dsincos(s->nq, q, 1, s->sin_q, 1, s->cos_q, 1);
+#endif
+
+    for (int k = 0; k < s->nq; k++) s->q_trig[k] = q[k];
+}
+
+
+// Forward kinematics up to the positions, the velocities (qd) or the
+// accelerations (qd and qdd)
+static void fk(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_acceleration *qdd,
+        struct solver_state_c *s)
+{
+    assert(kc);
+    assert(q);
+    assert(s);
+    assert(s->nbody == kc->number_of_segments);
+
+    const int NR_SEGMENTS = kc->number_of_segments;
+
+    s->x_valid = 0;
+
+    for (int i = 1, iq = 0, id = 0; i < NR_SEGMENTS + 1; i++) {
+        const struct kcc_segment *segment = &kc->segment[i - 1];
+        const struct kcc_joint *joint = &segment->joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+        const int p = parent_body(kc, i);
+
+        // Position
+        //
+
+        // X_{J,i} and i^X_{p(i)} = X_{J,i} X_{T,i}
+        joint_fpk_compose(kc, op, q, s, i, iq);
+
+        // i^X_0 = i^X_{p(i)} {p(i)}^X_0
+        gc_pose_compose(&s->x_rel[i - 1], &s->x_tot[p], &s->x_tot[i]);
+
+
+        // Velocity
+        //
+
+        if (qd) {
+            // Xd_{J,i} = S qd
+            op->fvk(joint, &qd[id], &s->xd_jnt[i - 1]);
+
+            // Xd_{p(i)}' = i^X_{p(i)} Xd_{p(i)}
+            gc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xd[p], &s->xd_tf[i - 1]);
+
+            // Xd_i = Xd_{p(i)}' + Xd_{J,i}
+            gc_twist_accumulate(&s->xd_tf[i - 1], &s->xd_jnt[i - 1], &s->xd[i]);
+        }
+
+
+        // Acceleration
+        //
+
+        if (qd && qdd) {
+            // Xdd_{bias,i} = Sd_i qd_i + Xd_i x S_i qd_i
+            op->inertial_acceleration(joint, &s->xd[i], &qd[id], &s->xdd_bias[i - 1]);
+
+            // Xdd_{J,i} = S_i qdd_i
+            op->fak(joint, &qdd[id], &s->xdd_jnt[i - 1]);
+
+            // Xdd_{net,i} = Xdd_{J,i} + Xdd_{bias,i}
+            gc_acc_twist_accumulate(&s->xdd_jnt[i - 1], &s->xdd_bias[i - 1], &s->xdd_net[i - 1]);
+
+            // Xdd_{p(i)}' = i^X_{p(i)} Xdd_{p(i)}
+            gc_acc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xdd[p], &s->xdd_tf[i - 1]);
+
+            // Xdd_i = Xdd_{p(i)}' + Xdd_{net,i}
+            gc_acc_twist_accumulate(&s->xdd_tf[i - 1], &s->xdd_net[i - 1], &s->xdd[i]);
+        }
+
+        iq += op->nq;
+        id += op->nd;
+    }
+}
+
+
+void kcc_fpk(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s)
+{
+    fk(kc, q, NULL, NULL, s);
+}
+
+
+int kcc_fpk_incremental(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s)
+{
+    assert(kc);
+    assert(q);
+    assert(s);
+    assert(s->nbody == kc->number_of_segments);
+
+    const int NR_SEGMENTS = kc->number_of_segments;
+    int count = 0;
+
+    s->x_moved[0] = 0;
+
+    for (int i = 1; i < NR_SEGMENTS + 1; i++) {
+        const struct kcc_segment *segment = &kc->segment[i - 1];
+        const struct kcc_joint *joint = &segment->joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+        const int iq = s->iq[i - 1];
+
+        int changed = !s->x_valid;
+        for (int k = 0; k < op->nq && !changed; k++) {
+            changed = q[iq + k] != s->q_fpk[iq + k];
+        }
+
+        if (changed) {
+            // X_{J,i} and i^X_{p(i)} = X_{J,i} X_{T,i}
+            joint_fpk_compose(kc, op, q, s, i, iq);
+
+            for (int k = 0; k < op->nq; k++) s->q_fpk[iq + k] = q[iq + k];
+        }
+
+        // A link moves if its joint or any joint upstream has changed
+        const int p = parent_body(kc, i);
+        s->x_moved[i] = changed || s->x_moved[p];
+
+        if (s->x_moved[i]) {
+            // i^X_0 = i^X_{p(i)} {p(i)}^X_0
+            gc_pose_compose(&s->x_rel[i - 1], &s->x_tot[p], &s->x_tot[i]);
+            count++;
+        }
+    }
+
+    s->x_valid = 1;
+
+    return count;
+}
+
+
+void kcc_fvk(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        struct solver_state_c *s)
+{
+    assert(qd);
+
+    fk(kc, q, qd, NULL, s);
+}
+
+
+void kcc_fak(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_acceleration *qdd,
+        struct solver_state_c *s)
+{
+    assert(qd);
+    assert(qdd);
+
+    fk(kc, q, qd, qdd, s);
+}
+
+
+// The passes of the articulated-body algorithm for body i, which kcc_aba()
+// applies to all bodies and the subtree scheduler (see solver_subtree.h) to
+// the bodies of one subtree at a time
+
+// Position, velocity, bias acceleration, inertia and momentum of body i
+static inline void aba_outward(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        struct solver_state_c *s,
+        int i,
+        int iq,
+        int id)
+{
+    const struct kcc_segment *segment = &kc->segment[i - 1];
+    const struct kcc_joint *joint = &segment->joint;
+    const struct kcc_joint_operators *op = joint_operators(joint);
+    const int p = parent_body(kc, i);
+
+    // Position
+    //
+
+    // X_{J,i} and i^X_{p(i)} = X_{J,i} X_{T,i}
+    joint_fpk_compose(kc, op, q, s, i, iq);
+
+
+    // Velocity
+    //
+
+    // Xd_{J,i} = S qd
+    op->fvk(joint, &qd[id], &s->xd_jnt[i - 1]);
+
+    // Xd_{p(i)}' = i^X_{p(i)} Xd_{p(i)}
+    gc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xd[p], &s->xd_tf[i - 1]);
+
+    // Xd_i = Xd_{p(i)}' + Xd_{J,i}
+    gc_twist_accumulate(&s->xd_tf[i - 1], &s->xd_jnt[i - 1], &s->xd[i]);
+
+
+    // Acceleration
+    //
+
+    // Xdd_{bias,i} = Sd_i qd_i + Xd_i x S_i qd_i
+    op->inertial_acceleration(joint, &s->xd[i], &qd[id], &s->xdd_bias[i - 1]);
+
+
+    // Inertia
+    //
+
+    // M_i^A = M_i
+    mc_rbi_to_abi_packed(&segment->link.inertia, &s->m_art[i]);
+
+
+    // Force
+    //
+
+    // P_i = M_i Xd_i
+    mc_rbi_map_twist_to_momentum(&segment->link.inertia, &s->xd[i], &s->p[i - 1]);
+}
+
+
+// Body i's bias torque and, unless its parent is the base, its apparent
+// inertia and bias force in the parent's coordinates, i.e. the contributions
+// that aba_join() adds to the parent
+static inline void aba_inward(
+        const struct kcc_kinematic_chain *kc,
+        const joint_torque *tau,
+        struct solver_state_c *s,
+        int i,
+        int id)
+{
+    const struct kcc_joint *joint = &kc->segment[i - 1].joint;
+    const struct kcc_joint_operators *op = joint_operators(joint);
+
+    // tau_{bias,i}^A = S_i^T F_{bias,i}^A
+    op->ifk(joint, &s->f_bias_art[i], &s->tau_bias_art[id], 1);
+
+    // The base does not move, hence nothing has to be propagated to it
+    if (parent_body(kc, i) == 0) return;
+
+
+    // Inertia
+    //
+
+    // M_i^a = P_i^T M_i^A
+    op->project_inertia(joint, &s->m_art[i], &s->m_app[i - 1]);
+
+    // M_{p(i)}^a' = {p(i)}^X_i* M_i^a i^X_{p(i)}
+    mc_abi_packed_tf_tgt_to_ref(&s->x_rel[i - 1], &s->m_app[i - 1], &s->m_tf[i]);
+
+
+    // Force
+    //
+
+    // F_{bias,i}^A' = M_i^A Xdd_{bias,i} + F_{bias,i}^A
+    mc_abi_packed_map_acc_twist_to_wrench(&s->m_art[i], &s->xdd_bias[i - 1], &s->f_bias_eom[i - 1]);
+    mc_wrench_add(&s->f_bias_eom[i - 1], &s->f_bias_art[i], &s->f_bias_eom[i - 1], 1);
+
+    // F_{bias,i}^a = P_i^T F_{bias,i}^A'
+    op->project_wrench(joint, &s->m_art[i], &s->f_bias_eom[i - 1], &s->f_bias_app[i - 1], 1);
+
+    // F_{tau,i} = M_i^A S_i D_i^{-1} tau_i
+    op->ffd(joint, &s->m_art[i], &tau[id], &s->f_ff_jnt[i - 1], 1);
+
+    // F_{bias,i}^a += F_{tau,i}
+    mc_wrench_add(&s->f_bias_app[i - 1], &s->f_ff_jnt[i - 1], &s->f_bias_app[i - 1], 1);
+
+    // F_{bias,i}^a' = {p(i)}^X_i* F_{bias,i}^a
+    mc_wrench_tf_tgt_to_ref(&s->x_rel[i - 1], &s->f_bias_app[i - 1], &s->f_bias_tf[i - 1], 1);
+}
+
+
+// Add body i's contributions to its parent
+static inline void aba_join(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int i)
+{
+    const int p = parent_body(kc, i);
+
+    if (p == 0) return;
+
+    // M_{p(i)}^A += M_{p(i)}^a'
+    mc_abi_packed_add(&s->m_art[p], &s->m_tf[i], &s->m_art[p]);
+
+    // F_{bias,p(i)}^A += F_{bias,i}^a'
+    mc_wrench_add(&s->f_bias_art[p], &s->f_bias_tf[i - 1], &s->f_bias_art[p], 1);
+}
+
+
+// Joint and link acceleration of body i
+static inline void aba_accelerate(
+        const struct kcc_kinematic_chain *kc,
+        const joint_torque *tau,
+        struct solver_state_c *s,
+        int i,
+        int id,
+        joint_acceleration *qdd)
+{
+    const struct kcc_joint *joint = &kc->segment[i - 1].joint;
+    const struct kcc_joint_operators *op = joint_operators(joint);
+    const int p = parent_body(kc, i);
+
+    // Acceleration
+    //
+
+    // Xdd_{p(i)}' = i^X_{p(i)} Xdd_{p(i)}
+    gc_acc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xdd[p], &s->xdd_tf[i - 1]);
+
+    // Xdd_{nact,i} = Xdd_{p(i)}' + Xdd_{bias,i}
+    gc_acc_twist_accumulate(&s->xdd_tf[i - 1], &s->xdd_bias[i - 1], &s->xdd_nact[i - 1]);
+
+
+    // Force
+    //
+
+    // F_{nact,i} = M_i^A Xdd_{nact,i}
+    mc_abi_packed_map_acc_twist_to_wrench(&s->m_art[i], &s->xdd_nact[i - 1], &s->f_bias_nact[i - 1]);
+
+    // tau_{nact,i} = S_i^T F_{nact,i}
+    op->ifk(joint, &s->f_bias_nact[i - 1], &s->tau_ctrl[id], 1);
+
+
+    // Solve
+    //
+
+    // tau_{ctrl,i} = tau_i - tau_{bias,i}^A - tau_{nact,i}
+    for (int j = id; j < id + op->nd; j++) {
+        s->tau_ctrl[j] = tau[j] - s->tau_bias_art[j] - s->tau_ctrl[j];
+    }
+
+    // qdd_i = D_i^{-1} tau_{ctrl,i}
+    op->fad(joint, &s->m_art[i], &s->tau_ctrl[id], &qdd[id], 1);
+
+
+    // Resultant acceleration
+    //
+
+    // Xdd_{J,i} = S_i qdd_i
+    op->fak(joint, &qdd[id], &s->xdd_jnt[i - 1]);
+
+    // Xdd_i = Xdd_{nact,i} + Xdd_{J,i}
+    gc_acc_twist_accumulate(&s->xdd_nact[i - 1], &s->xdd_jnt[i - 1], &s->xdd[i]);
+}
+
+
+void kcc_aba(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        joint_acceleration *qdd)
+{
+    assert(kc);
+    assert(q);
+    assert(qd);
+    assert(tau);
+    assert(s);
+    assert(qdd);
+    assert(s->nbody == kc->number_of_segments);
+
+    const int NR_SEGMENTS = kc->number_of_segments;
+
+    s->x_valid = 0;
+
+    // iq and id are the offsets of segment i's joint positions and DoFs
+    for (int i = 1, iq = 0, id = 0; i < NR_SEGMENTS + 1; i++) {
+        const struct kcc_joint_operators *op = joint_operators(&kc->segment[i - 1].joint);
+
+        aba_outward(kc, q, qd, s, i, iq, id);
+
+        iq += op->nq;
+        id += op->nd;
+    }
+
+
+    // The bias forces of the bodies are independent of each other, hence they
+    // are computed in one pass over the state's slabs
+
+    // F_{bias,i}^A = Xd_i x* P_i
+    mc_momentum_derive(&s->xd[1], &s->p[0], &s->f_bias_art[1], NR_SEGMENTS);
+
+    // F_{bias,i}^A -= F_{ext,i}
+    if (f_ext) {
+        mc_wrench_sub(&s->f_bias_art[1], f_ext, &s->f_bias_art[1], NR_SEGMENTS);
+    }
+
+
+    for (int i = NR_SEGMENTS, id = s->nd; i > 0; i--) {
+        id -= joint_operators(&kc->segment[i - 1].joint)->nd;
+
+        aba_inward(kc, tau, s, i, id);
+        aba_join(kc, s, i);
+    }
+
+
+    for (int i = 1, id = 0; i < NR_SEGMENTS + 1; i++) {
+        aba_accelerate(kc, tau, s, i, id, qdd);
+
+        id += joint_operators(&kc->segment[i - 1].joint)->nd;
+    }
+}
+
+
+void kcc_aba_outward(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        const int *body,
+        int count)
+{
+    for (int k = 0; k < count; k++) {
+        const int i = body[k];
+
+        aba_outward(kc, q, qd, s, i, s->iq[i - 1], s->id[i - 1]);
+
+        // F_{bias,i}^A = Xd_i x* P_i
+        mc_momentum_derive(&s->xd[i], &s->p[i - 1], &s->f_bias_art[i], 1);
+
+        // F_{bias,i}^A -= F_{ext,i}
+        if (f_ext) {
+            struct mc_wrench f = { .torque = &f_ext->torque[i - 1], .force = &f_ext->force[i - 1] };
+            mc_wrench_sub(&s->f_bias_art[i], &f, &s->f_bias_art[i], 1);
+        }
+    }
+}
+
+
+void kcc_aba_inward(
+        const struct kcc_kinematic_chain *kc,
+        const joint_torque *tau,
+        struct solver_state_c *s,
+        const int *body,
+        int count,
+        int join)
+{
+    for (int k = count - 1; k >= 0; k--) {
+        const int i = body[k];
+
+        aba_inward(kc, tau, s, i, s->id[i - 1]);
+        if (parent_body(kc, i) != join) aba_join(kc, s, i);
+    }
+}
+
+
+void kcc_aba_join(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int i)
+{
+    aba_join(kc, s, i);
+}
+
+
+void kcc_aba_accelerate(
+        const struct kcc_kinematic_chain *kc,
+        const joint_torque *tau,
+        struct solver_state_c *s,
+        const int *body,
+        int count,
+        joint_acceleration *qdd)
+{
+    for (int k = 0; k < count; k++) {
+        const int i = body[k];
+
+        aba_accelerate(kc, tau, s, i, s->id[i - 1], qdd);
+    }
+}
+
+
+void kcc_rnea(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_acceleration *qdd,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        joint_torque *tau)
+{
+    assert(kc);
+    assert(q);
+    assert(s);
+    assert(tau);
+    assert(s->nbody == kc->number_of_segments);
+
+    const int NR_SEGMENTS = kc->number_of_segments;
+
+    s->x_valid = 0;
+
+    // iq and id are the offsets of segment i's joint positions and DoFs
+    for (int i = 1, iq = 0, id = 0; i < NR_SEGMENTS + 1; i++) {
+        const struct kcc_segment *segment = &kc->segment[i - 1];
+        const struct kcc_joint *joint = &segment->joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+        const int p = parent_body(kc, i);
+
+        // Position
+        //
+
+        // X_{J,i} and i^X_{p(i)} = X_{J,i} X_{T,i}
+        joint_fpk_compose(kc, op, q, s, i, iq);
+
+
+        // Acceleration
+        //
+
+        // Xdd_i = i^X_{p(i)} Xdd_{p(i)}
+        gc_acc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xdd[p], &s->xdd[i]);
+
+        if (qdd) {
+            // Xdd_i += S_i qdd_i
+            op->fak(joint, &qdd[id], &s->xdd_jnt[i - 1]);
+            gc_acc_twist_accumulate(&s->xdd[i], &s->xdd_jnt[i - 1], &s->xdd[i]);
+        }
+
+
+        // Velocity
+        //
+
+        if (qd) {
+            // Xd_{J,i} = S qd
+            op->fvk(joint, &qd[id], &s->xd_jnt[i - 1]);
+
+            // Xd_{p(i)}' = i^X_{p(i)} Xd_{p(i)}
+            gc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xd[p], &s->xd_tf[i - 1]);
+
+            // Xd_i = Xd_{p(i)}' + Xd_{J,i}
+            gc_twist_accumulate(&s->xd_tf[i - 1], &s->xd_jnt[i - 1], &s->xd[i]);
+
+            // Xdd_i += Sd_i qd_i + Xd_i x S_i qd_i
+            op->inertial_acceleration(joint, &s->xd[i], &qd[id], &s->xdd_bias[i - 1]);
+            gc_acc_twist_accumulate(&s->xdd[i], &s->xdd_bias[i - 1], &s->xdd[i]);
+
+            // P_i = M_i Xd_i
+            mc_rbi_map_twist_to_momentum(&segment->link.inertia, &s->xd[i], &s->p[i - 1]);
+        }
+
+
+        // Force
+        //
+
+        // F_i = M_i Xdd_i
+        mc_rbi_map_acc_twist_to_wrench(&segment->link.inertia, &s->xdd[i], &s->f_bias_art[i]);
+
+        iq += op->nq;
+        id += op->nd;
+    }
+
+
+    if (qd) {
+        // F_i += Xd_i x* P_i
+        mc_momentum_derive(&s->xd[1], &s->p[0], &s->f_bias_eom[0], NR_SEGMENTS);
+        mc_wrench_add(&s->f_bias_art[1], &s->f_bias_eom[0], &s->f_bias_art[1], NR_SEGMENTS);
+    }
+
+    // F_i -= F_{ext,i}
+    if (f_ext) {
+        mc_wrench_sub(&s->f_bias_art[1], f_ext, &s->f_bias_art[1], NR_SEGMENTS);
+    }
+
+
+    for (int i = NR_SEGMENTS, id = s->nd; i > 0; i--) {
+        const struct kcc_joint *joint = &kc->segment[i - 1].joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+        const int p = parent_body(kc, i);
+        id -= op->nd;
+
+        // tau_i = S_i^T F_i
+        op->ifk(joint, &s->f_bias_art[i], &s->tau_ctrl[id], 1);
+
+        // tau_i += I_{J,i} qdd_i
+        if (qdd) {
+            op->inertial_torque(joint, &qdd[id], &tau[id], 1);
+            for (int j = id; j < id + op->nd; j++) tau[j] += s->tau_ctrl[j];
+        } else {
+            for (int j = id; j < id + op->nd; j++) tau[j] = s->tau_ctrl[j];
+        }
+
+        // The base does not move, hence nothing has to be propagated to it
+        if (p == 0) continue;
+
+        // F_{p(i)} += {p(i)}^X_i* F_i
+        mc_wrench_tf_tgt_to_ref(&s->x_rel[i - 1], &s->f_bias_art[i], &s->f_bias_tf[i - 1], 1);
+        mc_wrench_add(&s->f_bias_art[p], &s->f_bias_tf[i - 1], &s->f_bias_art[p], 1);
+    }
+}
+
+
+// Store M_rc (and M_cr) of the joint-space mass matrix
+static inline void crba_store(
+        joint_inertia *m,
+        int nd,
+        int packed,
+        int r,
+        int c,
+        joint_inertia value)
+{
+    if (packed) {
+        int i = r > c ? r : c;
+        int j = r > c ? c : r;
+        m[i * (i + 1) / 2 + j] = value;
+    } else {
+        m[r * nd + c] = value;
+        m[c * nd + r] = value;
+    }
+}
+
+
+// Segment i's DoFs are the columns id, ..., id + nd_i - 1 of the mass matrix,
+// which are computed one at a time. Only the entries of the segment's
+// ancestors are non-zero.
+static void crba(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s,
+        joint_inertia *m,
+        int packed)
+{
+    assert(kc);
+    assert(q);
+    assert(s);
+    assert(m);
+    assert(s->nbody == kc->number_of_segments);
+
+    const int NR_SEGMENTS = kc->number_of_segments;
+    const int ND = s->nd;
+
+    s->x_valid = 0;
+
+    // The entries of DoFs on different branches of a tree are not visited
+    if (kc->parent) {
+        const int SIZE = packed ? ND * (ND + 1) / 2 : ND * ND;
+        for (int k = 0; k < SIZE; k++) m[k] = 0.0;
+    }
+
+    for (int i = 1, iq = 0; i < NR_SEGMENTS + 1; i++) {
+        const struct kcc_segment *segment = &kc->segment[i - 1];
+        const struct kcc_joint *joint = &segment->joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+
+        // X_{J,i} and i^X_{p(i)} = X_{J,i} X_{T,i}
+        joint_fpk_compose(kc, op, q, s, i, iq);
+
+        // M_i^C = M_i
+        mc_rbi_to_abi_packed(&segment->link.inertia, &s->m_art[i]);
+
+        iq += op->nq;
+    }
+
+
+    for (int i = NR_SEGMENTS, id = ND; i > 0; i--) {
+        const struct kcc_joint *joint = &kc->segment[i - 1].joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+        const int p = parent_body(kc, i);
+        id -= op->nd;
+
+        for (int c = 0; c < op->nd; c++) {
+            joint_acceleration e[6] = { 0.0 };
+            e[c] = 1.0;
+
+            // F_i = M_i^C S_i e_c
+            op->fak(joint, e, &s->xdd_jnt[i - 1]);
+            mc_abi_packed_map_acc_twist_to_wrench(&s->m_art[i], &s->xdd_jnt[i - 1], &s->f_ff_app[i - 1]);
+
+            // H_ii e_c = S_i^T F_i + I_{J,i} e_c
+            joint_inertia hii[6];
+            joint_torque ij[6];
+            op->ifk(joint, &s->f_ff_app[i - 1], hii, 1);
+            op->inertial_torque(joint, e, ij, 1);
+            for (int r = 0; r < op->nd; r++) {
+                crba_store(m, ND, packed, id + r, id + c, hii[r] + ij[r]);
+            }
+
+            // H_ji e_c = S_j^T {j}^X_i* F_i for all ancestors j of i
+            for (int k = i, j = p; j > 0; k = j, j = parent_body(kc, j)) {
+                const struct kcc_joint *ancestor = &kc->segment[j - 1].joint;
+                const struct kcc_joint_operators *aop = joint_operators(ancestor);
+                const int jd = s->id[j - 1];
+                joint_inertia hji[6];
+
+                mc_wrench_tf_tgt_to_ref(&s->x_rel[k - 1], &s->f_ff_app[k - 1], &s->f_ff_app[j - 1], 1);
+                aop->ifk(ancestor, &s->f_ff_app[j - 1], hji, 1);
+                for (int r = 0; r < aop->nd; r++) {
+                    crba_store(m, ND, packed, jd + r, id + c, hji[r]);
+                }
+            }
+        }
+
+        // The base does not move, hence nothing has to be propagated to it
+        if (p == 0) continue;
+
+        // M_{p(i)}^C += {p(i)}^X_i* M_i^C i^X_{p(i)}
+        mc_abi_packed_tf_tgt_to_ref(&s->x_rel[i - 1], &s->m_art[i], &s->m_tf[i]);
+        mc_abi_packed_add(&s->m_art[p], &s->m_tf[i], &s->m_art[p]);
+    }
+}
+
+
+void kcc_crba(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s,
+        joint_inertia *m)
+{
+    crba(kc, q, s, m, 0);
+}
+
+
+void kcc_crba_packed(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        struct solver_state_c *s,
+        joint_inertia *m)
+{
+    crba(kc, q, s, m, 1);
+}
+
+
+// Column k of a 6 x nd Jacobian as twist
+static inline struct gc_twist jacobian_column(
+        double *j,
+        int k)
+{
+    struct gc_twist xd = {
+        .angular_velocity = (struct vector3 *)&j[6 * k],
+        .linear_velocity = (struct vector3 *)&j[6 * k + 3]
+    };
+
+    return xd;
+}
+
+
+// The frame's Jacobian from the joints' motion subspaces in the base's
+// coordinates js; j may alias js
+static void jacobian_project(
+        const struct kcc_kinematic_chain *kc,
+        const struct kcc_frame *frame,
+        enum jacobian_type type,
+        struct solver_state_c *s,
+        double *js,
+        double *j)
+{
+    const int NR_SEGMENTS = kc->number_of_segments;
+
+    // f^X_0 = f^X_b b^X_0
+    struct matrix3x3 rotation;
+    struct vector3 translation;
+    struct gc_pose x_f = { .rotation = &rotation, .translation = &translation };
+    const struct gc_pose *x = &s->x_tot[frame->body];
+    if (frame->pose) {
+        gc_pose_compose(frame->pose, &s->x_tot[frame->body], &x_f);
+        x = &x_f;
+    }
+
+    // The bodies on the path to the base are visited in decreasing order,
+    // a is the next of them
+    for (int i = NR_SEGMENTS, a = frame->body; i > 0; i--) {
+        const int ND = joint_operators(&kc->segment[i - 1].joint)->nd;
+        const int id = s->id[i - 1];
+
+        if (i != a) {
+            for (int k = 6 * id; k < 6 * (id + ND); k++) j[k] = 0.0;
+            continue;
+        }
+        a = parent_body(kc, a);
+
+        for (int k = id; k < id + ND; k++) {
+            if (type == JACOBIAN_SPATIAL) {
+                if (j != js) {
+                    for (int l = 0; l < 6; l++) j[6 * k + l] = js[6 * k + l];
+                }
+                continue;
+            }
+
+            struct vector3 angular, linear;
+            struct gc_twist xd = { .angular_velocity = &angular, .linear_velocity = &linear };
+            struct gc_twist col_s = jacobian_column(js, k);
+            struct gc_twist col = jacobian_column(j, k);
+
+            // J_k = f^X_0 0^X_i S_i e_k
+            gc_twist_tf_ref_to_tgt(x, &col_s, &xd);
+            *col.angular_velocity = angular;
+            *col.linear_velocity = linear;
+        }
+    }
+}
+
+
+void kcc_jacobian(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const struct kcc_frame *frame,
+        enum jacobian_type type,
+        struct solver_state_c *s,
+        double *j)
+{
+    kcc_jacobian_batch(kc, q, 1, frame, type, s, j);
+}
+
+
+void kcc_jacobian_batch(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        int count,
+        const struct kcc_frame *frame,
+        enum jacobian_type type,
+        struct solver_state_c *s,
+        double *j)
+{
+    assert(kc);
+    assert(q);
+    assert(count >= 0);
+    assert(frame || count == 0);
+    assert(s);
+    assert(j || count == 0);
+    assert(s->nbody == kc->number_of_segments);
+
+    const int NR_SEGMENTS = kc->number_of_segments;
+    const int SIZE = 6 * s->nd;
+
+    if (count == 0) return;
+
+    kcc_fpk_incremental(kc, q, s);
+
+    // The motion subspaces 0^X_i S_i in the base's coordinates, which are
+    // kept in the first frame's Jacobian until all others are done
+    double *js = j;
+    for (int i = 1; i < NR_SEGMENTS + 1; i++) {
+        const struct kcc_joint *joint = &kc->segment[i - 1].joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+
+        for (int k = 0; k < op->nd; k++) {
+            joint_velocity e[6] = { 0.0 };
+            struct vector3 angular, linear;
+            struct gc_twist xd = { .angular_velocity = &angular, .linear_velocity = &linear };
+            struct gc_twist col = jacobian_column(js, s->id[i - 1] + k);
+
+            // S_i e_k
+            e[k] = 1.0;
+            op->fvk(joint, e, &xd);
+
+            gc_twist_tf_tgt_to_ref(&s->x_tot[i], &xd, &col);
+        }
+    }
+
+    for (int f = count - 1; f >= 0; f--) {
+        assert(frame[f].body >= 0 && frame[f].body <= NR_SEGMENTS);
+
+        jacobian_project(kc, &frame[f], type, s, js, &j[f * SIZE]);
+    }
+}
+
+
+void kcc_jacobian_dot_qd(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const struct kcc_frame *frame,
+        enum jacobian_type type,
+        struct solver_state_c *s,
+        double *a)
+{
+    assert(kc);
+    assert(q);
+    assert(qd);
+    assert(frame);
+    assert(s);
+    assert(a);
+    assert(s->nbody == kc->number_of_segments);
+    assert(frame->body >= 0 && frame->body <= kc->number_of_segments);
+
+    const int B = frame->body;
+
+    for (int k = 0; k < 6; k++) a[k] = 0.0;
+    if (B == 0) return;
+
+    kcc_fpk_incremental(kc, q, s);
+
+    // Bodies after the frame's cannot be on its path
+    for (int i = 1; i < B + 1; i++) {
+        const struct kcc_joint *joint = &kc->segment[i - 1].joint;
+        const struct kcc_joint_operators *op = joint_operators(joint);
+        const int p = parent_body(kc, i);
+        const int id = s->id[i - 1];
+
+        // Xd_{J,i} = S qd
+        op->fvk(joint, &qd[id], &s->xd_jnt[i - 1]);
+
+        // Xdd_{bias,i} needs Xd_i, which is only Xd_{J,i} on the base
+        if (p == 0) {
+            *s->xd[i].angular_velocity = *s->xd_jnt[i - 1].angular_velocity;
+            *s->xd[i].linear_velocity = *s->xd_jnt[i - 1].linear_velocity;
+        } else {
+            // Xd_i = i^X_{p(i)} Xd_{p(i)} + Xd_{J,i}
+            gc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xd[p], &s->xd_tf[i - 1]);
+            gc_twist_accumulate(&s->xd_tf[i - 1], &s->xd_jnt[i - 1], &s->xd[i]);
+        }
+
+        // Xdd_{bias,i} = Sd_i qd_i + Xd_i x S_i qd_i
+        op->inertial_acceleration(joint, &s->xd[i], &qd[id], &s->xdd_bias[i - 1]);
+
+        if (p == 0) {
+            *s->xdd[i].angular_acceleration = *s->xdd_bias[i - 1].angular_acceleration;
+            *s->xdd[i].linear_acceleration = *s->xdd_bias[i - 1].linear_acceleration;
+        } else {
+            // Xdd_i = i^X_{p(i)} Xdd_{p(i)} + Xdd_{bias,i}
+            gc_acc_twist_tf_ref_to_tgt(&s->x_rel[i - 1], &s->xdd[p], &s->xdd_tf[i - 1]);
+            gc_acc_twist_accumulate(&s->xdd_tf[i - 1], &s->xdd_bias[i - 1], &s->xdd[i]);
+        }
+    }
+
+    // The acceleration twist of the frame's body in the frame's coordinates
+    // (body) or the base's (spatial); the spatial acceleration twist of a
+    // rigidly attached frame is that of its body. Acceleration twists
+    // transform like twists.
+    struct gc_twist xdd = {
+        .angular_velocity = s->xdd[B].angular_acceleration,
+        .linear_velocity = s->xdd[B].linear_acceleration
+    };
+    struct gc_twist r = jacobian_column(a, 0);
+
+    if (type == JACOBIAN_SPATIAL) {
+        gc_twist_tf_tgt_to_ref(&s->x_tot[B], &xdd, &r);
+    } else if (frame->pose) {
+        gc_twist_tf_ref_to_tgt(frame->pose, &xdd, &r);
+    } else {
+        *r.angular_velocity = *xdd.angular_velocity;
+        *r.linear_velocity = *xdd.linear_velocity;
+    }
+}
+
+
+void kcc_aba_lanes(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s)
+{
+    assert(kc);
+    assert(s);
+    assert(s->nbody == kc->number_of_segments);
+
+    switch (la_get_isa()) {
+#ifdef DYN2B_SIMD_X86
+        case LA_ISA_AVX512:
+            kcc_aba_lanes_avx512(kc, s);
+            break;
+        case LA_ISA_AVX2:
+            kcc_aba_lanes_avx2(kc, s);
+            break;
+#endif
+        default:
+            kcc_aba_lanes_generic(kc, s);
+            break;
+    }
+}
+
+
+void kcc_aba_batch(
+        const struct kcc_kinematic_chain *kc,
+        int count,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const joint_torque *tau,
+        const struct gc_acc_twist *xdd_base,
+        struct solver_state_lanes_c *s,
+        joint_acceleration *qdd)
+{
+    assert(kc);
+    assert(count >= 0);
+    assert(q);
+    assert(qd);
+    assert(tau);
+    assert(s);
+    assert(qdd);
+    assert(s->nbody == kc->number_of_segments);
+
+    const int NQ = s->nq;
+    const int ND = s->nd;
+
+    for (int j = 0; j < 3; j++) {
+        double w = xdd_base ? xdd_base->angular_acceleration->data[j] : 0.0;
+        double v = xdd_base ? xdd_base->linear_acceleration->data[j] : 0.0;
+
+        for (int l = 0; l < LA_LANES; l++) {
+            s->xd[0].angular_velocity.data[j][l] = 0.0;
+            s->xd[0].linear_velocity.data[j][l] = 0.0;
+            s->xdd[0].angular_acceleration.data[j][l] = w;
+            s->xdd[0].linear_acceleration.data[j][l] = v;
+        }
+    }
+
+    for (int first = 0; first < count; first += LA_LANES) {
+        int lanes = count - first < LA_LANES ? count - first : LA_LANES;
+
+        // Transpose the block into the lanes
+        for (int l = 0; l < LA_LANES; l++) {
+            int sample = first + (l < lanes ? l : lanes - 1);
+
+            for (int j = 0; j < NQ; j++) {
+                s->q[j][l] = q[sample * NQ + j];
+            }
+            for (int j = 0; j < ND; j++) {
+                s->qd[j][l] = qd[sample * ND + j];
+                s->tau[j][l] = tau[sample * ND + j];
+            }
+        }
+
+        kcc_aba_lanes(kc, s);
+
+        for (int l = 0; l < lanes; l++) {
+            for (int j = 0; j < ND; j++) {
+                qdd[(first + l) * ND + j] = s->qdd[j][l];
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef DYN2B_SOLVER_JOINT_H
+#define DYN2B_SOLVER_JOINT_H
+
+#include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/types/solver_state.h>
+
+/**
+ * The joint stage that the sweeps share.
+ */
+
+// Operators resolved by kcc_compile() or, if the joint is not compiled, the
+// generic ones
+static inline const struct kcc_joint_operators *joint_operators(
+        const struct kcc_joint *joint)
+{
+    return joint->operators ? joint->operators : &kcc_joint[joint->type];
+}
+
+
+// X_{J,i} and i^X_{p(i)} = X_{J,i} X_{T,i} of body i, whose joint positions
+// start at q[iq]. The cosines and sines of kcc_sincos() are used if they were
+// evaluated at the same positions.
+static inline void joint_fpk_compose(
+        const struct kcc_kinematic_chain *kc,
+        const struct kcc_joint_operators *op,
+        const joint_position *q,
+        struct solver_state_c *s,
+        int i,
+        int iq)
+{
+    const struct kcc_segment *segment = &kc->segment[i - 1];
+    const struct kcc_joint *joint = &segment->joint;
+
+    if (op->fpk_compose_trig) {
+        int cached = 1;
+        for (int k = 0; k < op->nq; k++) cached &= q[iq + k] == s->q_trig[iq + k];
+
+        if (cached) {
+            op->fpk_compose_trig(joint, &s->cos_q[iq], &s->sin_q[iq],
+                    &segment->joint_attachment, &s->x_jnt[i - 1], &s->x_rel[i - 1]);
+            return;
+        }
+    }
+
+    op->fpk_compose(joint, &q[iq], &segment->joint_attachment,
+            &s->x_jnt[i - 1], &s->x_rel[i - 1]);
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef DYN2B_SOLVER_LANES_H
+#define DYN2B_SOLVER_LANES_H
+
+#include <dyn2b/types/kinematic_chain.h>
+#include <dyn2b/types/solver_state.h>
+
+/**
+ * Per-instruction-set builds of the lane-parallel articulated-body algorithm
+ * (see solver_lanes_block.h). kcc_aba_lanes() dispatches to them.
+ */
+void kcc_aba_lanes_generic(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s);
+
+void kcc_aba_lanes_avx2(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s);
+
+void kcc_aba_lanes_avx512(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s);
+
+#endif
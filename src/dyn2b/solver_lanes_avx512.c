@@ -0,0 +1,2 @@
+#define SOLVER_LANES_BLOCK kcc_aba_lanes_avx512
+#include "solver_lanes_block.h"
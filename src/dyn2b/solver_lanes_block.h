@@ -0,0 +1,462 @@
+/**
+ * Articulated-body algorithm on LA_LANES instances of a chain at once.
+ *
+ * This file is included once per instruction set with SOLVER_LANES_BLOCK set
+ * to the name of the generated function. Every scalar operation of the
+ * recurrence is a loop over the lanes with a compile-time trip count, which
+ * the compiler maps onto the target's vector registers.
+ */
+
+#include "solver_lanes.h"
+
+#include <math.h>
+#include <assert.h>
+
+
+#define L LA_LANES
+#define LANES for (int l = 0; l < L; l++)
+
+
+// r = E_J E_T, with E_J the rotation about the joint axis k (see rev_fpk)
+static void lanes_rev_rotation(
+        int k,
+        const double *restrict q,
+        const struct matrix3x3 *restrict et,
+        struct matrix3x3_lanes *restrict r)
+{
+    int a = (k + 1) % 3;
+    int b = (k + 2) % 3;
+
+    double cq[L];
+    double sq[L];
+    LANES {
+        cq[l] = cos(q[l]);
+        sq[l] = sin(q[l]);
+    }
+
+    for (int j = 0; j < 3; j++) {
+        double tk = et->row[k].data[j];
+        double ta = et->row[a].data[j];
+        double tb = et->row[b].data[j];
+
+        LANES {
+            r->row[k].data[j][l] = tk;
+            r->row[a].data[j][l] =  cq[l] * ta + sq[l] * tb;
+            r->row[b].data[j][l] = -sq[l] * ta + cq[l] * tb;
+        }
+    }
+}
+
+
+// r = x1 x x2
+static void lanes_cross(
+        const struct vector3_lanes *restrict x1,
+        const struct vector3_lanes *restrict x2,
+        struct vector3_lanes *restrict r)
+{
+    LANES {
+        r->x[l] = x1->y[l] * x2->z[l] - x1->z[l] * x2->y[l];
+        r->y[l] = x1->z[l] * x2->x[l] - x1->x[l] * x2->z[l];
+        r->z[l] = x1->x[l] * x2->y[l] - x1->y[l] * x2->x[l];
+    }
+}
+
+
+// r = E x
+static void lanes_gemv_n(
+        const struct matrix3x3_lanes *restrict e,
+        const struct vector3_lanes *restrict x,
+        struct vector3_lanes *restrict r)
+{
+    for (int i = 0; i < 3; i++) {
+        LANES {
+            r->data[i][l] = e->row[i].x[l] * x->x[l]
+                          + e->row[i].y[l] * x->y[l]
+                          + e->row[i].z[l] * x->z[l];
+        }
+    }
+}
+
+
+// r = E^T x
+static void lanes_gemv_t(
+        const struct matrix3x3_lanes *restrict e,
+        const struct vector3_lanes *restrict x,
+        struct vector3_lanes *restrict r)
+{
+    for (int i = 0; i < 3; i++) {
+        LANES {
+            r->data[i][l] = e->row_x.data[i][l] * x->x[l]
+                          + e->row_y.data[i][l] * x->y[l]
+                          + e->row_z.data[i][l] * x->z[l];
+        }
+    }
+}
+
+
+// r = E^T A E
+static void lanes_congr(
+        const struct matrix3x3_lanes *restrict e,
+        const struct matrix3x3_lanes *restrict a,
+        struct matrix3x3_lanes *restrict r)
+{
+    struct matrix3x3_lanes ae;
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            LANES {
+                ae.row[i].data[j][l] = a->row[i].x[l] * e->row_x.data[j][l]
+                                     + a->row[i].y[l] * e->row_y.data[j][l]
+                                     + a->row[i].z[l] * e->row_z.data[j][l];
+            }
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            LANES {
+                r->row[i].data[j][l] = e->row_x.data[i][l] * ae.row_x.data[j][l]
+                                     + e->row_y.data[i][l] * ae.row_y.data[j][l]
+                                     + e->row_z.data[i][l] * ae.row_z.data[j][l];
+            }
+        }
+    }
+}
+
+
+// Xd' = X Xd (see gc_twist_tf_ref_to_tgt)
+static void lanes_motion_tf_ref_to_tgt(
+        const struct gc_pose_lanes *restrict x,
+        const struct vector3_lanes *restrict w,
+        const struct vector3_lanes *restrict v,
+        struct vector3_lanes *restrict rw,
+        struct vector3_lanes *restrict rv)
+{
+    struct vector3_lanes rxw;
+    struct vector3_lanes v_rxw;
+
+    lanes_cross(&x->translation, w, &rxw);
+    for (int i = 0; i < 3; i++) {
+        LANES v_rxw.data[i][l] = v->data[i][l] - rxw.data[i][l];
+    }
+
+    lanes_gemv_n(&x->rotation, w, rw);
+    lanes_gemv_n(&x->rotation, &v_rxw, rv);
+}
+
+
+// F' += X^T F (see mc_wrench_tf_tgt_to_ref)
+static void lanes_wrench_tf_tgt_to_ref_add(
+        const struct gc_pose_lanes *restrict x,
+        const struct mc_wrench_lanes *restrict f,
+        struct mc_wrench_lanes *restrict r)
+{
+    struct vector3_lanes etf;
+    struct vector3_lanes etn;
+    struct vector3_lanes rxetf;
+
+    lanes_gemv_t(&x->rotation, &f->force, &etf);
+    lanes_gemv_t(&x->rotation, &f->torque, &etn);
+    lanes_cross(&x->translation, &etf, &rxetf);
+
+    for (int i = 0; i < 3; i++) {
+        LANES {
+            r->force.data[i][l] += etf.data[i][l];
+            r->torque.data[i][l] += etn.data[i][l] + rxetf.data[i][l];
+        }
+    }
+}
+
+
+// M' += X^T M X (see mc_abi_tf_tgt_to_ref)
+static void lanes_abi_tf_tgt_to_ref_add(
+        const struct gc_pose_lanes *restrict x,
+        const struct mc_abi_lanes *restrict m,
+        struct mc_abi_lanes *restrict r)
+{
+    const struct vector3_lanes *t = &x->translation;
+
+    // M' = E^T M E
+    struct matrix3x3_lanes etme;
+    lanes_congr(&x->rotation, &m->zeroth_moment_of_mass, &etme);
+
+    // H' = E^T H E + rx M'
+    struct matrix3x3_lanes ethe;
+    struct matrix3x3_lanes h;
+    lanes_congr(&x->rotation, &m->first_moment_of_mass, &ethe);
+    for (int j = 0; j < 3; j++) {
+        LANES {
+            h.row_x.data[j][l] = ethe.row_x.data[j][l]
+                    + t->y[l] * etme.row_z.data[j][l] - t->z[l] * etme.row_y.data[j][l];
+            h.row_y.data[j][l] = ethe.row_y.data[j][l]
+                    + t->z[l] * etme.row_x.data[j][l] - t->x[l] * etme.row_z.data[j][l];
+            h.row_z.data[j][l] = ethe.row_z.data[j][l]
+                    + t->x[l] * etme.row_y.data[j][l] - t->y[l] * etme.row_x.data[j][l];
+        }
+    }
+
+    // I' = E^T I E + rx (E^T H E)^T - H' rx
+    struct matrix3x3_lanes etie;
+    lanes_congr(&x->rotation, &m->second_moment_of_mass, &etie);
+    for (int i = 0; i < 3; i++) {
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+
+        for (int j = 0; j < 3; j++) {
+            int j1 = (j + 1) % 3;
+            int j2 = (j + 2) % 3;
+
+            LANES {
+                // rx (E^T H E)^T: column j is r x (row j of E^T H E)
+                double rxet = t->data[i1][l] * ethe.row[j].data[i2][l]
+                            - t->data[i2][l] * ethe.row[j].data[i1][l];
+
+                // H' rx: row i is (row i of H') x r
+                double hrx = h.row[i].data[j1][l] * t->data[j2][l]
+                           - h.row[i].data[j2][l] * t->data[j1][l];
+
+                r->second_moment_of_mass.row[i].data[j][l] += etie.row[i].data[j][l] + rxet - hrx;
+            }
+        }
+    }
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            LANES {
+                r->zeroth_moment_of_mass.row[i].data[j][l] += etme.row[i].data[j][l];
+                r->first_moment_of_mass.row[i].data[j][l] += h.row[i].data[j][l];
+            }
+        }
+    }
+}
+
+
+void SOLVER_LANES_BLOCK(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s)
+{
+    const int NR_SEGMENTS = kc->number_of_segments;
+
+    for (int i = 1; i < NR_SEGMENTS + 1; i++) {
+        const struct kcc_segment *segment = &kc->segment[i - 1];
+        const struct mc_rbi *rbi = &segment->link.inertia;
+        assert(segment->joint.type == JOINT_TYPE_REVOLUTE);
+
+        const int k = segment->joint.revolute_joint.axis;
+        const int a = (k + 1) % 3;
+        const int b = (k + 2) % 3;
+        const double *q = s->q[i - 1];
+        const double *qd = s->qd[i - 1];
+        const int parent = kc->parent ? kc->parent[i - 1] + 1 : i - 1;
+
+        struct gc_pose_lanes *x = &s->x_rel[i - 1];
+        struct gc_twist_lanes *xd = &s->xd[i];
+        struct gc_acc_twist_lanes *xdd_bias = &s->xdd_bias[i - 1];
+        struct mc_abi_lanes *m = &s->m_art[i];
+        struct mc_wrench_lanes *f = &s->f_bias_art[i];
+
+        // Position
+        //
+
+        // i^X_{i-1} = X_{J,i} X_{T,i}
+        lanes_rev_rotation(k, q, segment->joint_attachment.rotation, &x->rotation);
+        for (int j = 0; j < 3; j++) {
+            LANES x->translation.data[j][l] = segment->joint_attachment.translation->data[j];
+        }
+
+
+        // Velocity
+        //
+
+        // Xd_i = i^X_{p(i)} Xd_{p(i)} + S_i qd_i
+        lanes_motion_tf_ref_to_tgt(x,
+                &s->xd[parent].angular_velocity, &s->xd[parent].linear_velocity,
+                &xd->angular_velocity, &xd->linear_velocity);
+        LANES xd->angular_velocity.data[k][l] += qd[l];
+
+
+        // Acceleration
+        //
+
+        // Xdd_{bias,i} = Xd_i x S_i qd_i
+        LANES {
+            xdd_bias->angular_acceleration.data[k][l] = 0.0;
+            xdd_bias->angular_acceleration.data[a][l] =  xd->angular_velocity.data[b][l] * qd[l];
+            xdd_bias->angular_acceleration.data[b][l] = -xd->angular_velocity.data[a][l] * qd[l];
+            xdd_bias->linear_acceleration.data[k][l] = 0.0;
+            xdd_bias->linear_acceleration.data[a][l] =  xd->linear_velocity.data[b][l] * qd[l];
+            xdd_bias->linear_acceleration.data[b][l] = -xd->linear_velocity.data[a][l] * qd[l];
+        }
+
+
+        // Inertia
+        //
+
+        // M_i^A = M_i
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                double m0 = (r == c) ? rbi->zeroth_moment_of_mass : 0.0;
+                double m2 = rbi->second_moment_of_mass.row[r].data[c];
+                LANES {
+                    m->zeroth_moment_of_mass.row[r].data[c][l] = m0;
+                    m->second_moment_of_mass.row[r].data[c][l] = m2;
+                }
+            }
+        }
+        const double *h = rbi->first_moment_of_mass.data;
+        for (int r = 0; r < 3; r++) {
+            LANES m->first_moment_of_mass.row[r].data[r][l] = 0.0;
+        }
+        LANES {
+            m->first_moment_of_mass.row_x.y[l] = -h[2];
+            m->first_moment_of_mass.row_x.z[l] =  h[1];
+            m->first_moment_of_mass.row_y.x[l] =  h[2];
+            m->first_moment_of_mass.row_y.z[l] = -h[0];
+            m->first_moment_of_mass.row_z.x[l] = -h[1];
+            m->first_moment_of_mass.row_z.y[l] =  h[0];
+        }
+
+
+        // Force
+        //
+
+        // P_i = M_i Xd_i: n = I w + h x v, f = m v - h x w
+        struct vector3_lanes n;
+        struct vector3_lanes p;
+        for (int r = 0; r < 3; r++) {
+            const double *ir = rbi->second_moment_of_mass.row[r].data;
+            int r1 = (r + 1) % 3;
+            int r2 = (r + 2) % 3;
+            LANES {
+                n.data[r][l] = ir[0] * xd->angular_velocity.x[l]
+                             + ir[1] * xd->angular_velocity.y[l]
+                             + ir[2] * xd->angular_velocity.z[l]
+                             + h[r1] * xd->linear_velocity.data[r2][l]
+                             - h[r2] * xd->linear_velocity.data[r1][l];
+                p.data[r][l] = rbi->zeroth_moment_of_mass * xd->linear_velocity.data[r][l]
+                             - h[r1] * xd->angular_velocity.data[r2][l]
+                             + h[r2] * xd->angular_velocity.data[r1][l];
+            }
+        }
+
+        // F_{bias,i}^A = Xd_i x* P_i: n' = w x n + v x f, f' = w x f
+        struct vector3_lanes wxn;
+        struct vector3_lanes vxf;
+        lanes_cross(&xd->angular_velocity, &n, &wxn);
+        lanes_cross(&xd->linear_velocity, &p, &vxf);
+        lanes_cross(&xd->angular_velocity, &p, &f->force);
+        for (int r = 0; r < 3; r++) {
+            LANES f->torque.data[r][l] = wxn.data[r][l] + vxf.data[r][l];
+        }
+    }
+
+
+    for (int i = NR_SEGMENTS; i > 0; i--) {
+        const struct kcc_joint *joint = &kc->segment[i - 1].joint;
+        const int k = joint->revolute_joint.axis;
+        const double ia = joint->revolute_joint.inertia[0];
+        const int parent = kc->parent ? kc->parent[i - 1] + 1 : i - 1;
+
+        struct mc_abi_lanes *m = &s->m_art[i];
+        struct mc_wrench_lanes *f = &s->f_bias_art[i];
+        struct mc_wrench_lanes *u = &s->m_jnt[i - 1];
+        double *d = s->d[i - 1];
+        double *tau_ctrl = s->tau_ctrl[i - 1];
+
+        // U_i = M_i^A S_i, D_i = S_i^T M_i^A S_i + I_J, u_i = tau_i - S_i^T F_{bias,i}^A
+        for (int r = 0; r < 3; r++) {
+            LANES {
+                u->torque.data[r][l] = m->second_moment_of_mass.row[r].data[k][l];
+                u->force.data[r][l] = m->first_moment_of_mass.row[k].data[r][l];
+            }
+        }
+        LANES {
+            d[l] = m->second_moment_of_mass.row[k].data[k][l] + ia;
+            tau_ctrl[l] = s->tau[i - 1][l] - f->torque.data[k][l];
+        }
+
+        // The base does not move, hence nothing has to be propagated to it
+        if (parent == 0) continue;
+
+
+        // Inertia
+        //
+
+        // M_i^a = M_i^A - U_i D_i^{-1} U_i^T
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                LANES {
+                    double un_r = u->torque.data[r][l] / d[l];
+                    double uf_r = u->force.data[r][l] / d[l];
+                    m->zeroth_moment_of_mass.row[r].data[c][l] -= uf_r * u->force.data[c][l];
+                    m->first_moment_of_mass.row[r].data[c][l] -= un_r * u->force.data[c][l];
+                    m->second_moment_of_mass.row[r].data[c][l] -= un_r * u->torque.data[c][l];
+                }
+            }
+        }
+
+
+        // Force
+        //
+
+        // F_i^a = F_{bias,i}^A + M_i^a Xdd_{bias,i} + U_i D_i^{-1} u_i
+        const struct gc_acc_twist_lanes *c = &s->xdd_bias[i - 1];
+        struct mc_wrench_lanes fa;
+        for (int r = 0; r < 3; r++) {
+            LANES {
+                double qdd = tau_ctrl[l] / d[l];
+                double n = f->torque.data[r][l] + u->torque.data[r][l] * qdd;
+                double p = f->force.data[r][l] + u->force.data[r][l] * qdd;
+                for (int j = 0; j < 3; j++) {
+                    n += m->second_moment_of_mass.row[r].data[j][l] * c->angular_acceleration.data[j][l]
+                       + m->first_moment_of_mass.row[r].data[j][l] * c->linear_acceleration.data[j][l];
+                    p += m->zeroth_moment_of_mass.row[r].data[j][l] * c->linear_acceleration.data[j][l]
+                       + m->first_moment_of_mass.row[j].data[r][l] * c->angular_acceleration.data[j][l];
+                }
+                fa.torque.data[r][l] = n;
+                fa.force.data[r][l] = p;
+            }
+        }
+
+        // M_{p(i)}^A += {p(i)}^X_i* M_i^a i^X_{p(i)}
+        lanes_abi_tf_tgt_to_ref_add(&s->x_rel[i - 1], m, &s->m_art[parent]);
+
+        // F_{p(i)}^A += {p(i)}^X_i* F_i^a
+        lanes_wrench_tf_tgt_to_ref_add(&s->x_rel[i - 1], &fa, &s->f_bias_art[parent]);
+    }
+
+
+    for (int i = 1; i < NR_SEGMENTS + 1; i++) {
+        const int k = kc->segment[i - 1].joint.revolute_joint.axis;
+        const int parent = kc->parent ? kc->parent[i - 1] + 1 : i - 1;
+
+        const struct mc_wrench_lanes *u = &s->m_jnt[i - 1];
+        const struct gc_acc_twist_lanes *c = &s->xdd_bias[i - 1];
+        struct gc_acc_twist_lanes *xdd = &s->xdd[i];
+        double *qdd = s->qdd[i - 1];
+
+        // Xdd_i' = i^X_{p(i)} Xdd_{p(i)} + Xdd_{bias,i}
+        lanes_motion_tf_ref_to_tgt(&s->x_rel[i - 1],
+                &s->xdd[parent].angular_acceleration, &s->xdd[parent].linear_acceleration,
+                &xdd->angular_acceleration, &xdd->linear_acceleration);
+        for (int r = 0; r < 3; r++) {
+            LANES {
+                xdd->angular_acceleration.data[r][l] += c->angular_acceleration.data[r][l];
+                xdd->linear_acceleration.data[r][l] += c->linear_acceleration.data[r][l];
+            }
+        }
+
+        // qdd_i = D_i^{-1} (u_i - U_i^T Xdd_i')
+        LANES {
+            double uxdd = 0.0;
+            for (int r = 0; r < 3; r++) {
+                uxdd += u->torque.data[r][l] * xdd->angular_acceleration.data[r][l]
+                      + u->force.data[r][l] * xdd->linear_acceleration.data[r][l];
+            }
+            qdd[l] = (s->tau_ctrl[i - 1][l] - uxdd) / s->d[i - 1][l];
+        }
+
+        // Xdd_i = Xdd_i' + S_i qdd_i
+        LANES xdd->angular_acceleration.data[k][l] += qdd[l];
+    }
+}
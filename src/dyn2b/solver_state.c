@@ -0,0 +1,382 @@
+#include <dyn2b/functions/solver_state.h>
+#include <dyn2b/functions/kinematic_chain.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+
+/**
+ * Bump allocator over the solver state's arena. Without a base address it only
+ * measures the required size.
+ */
+struct arena
+{
+    char *base;
+    size_t offset;
+};
+
+
+static void *arena_alloc(
+        struct arena *a,
+        size_t size)
+{
+    size_t offset = (a->offset + SOLVER_STATE_ALIGNMENT - 1)
+            & ~((size_t)SOLVER_STATE_ALIGNMENT - 1);
+
+    a->offset = offset + size;
+
+    return a->base ? a->base + offset : NULL;
+}
+
+
+static struct gc_pose *arena_alloc_pose(
+        struct arena *a,
+        int count)
+{
+    struct gc_pose *x = arena_alloc(a, count * sizeof(struct gc_pose));
+    struct matrix3x3 *rotation = arena_alloc(a, count * sizeof(struct matrix3x3));
+    struct vector3 *translation = arena_alloc(a, count * sizeof(struct vector3));
+
+    if (!a->base) return x;
+
+    for (int i = 0; i < count; i++) {
+        x[i].rotation = &rotation[i];
+        x[i].translation = &translation[i];
+    }
+
+    return x;
+}
+
+
+static struct gc_twist *arena_alloc_twist(
+        struct arena *a,
+        int count)
+{
+    struct gc_twist *xd = arena_alloc(a, count * sizeof(struct gc_twist));
+    struct vector3 *angular = arena_alloc(a, count * sizeof(struct vector3));
+    struct vector3 *linear = arena_alloc(a, count * sizeof(struct vector3));
+
+    if (!a->base) return xd;
+
+    for (int i = 0; i < count; i++) {
+        xd[i].angular_velocity = &angular[i];
+        xd[i].linear_velocity = &linear[i];
+    }
+
+    return xd;
+}
+
+
+static struct gc_acc_twist *arena_alloc_acc_twist(
+        struct arena *a,
+        int count)
+{
+    struct gc_acc_twist *xdd = arena_alloc(a, count * sizeof(struct gc_acc_twist));
+    struct vector3 *angular = arena_alloc(a, count * sizeof(struct vector3));
+    struct vector3 *linear = arena_alloc(a, count * sizeof(struct vector3));
+
+    if (!a->base) return xdd;
+
+    for (int i = 0; i < count; i++) {
+        xdd[i].angular_acceleration = &angular[i];
+        xdd[i].linear_acceleration = &linear[i];
+    }
+
+    return xdd;
+}
+
+
+static struct mc_momentum *arena_alloc_momentum(
+        struct arena *a,
+        int count)
+{
+    struct mc_momentum *p = arena_alloc(a, count * sizeof(struct mc_momentum));
+    struct vector3 *angular = arena_alloc(a, count * sizeof(struct vector3));
+    struct vector3 *linear = arena_alloc(a, count * sizeof(struct vector3));
+
+    if (!a->base) return p;
+
+    for (int i = 0; i < count; i++) {
+        p[i].angular_momentum = &angular[i];
+        p[i].linear_momentum = &linear[i];
+    }
+
+    return p;
+}
+
+
+static struct mc_wrench *arena_alloc_wrench(
+        struct arena *a,
+        int count)
+{
+    struct mc_wrench *f = arena_alloc(a, count * sizeof(struct mc_wrench));
+    struct vector3 *torque = arena_alloc(a, count * sizeof(struct vector3));
+    struct vector3 *force = arena_alloc(a, count * sizeof(struct vector3));
+
+    if (!a->base) return f;
+
+    for (int i = 0; i < count; i++) {
+        f[i].torque = &torque[i];
+        f[i].force = &force[i];
+    }
+
+    return f;
+}
+
+
+static void solver_state_layout_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        struct arena *a)
+{
+    const int NR_SEGMENTS = kc->number_of_segments;
+    const int NR_SEGMENTS_WITH_BASE = NR_SEGMENTS + 1;
+
+    s->nbody = NR_SEGMENTS;
+    kcc_dimensions(kc, &s->nq, &s->nd);
+
+    // FPK
+    s->x_jnt = arena_alloc_pose(a, NR_SEGMENTS);
+    s->x_rel = arena_alloc_pose(a, NR_SEGMENTS);
+    s->x_tot = arena_alloc_pose(a, NR_SEGMENTS_WITH_BASE);
+    // FVK
+    s->xd_jnt = arena_alloc_twist(a, NR_SEGMENTS);
+    s->xd_tf  = arena_alloc_twist(a, NR_SEGMENTS);
+    s->xd     = arena_alloc_twist(a, NR_SEGMENTS_WITH_BASE);
+    // FAK
+    s->xdd_jnt  = arena_alloc_acc_twist(a, NR_SEGMENTS);
+    s->xdd_bias = arena_alloc_acc_twist(a, NR_SEGMENTS);
+    s->xdd_net  = arena_alloc_acc_twist(a, NR_SEGMENTS);
+    s->xdd_tf   = arena_alloc_acc_twist(a, NR_SEGMENTS_WITH_BASE);
+    s->xdd_nact = arena_alloc_acc_twist(a, NR_SEGMENTS);
+    s->xdd      = arena_alloc_acc_twist(a, NR_SEGMENTS_WITH_BASE);
+    // Joint motion state
+    s->q   = arena_alloc(a, s->nq * sizeof(joint_position));
+    s->qd  = arena_alloc(a, s->nd * sizeof(joint_velocity));
+    s->qdd = arena_alloc(a, s->nd * sizeof(joint_acceleration));
+    s->iq  = arena_alloc(a, NR_SEGMENTS * sizeof(int));
+    s->id  = arena_alloc(a, NR_SEGMENTS * sizeof(int));
+    // Pose cache
+    s->q_fpk   = arena_alloc(a, s->nq * sizeof(joint_position));
+    s->x_moved = arena_alloc(a, NR_SEGMENTS_WITH_BASE * sizeof(int));
+    // Joint trigonometry
+    s->q_trig = arena_alloc(a, s->nq * sizeof(joint_position));
+    s->sin_q  = arena_alloc(a, s->nq * sizeof(double));
+    s->cos_q  = arena_alloc(a, s->nq * sizeof(double));
+    // Inertia
+    s->m_art = arena_alloc(a, NR_SEGMENTS_WITH_BASE * sizeof(struct mc_abi_packed));
+    s->m_app = arena_alloc(a, NR_SEGMENTS * sizeof(struct mc_abi_packed));
+    s->m_tf  = arena_alloc(a, NR_SEGMENTS_WITH_BASE * sizeof(struct mc_abi_packed));
+    s->d     = arena_alloc(a, s->nd * sizeof(joint_inertia));
+    // Inertial force
+    s->p            = arena_alloc_momentum(a, NR_SEGMENTS);
+    s->f_bias_art   = arena_alloc_wrench(a, NR_SEGMENTS_WITH_BASE);
+    s->f_bias_eom   = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->f_bias_app   = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->f_bias_tf    = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->f_bias_nact  = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->tau_bias_art = arena_alloc(a, s->nd * sizeof(joint_torque));
+    // Feed-forward torque
+    s->tau_ff     = arena_alloc(a, s->nd * sizeof(joint_torque));
+    s->f_ff_art   = arena_alloc_wrench(a, NR_SEGMENTS_WITH_BASE);
+    s->f_ff_app   = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->f_ff_jnt   = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->tau_ff_art = arena_alloc(a, s->nd * sizeof(joint_torque));
+    // External force
+    s->f_ext       = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->f_ext_art   = arena_alloc_wrench(a, NR_SEGMENTS_WITH_BASE);
+    s->f_ext_app   = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->f_ext_tf    = arena_alloc_wrench(a, NR_SEGMENTS);
+    s->tau_ext_art = arena_alloc(a, s->nd * sizeof(joint_torque));
+    // Dynamics
+    s->tau_ctrl = arena_alloc(a, s->nd * sizeof(joint_torque));
+}
+
+
+size_t solver_state_size_c(
+        const struct kcc_kinematic_chain *kc)
+{
+    assert(kc);
+
+    struct solver_state_c s;
+    struct arena a = { .base = NULL, .offset = 0 };
+
+    solver_state_layout_c(kc, &s, &a);
+
+    return (a.offset + SOLVER_STATE_ALIGNMENT - 1)
+            & ~((size_t)SOLVER_STATE_ALIGNMENT - 1);
+}
+
+
+void solver_state_init_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        void *memory)
+{
+    assert(kc);
+    assert(s);
+    assert(memory);
+    assert(((size_t)memory & (SOLVER_STATE_ALIGNMENT - 1)) == 0);
+    assert(kc->verified || kcc_verify_coordinates(kc, NULL) == 0);
+
+    struct arena a = { .base = memory, .offset = 0 };
+
+    memset(memory, 0, solver_state_size_c(kc));
+    solver_state_layout_c(kc, s, &a);
+    s->x_valid = 0;
+    s->memory = NULL;
+
+    // FPK
+    s->x_tot[0].rotation->row_x.x = 1.0;
+    s->x_tot[0].rotation->row_y.y = 1.0;
+    s->x_tot[0].rotation->row_z.z = 1.0;
+
+    // No position matches the joint trigonometry before kcc_sincos()
+    for (int k = 0; k < s->nq; k++) s->q_trig[k] = NAN;
+
+    // Joint motion state
+    for (int i = 0, iq = 0, id = 0; i < s->nbody; i++) {
+        const struct kcc_joint_operators *op = &kcc_joint[kc->segment[i].joint.type];
+
+        s->iq[i] = iq;
+        s->id[i] = id;
+        iq += op->nq;
+        id += op->nd;
+    }
+}
+
+
+int solver_state_create_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s)
+{
+    assert(kc);
+    assert(s);
+
+    // A chain that was not verified when it was loaded is checked here, so that
+    // a mis-wired model is still caught before the first sweep
+    if (!kc->verified && kcc_verify_coordinates(kc, NULL) != 0) return -1;
+
+    void *memory = aligned_alloc(SOLVER_STATE_ALIGNMENT, solver_state_size_c(kc));
+    if (!memory) return -1;
+
+    solver_state_init_c(kc, s, memory);
+    s->memory = memory;
+
+    return 0;
+}
+
+
+void solver_state_destroy_c(
+        struct solver_state_c *s)
+{
+    assert(s);
+
+    free(s->memory);
+    memset(s, 0, sizeof(*s));
+}
+
+
+static void solver_state_layout_lanes_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s,
+        struct arena *a)
+{
+    const int NR_SEGMENTS = kc->number_of_segments;
+    const int NR_SEGMENTS_WITH_BASE = NR_SEGMENTS + 1;
+
+    s->nbody = NR_SEGMENTS;
+    kcc_dimensions(kc, &s->nq, &s->nd);
+
+    // Spatial motion state
+    s->x_rel    = arena_alloc(a, NR_SEGMENTS * sizeof(struct gc_pose_lanes));
+    s->xd       = arena_alloc(a, NR_SEGMENTS_WITH_BASE * sizeof(struct gc_twist_lanes));
+    s->xdd_bias = arena_alloc(a, NR_SEGMENTS * sizeof(struct gc_acc_twist_lanes));
+    s->xdd      = arena_alloc(a, NR_SEGMENTS_WITH_BASE * sizeof(struct gc_acc_twist_lanes));
+    // Joint motion state
+    s->q   = arena_alloc(a, s->nq * sizeof(*s->q));
+    s->qd  = arena_alloc(a, s->nd * sizeof(*s->qd));
+    s->qdd = arena_alloc(a, s->nd * sizeof(*s->qdd));
+    // Inertia
+    s->m_art = arena_alloc(a, NR_SEGMENTS_WITH_BASE * sizeof(struct mc_abi_lanes));
+    s->m_jnt = arena_alloc(a, NR_SEGMENTS * sizeof(struct mc_wrench_lanes));
+    s->d     = arena_alloc(a, s->nd * sizeof(*s->d));
+    // Force
+    s->f_bias_art = arena_alloc(a, NR_SEGMENTS_WITH_BASE * sizeof(struct mc_wrench_lanes));
+    s->tau        = arena_alloc(a, s->nd * sizeof(*s->tau));
+    s->tau_ctrl   = arena_alloc(a, s->nd * sizeof(*s->tau_ctrl));
+}
+
+
+size_t solver_state_size_lanes_c(
+        const struct kcc_kinematic_chain *kc)
+{
+    assert(kc);
+
+    struct solver_state_lanes_c s;
+    struct arena a = { .base = NULL, .offset = 0 };
+
+    solver_state_layout_lanes_c(kc, &s, &a);
+
+    return (a.offset + SOLVER_STATE_ALIGNMENT - 1)
+            & ~((size_t)SOLVER_STATE_ALIGNMENT - 1);
+}
+
+
+int solver_state_init_lanes_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s,
+        void *memory)
+{
+    assert(kc);
+    assert(s);
+    assert(memory);
+    assert(((size_t)memory & (SOLVER_STATE_ALIGNMENT - 1)) == 0);
+
+    // The lane solvers only implement revolute joints
+    for (int i = 0; i < kc->number_of_segments; i++) {
+        if (kc->segment[i].joint.type != JOINT_TYPE_REVOLUTE) return -1;
+    }
+
+    struct arena a = { .base = memory, .offset = 0 };
+
+    memset(memory, 0, solver_state_size_lanes_c(kc));
+    solver_state_layout_lanes_c(kc, s, &a);
+    s->memory = NULL;
+
+    return 0;
+}
+
+
+int solver_state_create_lanes_c(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_lanes_c *s)
+{
+    assert(kc);
+    assert(s);
+
+    if (!kc->verified && kcc_verify_coordinates(kc, NULL) != 0) return -1;
+
+    void *memory = aligned_alloc(SOLVER_STATE_ALIGNMENT, solver_state_size_lanes_c(kc));
+    if (!memory) return -1;
+
+    if (solver_state_init_lanes_c(kc, s, memory) != 0) {
+        free(memory);
+        return -1;
+    }
+    s->memory = memory;
+
+    return 0;
+}
+
+
+void solver_state_destroy_lanes_c(
+        struct solver_state_lanes_c *s)
+{
+    assert(s);
+
+    free(s->memory);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,64 @@
+#ifndef DYN2B_SOLVER_SUBTREE_H
+#define DYN2B_SOLVER_SUBTREE_H
+
+#include <dyn2b/types/kinematic_chain.h>
+#include <dyn2b/types/mechanics.h>
+#include <dyn2b/types/solver_state.h>
+
+/**
+ * The passes of kcc_aba() over a subset of a tree's bodies, so that disjoint
+ * subtrees can be solved concurrently on one solver state (see
+ * kcc_executor_aba_subtrees()). body lists count body indices in increasing
+ * order; a body's parent must have been visited before it in the outward
+ * passes and after it in the inward pass.
+ */
+
+/**
+ * First pass: positions, velocities, bias accelerations and forces, and the
+ * rigid-body inertias of the bodies. The poses are overwritten, hence the
+ * caller must invalidate the pose cache (s->x_valid) once before the passes
+ * of all subtrees start.
+ */
+void kcc_aba_outward(
+        const struct kcc_kinematic_chain *kc,
+        const joint_position *q,
+        const joint_velocity *qd,
+        const struct mc_wrench *f_ext,
+        struct solver_state_c *s,
+        const int *body,
+        int count);
+
+/**
+ * Second pass in reverse order: articulated-body inertias and bias forces.
+ * The bodies whose parent is join only prepare their contributions, which
+ * kcc_aba_join() adds to the parent later (join = -1 adds all of them).
+ */
+void kcc_aba_inward(
+        const struct kcc_kinematic_chain *kc,
+        const joint_torque *tau,
+        struct solver_state_c *s,
+        const int *body,
+        int count,
+        int join);
+
+/**
+ * Add the contributions of body i that kcc_aba_inward() prepared to its
+ * parent.
+ */
+void kcc_aba_join(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int i);
+
+/**
+ * Third pass: joint and link accelerations.
+ */
+void kcc_aba_accelerate(
+        const struct kcc_kinematic_chain *kc,
+        const joint_torque *tau,
+        struct solver_state_c *s,
+        const int *body,
+        int count,
+        joint_acceleration *qdd);
+
+#endif
@@ -1,6 +1,8 @@
 #include <dyn2b/functions/geometry.h>
 #include <dyn2b/functions/mechanics.h>
 #include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/solver.h>
+#include <dyn2b/functions/solver_state.h>
 #include <dyn2b/example/solver_state.h>
 #include <dyn2b/example/robots.h>
 #include <stdio.h>
@@ -238,7 +240,7 @@ void aba_c()
         //
 
         // M_i^A = M_i
-        mc_rbi_to_abi(&kc->segment[i - 1].link.inertia, &s.m_art[i]);
+        mc_rbi_to_abi_packed(&kc->segment[i - 1].link.inertia, &s.m_art[i]);
 
 
         // Force
@@ -248,7 +250,7 @@ void aba_c()
         mc_rbi_map_twist_to_momentum(&kc->segment[i - 1].link.inertia, &s.xd[i], &s.p[i - 1]);
 
         // F_{bias,i}^A = Xd_i x* P_i
-        mc_momentum_derive(&s.xd[i], &s.p[i - 1], &s.f_bias_art[i]);
+        mc_momentum_derive(&s.xd[i], &s.p[i - 1], &s.f_bias_art[i], 1);
 
 
         // F_{ext,i}^A = -F_{ext,i}
@@ -267,17 +269,17 @@ void aba_c()
         kcc_joint[joint_type].project_inertia(joint, &s.m_art[i], &s.m_app[i - 1]);
 
         // M_{i-1}^a' = {i-1}^X_i* M_i^a i^X_{i-1}
-        mc_abi_tf_tgt_to_ref(&s.x_rel[i - 1], &s.m_app[i - 1], &s.m_tf[i]);
+        mc_abi_packed_tf_tgt_to_ref(&s.x_rel[i - 1], &s.m_app[i - 1], &s.m_tf[i]);
 
         // M_{i-1}^A += M_{i-1}^a'
-        mc_abi_add(&s.m_art[i - 1], &s.m_tf[i], &s.m_art[i - 1]);
+        mc_abi_packed_add(&s.m_art[i - 1], &s.m_tf[i], &s.m_art[i - 1]);
 
 
         // Force
         //
 
         // F_{bias,i}^A' = M_i^A Xdd_{bias,i}
-        mc_abi_map_acc_twist_to_wrench(&s.m_art[i], &s.xdd_bias[i - 1], &s.f_bias_eom[i - 1]);
+        mc_abi_packed_map_acc_twist_to_wrench(&s.m_art[i], &s.xdd_bias[i - 1], &s.f_bias_eom[i - 1]);
 
         // F_{bias,i}^A' += F_{bias,i}^A
         mc_wrench_add(&s.f_bias_eom[i - 1], &s.f_bias_art[i], &s.f_bias_eom[i - 1], 1);
@@ -315,7 +317,7 @@ void aba_c()
         mc_wrench_add(&s.f_ext_art[i - 1], &s.f_ext_tf[i - 1], &s.f_ext_art[i - 1], 1);
     }
 
-    mc_abi_log(&s.m_art[0]);
+    mc_abi_packed_log(&s.m_art[0]);
     mc_wrench_log(&s.f_bias_art[0], 1);
     mc_wrench_log(&s.f_ff_art[0], 1);
     mc_wrench_log(&s.f_ext_art[0], 1);
@@ -339,7 +341,7 @@ void aba_c()
         //
 
         // F_{nact,i} = M_i^A Xdd_{nact,i-1}'
-        mc_abi_map_acc_twist_to_wrench(&s.m_art[i], &s.xdd_nact[i - 1], &s.f_bias_nact[i - 1]);
+        mc_abi_packed_map_acc_twist_to_wrench(&s.m_art[i], &s.xdd_nact[i - 1], &s.f_bias_nact[i - 1]);
 
         // tau_{bias,i}^A = S^T F_{bias,i}
         kcc_joint[joint_type].ifk(joint, &s.f_bias_nact[i - 1], &s.tau_bias_art[i - 1], 1);
@@ -356,7 +358,7 @@ void aba_c()
         // Solve
         //
         int k = joint->revolute_joint.axis;
-        double d = s.m_art[i].second_moment_of_mass.row[k].data[k] + joint->revolute_joint.inertia[0];
+        double d = s.m_art[i].second_moment_of_mass[MC_SYM33(k, k)] + joint->revolute_joint.inertia[0];
         s.tau_ctrl[i - 1] = s.tau_ff[i - 1] - s.tau_ff_art[i - 1] - s.tau_bias_art[i - 1] - s.tau_ext_art[i - 1];
         s.qdd[i - 1] = s.tau_ctrl[i - 1] / d;
 
@@ -375,6 +377,47 @@ void aba_c()
     }
 
     gc_acc_twist_log(&s.xdd[s.nbody]);
+
+    solver_state_destroy_c(&s);
+}
+
+
+void aba_solver()
+{
+    struct kcc_kinematic_chain *kc = &two_dof_robot_c;
+    struct solver_state_c s;
+    int segment;
+
+    // Check the model once instead of sweeping over its ADT in every cycle
+    if (kcc_verify(&two_dof_robot_a, kc, &segment) != 0) {
+        printf("inconsistent model at segment %i\n", segment);
+        return;
+    }
+
+    // ... and select the joints' operators once, too
+    if (kcc_compile(kc) != 0) {
+        printf("model with unmerged fixed joints\n");
+        return;
+    }
+
+    setup_simple_state_c(kc, &s);
+
+    s.q[0] = 1.0;
+    s.q[1] = 1.0;
+    s.qd[0] = 1.0;
+    s.qd[1] = 1.0;
+    s.f_ext[s.nbody - 1].force[0].x = 1.0;
+    s.f_ext[s.nbody - 1].force[0].y = 1.0;
+    s.f_ext[s.nbody - 1].force[0].z = 1.0;
+    s.tau_ff[0] = 1.0;
+    s.tau_ff[1] = 1.0;
+    s.xdd->linear_acceleration[0].z = 9.81;
+
+    kcc_aba(kc, s.q, s.qd, s.tau_ff, s.f_ext, &s, s.qdd);
+
+    gc_acc_twist_log(&s.xdd[s.nbody]);
+
+    solver_state_destroy_c(&s);
 }
 
 
@@ -382,6 +425,7 @@ int main(int argc, char **argv)
 {
     aba_a();
     aba_c();
+    aba_solver();
 
     return 0;
 }
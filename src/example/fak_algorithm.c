@@ -1,5 +1,6 @@
 #include <dyn2b/functions/geometry.h>
 #include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/solver_state.h>
 #include <dyn2b/example/solver_state.h>
 #include <dyn2b/example/robots.h>
 
@@ -123,6 +124,8 @@ void fak_c()
     }
 
     gc_acc_twist_log(&s.xdd[s.nbody]);
+
+    solver_state_destroy_c(&s);
 }
 
 
@@ -1,5 +1,6 @@
 #include <dyn2b/functions/geometry.h>
 #include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/solver_state.h>
 #include <dyn2b/example/solver_state.h>
 #include <dyn2b/example/robots.h>
 
@@ -61,6 +62,8 @@ void fpk_c()
     }
 
     gc_pose_log(&s.x_tot[s.nbody]);
+
+    solver_state_destroy_c(&s);
 }
 
 
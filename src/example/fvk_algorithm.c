@@ -1,5 +1,6 @@
 #include <dyn2b/functions/geometry.h>
 #include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/solver_state.h>
 #include <dyn2b/example/solver_state.h>
 #include <dyn2b/example/robots.h>
 
@@ -83,6 +84,8 @@ void fvk_c()
     }
 
     gc_twist_log(&s.xd[s.nbody]);
+
+    solver_state_destroy_c(&s);
 }
 
 
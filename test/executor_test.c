@@ -0,0 +1,307 @@
+#include <dyn2b/functions/executor.h>
+#include <dyn2b/functions/solver.h>
+#include <dyn2b/functions/solver_state.h>
+#include <check.h>
+#include <math.h>
+
+
+static struct kcc_segment segments[] = {
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = {
+                .axis = JOINT_AXIS_Z,
+                .inertia = (double [1]) { 1.0 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .first_moment_of_mass = { { 2.0, 0.0, 0.0 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.0, 0.0, 0.0 },
+                .row_y = { 0.0, 2.0, 0.0 },
+                .row_z = { 0.0, 0.0, 2.0 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 0.0, 0.0, -1.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 1.0, 0.0, 0.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 2.0, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = {
+                .axis = JOINT_AXIS_Y,
+                .inertia = (double [1]) { 0.5 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 1.0,
+            .first_moment_of_mass = { { 0.5, 0.0, 0.2 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.2, 0.0, 0.0 },
+                .row_y = { 0.0, 0.4, 0.0 },
+                .row_z = { 0.0, 0.0, 0.3 }
+            }
+        }
+    }
+};
+
+static struct kcc_kinematic_chain chain = {
+    .number_of_segments = 2,
+    .segment = segments
+};
+
+
+static void count_task(
+        const struct kcc_kinematic_chain *kc,
+        struct solver_state_c *s,
+        int index,
+        void *data)
+{
+    // Check's assertions must not fail outside of the test's thread
+    if (kc == &chain && s->nbody == 2) ((int *)data)[index]++;
+}
+
+
+START_TEST(test_kcc_executor_run)
+{
+    enum { COUNT = 1000 };
+
+    int nthreads[] = { 1, 3, 8 };
+    for (int k = 0; k < 3; k++) {
+        struct kcc_executor ex;
+        ck_assert_int_eq(kcc_executor_create(&chain, nthreads[k], &ex), 0);
+        ck_assert_int_eq(ex.nthreads, nthreads[k]);
+
+        // every index is processed exactly once, also when the executor is
+        // reused and for fewer samples than workers
+        int visited[COUNT] = { 0 };
+        kcc_executor_run(&ex, COUNT, 0, count_task, visited);
+        kcc_executor_run(&ex, COUNT, 7, count_task, visited);
+        kcc_executor_run(&ex, 2, 0, count_task, visited);
+        kcc_executor_run(&ex, 0, 0, count_task, visited);
+
+        for (int i = 0; i < COUNT; i++) {
+            ck_assert_int_eq(visited[i], i < 2 ? 3 : 2);
+        }
+
+        kcc_executor_destroy(&ex);
+        ck_assert_ptr_eq(ex.worker, NULL);
+    }
+}
+END_TEST
+
+
+START_TEST(test_kcc_executor_aba)
+{
+    enum { COUNT = 37, N = 2 };
+
+    struct solver_state_c s;
+    struct kcc_executor ex;
+    ck_assert_int_eq(solver_state_create_c(&chain, &s), 0);
+    ck_assert_int_eq(kcc_executor_create(&chain, 4, &ex), 0);
+
+    struct gc_acc_twist xdd_base = {
+        .angular_acceleration = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } },
+        .linear_acceleration = (struct vector3 [1]) { { 0.0, 9.81, 0.0 } }
+    };
+    *s.xdd[0].linear_acceleration = *xdd_base.linear_acceleration;
+
+    joint_position q[COUNT][N];
+    joint_velocity qd[COUNT][N];
+    joint_torque tau[COUNT][N];
+    struct vector3 torque[COUNT][N];
+    struct vector3 force[COUNT][N];
+    struct mc_wrench f_ext[COUNT];
+    for (int k = 0; k < COUNT; k++) {
+        for (int j = 0; j < N; j++) {
+            q[k][j] = sin(0.9 * k + j);
+            qd[k][j] = cos(1.1 * k - j);
+            tau[k][j] = 0.3 * k - 2.0 * j;
+            torque[k][j] = (struct vector3) { { 0.1 * j, 0.0, 0.01 * k } };
+            force[k][j] = (struct vector3) { { 0.0, 0.2, -0.1 * j } };
+        }
+        f_ext[k].torque = torque[k];
+        f_ext[k].force = force[k];
+    }
+
+    joint_acceleration qdd[COUNT][N];
+    joint_acceleration qdd_ext[COUNT][N];
+    kcc_executor_aba(&ex, COUNT, &q[0][0], &qd[0][0], &tau[0][0], NULL,
+            &xdd_base, &qdd[0][0]);
+    kcc_executor_aba(&ex, COUNT, &q[0][0], &qd[0][0], &tau[0][0], f_ext,
+            &xdd_base, &qdd_ext[0][0]);
+
+    for (int k = 0; k < COUNT; k++) {
+        joint_acceleration res[N];
+
+        kcc_aba(&chain, q[k], qd[k], tau[k], NULL, &s, res);
+        ck_assert(fabs(qdd[k][0] - res[0]) < 1e-12);
+        ck_assert(fabs(qdd[k][1] - res[1]) < 1e-12);
+
+        kcc_aba(&chain, q[k], qd[k], tau[k], &f_ext[k], &s, res);
+        ck_assert(fabs(qdd_ext[k][0] - res[0]) < 1e-12);
+        ck_assert(fabs(qdd_ext[k][1] - res[1]) < 1e-12);
+    }
+
+    // the inverse dynamics undo the forward dynamics
+    joint_torque tau_ext[COUNT][N];
+    kcc_executor_rnea(&ex, COUNT, &q[0][0], &qd[0][0], &qdd_ext[0][0], f_ext,
+            &xdd_base, &tau_ext[0][0]);
+    for (int k = 0; k < COUNT; k++) {
+        ck_assert(fabs(tau_ext[k][0] - tau[k][0]) < 1e-9);
+        ck_assert(fabs(tau_ext[k][1] - tau[k][1]) < 1e-9);
+    }
+
+    kcc_executor_destroy(&ex);
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+START_TEST(test_kcc_executor_aba_subtrees)
+{
+    enum { N = 8 };
+
+    // A trunk of two segments that branches into three subtrees, one of
+    // which branches again, and a tree that branches at the base
+    static int parent[2][N] = {
+        { -1, 0, 1, 1, 1, 3, 4, 2 },
+        { -1, -1, 0, 1, 1, 3, 2, 6 }
+    };
+    const int nsubtrees[2] = { 3, 2 };
+
+    struct kcc_segment tree_segments[N];
+    for (int i = 0; i < N; i++) tree_segments[i] = segments[i % 2];
+
+    joint_position q[N];
+    joint_velocity qd[N];
+    joint_torque tau[N];
+    struct vector3 torque[N];
+    struct vector3 force[N];
+    for (int j = 0; j < N; j++) {
+        q[j] = sin(0.9 + j);
+        qd[j] = cos(1.1 - j);
+        tau[j] = 0.3 - 0.2 * j;
+        torque[j] = (struct vector3) { { 0.1 * j, 0.0, 0.01 } };
+        force[j] = (struct vector3) { { 0.0, 0.2, -0.1 * j } };
+    }
+    struct mc_wrench f_ext = { .torque = torque, .force = force };
+
+    for (int t = 0; t < 2; t++) {
+        struct kcc_kinematic_chain tree = {
+            .number_of_segments = N,
+            .segment = tree_segments,
+            .parent = parent[t]
+        };
+
+        struct solver_state_c s, sp;
+        ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+        ck_assert_int_eq(solver_state_create_c(&tree, &sp), 0);
+        s.xdd[0].linear_acceleration->y = 9.81;
+        sp.xdd[0].linear_acceleration->y = 9.81;
+
+        joint_acceleration res[N];
+        kcc_aba(&tree, q, qd, tau, &f_ext, &s, res);
+
+        const int nthreads[] = { 1, 4 };
+        for (int k = 0; k < 2; k++) {
+            struct kcc_executor ex;
+            ck_assert_int_eq(kcc_executor_create(&tree, nthreads[k], &ex), 0);
+            ck_assert_int_eq(ex.nsubtrees, nsubtrees[t]);
+
+            // repeated calls start from a clean state
+            for (int r = 0; r < 3; r++) {
+                joint_acceleration qdd[N];
+                kcc_executor_aba_subtrees(&ex, q, qd, tau, &f_ext, &sp, qdd);
+                for (int j = 0; j < N; j++) {
+                    ck_assert(fabs(qdd[j] - res[j]) < 1e-12);
+                }
+            }
+
+            kcc_executor_destroy(&ex);
+        }
+
+        solver_state_destroy_c(&sp);
+        solver_state_destroy_c(&s);
+    }
+
+    // A serial chain has no subtrees
+    struct kcc_executor ex;
+    ck_assert_int_eq(kcc_executor_create(&chain, 2, &ex), 0);
+    ck_assert_int_eq(ex.nsubtrees, 0);
+    kcc_executor_destroy(&ex);
+}
+END_TEST
+
+
+START_TEST(test_kcc_executor_fpk)
+{
+    enum { N = 23 };
+
+    struct kcc_segment long_segments[N];
+    for (int i = 0; i < N; i++) long_segments[i] = segments[i % 2];
+    struct kcc_kinematic_chain long_chain = {
+        .number_of_segments = N,
+        .segment = long_segments
+    };
+
+    joint_position q[N];
+    for (int j = 0; j < N; j++) q[j] = sin(0.7 * j + 0.2);
+
+    struct solver_state_c s, sp;
+    ck_assert_int_eq(solver_state_create_c(&long_chain, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&long_chain, &sp), 0);
+    kcc_fpk(&long_chain, q, &s);
+
+    const int nthreads[] = { 1, 3, 4, 16 };
+    for (int k = 0; k < 4; k++) {
+        struct kcc_executor ex;
+        ck_assert_int_eq(kcc_executor_create(&long_chain, nthreads[k], &ex), 0);
+
+        kcc_executor_fpk(&ex, q, &sp);
+        for (int i = 1; i < N + 1; i++) {
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) {
+                    ck_assert(fabs(sp.x_tot[i].rotation->row[r].data[c]
+                            - s.x_tot[i].rotation->row[r].data[c]) < 1e-12);
+                }
+                ck_assert(fabs(sp.x_tot[i].translation->data[r]
+                        - s.x_tot[i].translation->data[r]) < 1e-12);
+            }
+        }
+
+        kcc_executor_destroy(&ex);
+    }
+
+    solver_state_destroy_c(&sp);
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+TCase *executor_test()
+{
+    TCase *tc = tcase_create("Executor");
+
+    tcase_add_test(tc, test_kcc_executor_run);
+    tcase_add_test(tc, test_kcc_executor_aba);
+    tcase_add_test(tc, test_kcc_executor_aba_subtrees);
+    tcase_add_test(tc, test_kcc_executor_fpk);
+
+    return tc;
+}
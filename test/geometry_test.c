@@ -147,6 +147,38 @@ START_TEST(test_gc_twist_tf_ref_to_tgt)
 END_TEST
 
 
+START_TEST(test_gc_twist_tf_tgt_to_ref)
+{
+    struct gc_twist xd = {
+        .angular_velocity = (struct vector3 [1]) { { 0.0, 0.0, 1.0 } },
+        .linear_velocity = (struct vector3 [1]) { { 1.0, 0.0, 0.0 } } };
+    struct gc_twist r = {
+        .angular_velocity = (struct vector3 [1]) {},
+        .linear_velocity = (struct vector3 [1]) {} };
+    struct gc_twist res = {
+        .angular_velocity = (struct vector3 [1]) {},
+        .linear_velocity = (struct vector3 [1]) {} };
+
+    // w' = E^T w, v' = E^T v + r x w'
+    struct vector3 res_ang = { 1.0, 0.0, 0.0 };
+    struct vector3 res_lin = { 0.0, 4.0, -2.0 };
+
+    gc_twist_tf_tgt_to_ref(&xc, &xd, &r);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_flt_eq(r.angular_velocity->data[i], res_ang.data[i]);
+        ck_assert_flt_eq(r.linear_velocity->data[i], res_lin.data[i]);
+    }
+
+    // Inverse of gc_twist_tf_ref_to_tgt()
+    gc_twist_tf_ref_to_tgt(&xc, &r, &res);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_flt_eq(res.angular_velocity->data[i], xd.angular_velocity->data[i]);
+        ck_assert_flt_eq(res.linear_velocity->data[i], xd.linear_velocity->data[i]);
+    }
+}
+END_TEST
+
+
 START_TEST(test_ga_twist_tf_ref_to_tgt)
 {
     struct ga_twist r;
@@ -341,6 +373,143 @@ START_TEST(test_ga_acc_twist_accumulate)
 END_TEST
 
 
+// Elementary rotation about each axis by pi/6 and its expansion
+static const double elementary_cos = 0.86602540378;
+static const double elementary_sin = 0.5;
+
+static void expand_elementary(
+        int axis,
+        struct gc_elementary_pose *e,
+        struct gc_pose *x)
+{
+    *e = (struct gc_elementary_pose) {
+        .axis = axis,
+        .cos_angle = elementary_cos,
+        .sin_angle = elementary_sin
+    };
+
+    gc_elementary_pose_to_pose(e, x);
+}
+
+
+START_TEST(test_gc_elementary_pose_to_pose)
+{
+    struct gc_elementary_pose e;
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) { {
+            .row_x = { 2.0, 2.0, 2.0 },
+            .row_y = { 2.0, 2.0, 2.0 },
+            .row_z = { 2.0, 2.0, 2.0 } } },
+        .translation = (struct vector3 [1]) { { 2.0, 2.0, 2.0 } }
+    };
+
+    const double c = elementary_cos;
+    const double s = elementary_sin;
+
+    struct matrix3x3 res[3] = {
+        { .row_x = { 1.0, 0.0, 0.0 }, .row_y = { 0.0, c, s }, .row_z = { 0.0, -s, c } },
+        { .row_x = { c, 0.0, -s }, .row_y = { 0.0, 1.0, 0.0 }, .row_z = { s, 0.0, c } },
+        { .row_x = { c, s, 0.0 }, .row_y = { -s, c, 0.0 }, .row_z = { 0.0, 0.0, 1.0 } }
+    };
+
+    for (int k = 0; k < 3; k++) {
+        expand_elementary(k, &e, &x);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                ck_assert_flt_eq(x.rotation->row[i].data[j], res[k].row[i].data[j]);
+            }
+            ck_assert_flt_eq(x.translation->data[i], 0.0);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_gc_pose_compose_elementary)
+{
+    struct gc_elementary_pose e;
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose r = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose res = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+
+    for (int k = 0; k < 3; k++) {
+        expand_elementary(k, &e, &x);
+        gc_pose_compose(&x, &xc, &res);
+        gc_pose_compose_elementary(&e, &xc, &r);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                ck_assert_flt_eq(r.rotation->row[i].data[j], res.rotation->row[i].data[j]);
+            }
+            ck_assert_flt_eq(r.translation->data[i], res.translation->data[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_gc_twist_tf_ref_to_tgt_elementary)
+{
+    struct gc_elementary_pose e;
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_twist r = {
+        .angular_velocity = (struct vector3 [1]) {},
+        .linear_velocity = (struct vector3 [1]) {} };
+    struct gc_twist res = {
+        .angular_velocity = (struct vector3 [1]) {},
+        .linear_velocity = (struct vector3 [1]) {} };
+
+    for (int k = 0; k < 3; k++) {
+        expand_elementary(k, &e, &x);
+        gc_twist_tf_ref_to_tgt(&x, &xdc, &res);
+        gc_twist_tf_ref_to_tgt_elementary(&e, &xdc, &r);
+        for (int i = 0; i < 3; i++) {
+            ck_assert_flt_eq(r.angular_velocity->data[i], res.angular_velocity->data[i]);
+            ck_assert_flt_eq(r.linear_velocity->data[i], res.linear_velocity->data[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_gc_acc_twist_tf_ref_to_tgt_elementary)
+{
+    struct gc_elementary_pose e;
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_acc_twist r = {
+        .angular_acceleration = (struct vector3 [1]) {},
+        .linear_acceleration = (struct vector3 [1]) {} };
+    struct gc_acc_twist res = {
+        .angular_acceleration = (struct vector3 [1]) {},
+        .linear_acceleration = (struct vector3 [1]) {} };
+
+    for (int k = 0; k < 3; k++) {
+        expand_elementary(k, &e, &x);
+        gc_acc_twist_tf_ref_to_tgt(&x, &xddc, &res);
+        gc_acc_twist_tf_ref_to_tgt_elementary(&e, &xddc, &r);
+        for (int i = 0; i < 3; i++) {
+            ck_assert_flt_eq(r.angular_acceleration->data[i], res.angular_acceleration->data[i]);
+            ck_assert_flt_eq(r.linear_acceleration->data[i], res.linear_acceleration->data[i]);
+        }
+    }
+}
+END_TEST
+
+
 TCase *geometry_test()
 {
     TCase *tc = tcase_create("Geometry");
@@ -348,6 +517,7 @@ TCase *geometry_test()
     tcase_add_test(tc, test_gc_pose_compose);
     tcase_add_test(tc, test_ga_pose_compose);
     tcase_add_test(tc, test_gc_twist_tf_ref_to_tgt);
+    tcase_add_test(tc, test_gc_twist_tf_tgt_to_ref);
     tcase_add_test(tc, test_ga_twist_tf_ref_to_tgt);
     tcase_add_test(tc, test_gc_twist_accumulate);
     tcase_add_test(tc, test_ga_twist_accumulate);
@@ -359,6 +529,10 @@ TCase *geometry_test()
     tcase_add_test(tc, test_ga_acc_twist_add);
     tcase_add_test(tc, test_gc_acc_twist_accumulate);
     tcase_add_test(tc, test_ga_acc_twist_accumulate);
+    tcase_add_test(tc, test_gc_elementary_pose_to_pose);
+    tcase_add_test(tc, test_gc_pose_compose_elementary);
+    tcase_add_test(tc, test_gc_twist_tf_ref_to_tgt_elementary);
+    tcase_add_test(tc, test_gc_acc_twist_tf_ref_to_tgt_elementary);
 
     return tc;
 }
@@ -1,4 +1,6 @@
 #include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/geometry.h>
+#include <dyn2b/functions/mechanics.h>
 #include <check.h>
 #include <math.h>
 
@@ -44,22 +46,14 @@ static struct ma_abi ma = {
     .frame = &frame_b
 };
 
-static struct mc_abi mc = {
-    .zeroth_moment_of_mass = {
-        .row_x = { 4.0, 5.0, 6.0 },
-        .row_y = { 5.0, 5.0, 6.0 },
-        .row_z = { 6.0, 6.0, 6.0 }
-    },
+static struct mc_abi_packed mc = {
+    .zeroth_moment_of_mass = { 4.0, 5.0, 6.0, 5.0, 6.0, 6.0 },
     .first_moment_of_mass = {
         .row_x = { 2.0, 3.0, 4.0 },
         .row_y = { 3.0, 3.0, 4.0 },
         .row_z = { 4.0, 4.0, 4.0 }
     },
-    .second_moment_of_mass = {
-        .row_x = { 1.0, 2.0, 3.0 },
-        .row_y = { 2.0, 2.0, 3.0 },
-        .row_z = { 3.0, 3.0, 3.0 }
-    }
+    .second_moment_of_mass = { 1.0, 2.0, 3.0, 2.0, 3.0, 3.0 }
 };
 
 static struct ma_wrench fa = {
@@ -235,6 +229,53 @@ START_TEST(test_rev_fpk)
 END_TEST
 
 
+START_TEST(test_rev_fpk_compose)
+{
+    struct kcc_joint joint = { .type = JOINT_TYPE_REVOLUTE };
+    joint_position q = { 0.3 };
+    struct gc_pose x_t = {
+        .rotation = (struct matrix3x3 [1]) { {
+            .row_x = { 0.0, 1.0, 0.0 },
+            .row_y = { 0.0, 0.0, 1.0 },
+            .row_z = { 1.0, 0.0, 0.0 } } },
+        .translation = (struct vector3 [1]) { { 1.0, 2.0, 3.0 } }
+    };
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose r = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose res_x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose res_r = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+
+    for (int k = JOINT_AXIS_X; k <= JOINT_AXIS_Z; k++) {
+        joint.revolute_joint.axis = k;
+        kcc_joint[JOINT_TYPE_REVOLUTE].fpk(&joint, &q, &res_x);
+        gc_pose_compose(&res_x, &x_t, &res_r);
+
+        kcc_joint[JOINT_TYPE_REVOLUTE].fpk_compose(&joint, &q, &x_t, &x, &r);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                ck_assert_flt_eq(x.rotation->row[i].data[j], res_x.rotation->row[i].data[j]);
+                ck_assert_flt_eq(r.rotation->row[i].data[j], res_r.rotation->row[i].data[j]);
+            }
+            ck_assert_flt_eq(x.translation->data[i], res_x.translation->data[i]);
+            ck_assert_flt_eq(r.translation->data[i], res_r.translation->data[i]);
+        }
+    }
+}
+END_TEST
+
+
 START_TEST(test_rev_fvk)
 {
     struct kcc_joint joint = { .type = JOINT_TYPE_REVOLUTE };
@@ -400,6 +441,25 @@ START_TEST(test_rev_ifk)
 END_TEST
 
 
+START_TEST(test_rev_inertial_torque)
+{
+    struct kcc_joint joint = {
+        .type = JOINT_TYPE_REVOLUTE,
+        .revolute_joint = {
+            .axis = JOINT_AXIS_Y,
+            .inertia = (double [1]) { 3.0 }
+        }
+    };
+    joint_acceleration qdd[2] = { 1.0, -2.0 };
+    joint_torque tau[2] = { 0.0, 0.0 };
+
+    kcc_joint[JOINT_TYPE_REVOLUTE].inertial_torque(&joint, qdd, tau, 2);
+    ck_assert_flt_eq(tau[0], 3.0);
+    ck_assert_flt_eq(tau[1], -6.0);
+}
+END_TEST
+
+
 START_TEST(test_rev_ffd)
 {
     struct kcc_joint joint = {
@@ -458,12 +518,46 @@ START_TEST(test_rev_ffd)
 END_TEST
 
 
+START_TEST(test_rev_fad)
+{
+    struct kcc_joint joint = {
+        .type = JOINT_TYPE_REVOLUTE,
+        .revolute_joint.inertia = (double [1]) { 3.0 }
+    };
+    joint_torque tau[2] = { 1.0, 2.0 };
+    joint_acceleration qdd[2] = { 0.0, 0.0 };
+
+
+    joint_acceleration res_x[2] = { 0.25, 0.5 };
+
+    joint.revolute_joint.axis = JOINT_AXIS_X;
+    kcc_joint[JOINT_TYPE_REVOLUTE].fad(&joint, &mc, tau, qdd, 2);
+    for (int i = 0; i < 2; i++) ck_assert_flt_eq(qdd[i], res_x[i]);
+
+
+    joint_acceleration res_y[2] = { 0.2, 0.4 };
+
+    joint.revolute_joint.axis = JOINT_AXIS_Y;
+    kcc_joint[JOINT_TYPE_REVOLUTE].fad(&joint, &mc, tau, qdd, 2);
+    for (int i = 0; i < 2; i++) ck_assert_flt_eq(qdd[i], res_y[i]);
+
+
+    joint_acceleration res_z[2] = { 1.0 / 6.0, 2.0 / 6.0 };
+
+    joint.revolute_joint.axis = JOINT_AXIS_Z;
+    kcc_joint[JOINT_TYPE_REVOLUTE].fad(&joint, &mc, tau, qdd, 2);
+    for (int i = 0; i < 2; i++) ck_assert_flt_eq(qdd[i], res_z[i]);
+}
+END_TEST
+
+
 START_TEST(test_rev_project_inertia)
 {
     struct kcc_joint joint = {
         .type = JOINT_TYPE_REVOLUTE,
         .revolute_joint.inertia = (double [1]) { 3.0 }
     };
+    struct mc_abi_packed mp;
     struct mc_abi m;
 
     struct matrix3x3 res_m2_x = {
@@ -480,7 +574,8 @@ START_TEST(test_rev_project_inertia)
         .row_z = { 4.0, 3.0 , 2.0 } };
 
     joint.revolute_joint.axis = JOINT_AXIS_X;
-    kcc_joint[JOINT_TYPE_REVOLUTE].project_inertia(&joint, &mc, &m);
+    kcc_joint[JOINT_TYPE_REVOLUTE].project_inertia(&joint, &mc, &mp);
+    mc_abi_unpack(&mp, &m);
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
             ck_assert_flt_eq(m.second_moment_of_mass.row[i].data[j], res_m2_x.row[i].data[j]);
@@ -503,7 +598,8 @@ START_TEST(test_rev_project_inertia)
         .row_z = { 3.6, 3.6, 2.8 } };
 
     joint.revolute_joint.axis = JOINT_AXIS_Y;
-    kcc_joint[JOINT_TYPE_REVOLUTE].project_inertia(&joint, &mc, &m);
+    kcc_joint[JOINT_TYPE_REVOLUTE].project_inertia(&joint, &mc, &mp);
+    mc_abi_unpack(&mp, &m);
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
             ck_assert_flt_eq(m.second_moment_of_mass.row[i].data[j], res_m2_y.row[i].data[j]);
@@ -527,7 +623,8 @@ START_TEST(test_rev_project_inertia)
         .row_z = { 10.0 / 3.0, 10.0 / 3.0, 10.0 / 3.0 } };
 
     joint.revolute_joint.axis = JOINT_AXIS_Z;
-    kcc_joint[JOINT_TYPE_REVOLUTE].project_inertia(&joint, &mc, &m);
+    kcc_joint[JOINT_TYPE_REVOLUTE].project_inertia(&joint, &mc, &mp);
+    mc_abi_unpack(&mp, &m);
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
             ck_assert_flt_eq(m.second_moment_of_mass.row[i].data[j], res_m2_z.row[i].data[j]);
@@ -591,6 +688,493 @@ START_TEST(test_rev_project_wrench)
 END_TEST
 
 
+START_TEST(test_kca_verify)
+{
+    struct body body[3];
+    struct point root_origin[3], tip_origin[2];
+    struct frame root[3], tip[2];
+    for (int i = 0; i < 3; i++) root[i] = (struct frame) { .origin = &root_origin[i] };
+    for (int i = 0; i < 2; i++) tip[i] = (struct frame) { .origin = &tip_origin[i] };
+
+    struct kca_segment segment[2];
+    for (int i = 0; i < 2; i++) {
+        segment[i] = (struct kca_segment) {
+            .joint_attachment = {
+                .target_frame = &tip[i], .target_body = &body[i],
+                .reference_frame = &root[i], .reference_body = &body[i]
+            },
+            .joint = {
+                .target_frame = &root[i + 1], .target_body = &body[i + 1],
+                .reference_frame = &tip[i], .reference_body = &body[i]
+            },
+            .link = {
+                .root_frame = &root[i + 1],
+                .inertia = { .body = &body[i + 1], .point = &root_origin[i + 1], .frame = &root[i + 1] }
+            }
+        };
+    }
+
+    struct kca_kinematic_chain kc = { .number_of_segments = 2, .segment = segment };
+    int faulty = -2;
+
+    ck_assert_int_eq(kca_verify(&kc, &faulty), 0);
+    ck_assert_int_eq(faulty, -2);
+
+    // The second joint is attached to the first link's tip
+    segment[1].joint_attachment.reference_frame = &tip[0];
+    ck_assert_int_eq(kca_verify(&kc, &faulty), -1);
+    ck_assert_int_eq(faulty, 1);
+    segment[1].joint_attachment.reference_frame = &root[1];
+
+    // The inertia is not expressed at the frame's origin
+    segment[0].link.inertia.point = &tip_origin[0];
+    ck_assert_int_eq(kca_verify(&kc, &faulty), -1);
+    ck_assert_int_eq(faulty, 0);
+    segment[0].link.inertia.point = &root_origin[1];
+
+    ck_assert_int_eq(kca_verify(&kc, NULL), 0);
+
+    // The same chain as a tree
+    int parent[2] = { -1, 0 };
+    kc.parent = parent;
+    ck_assert_int_eq(kca_verify(&kc, &faulty), 0);
+
+    // The segments are not in topological order
+    parent[1] = 1;
+    ck_assert_int_eq(kca_verify(&kc, &faulty), -1);
+    ck_assert_int_eq(faulty, 1);
+}
+END_TEST
+
+
+START_TEST(test_kcc_verify)
+{
+    struct body body[2];
+    struct point origin[2];
+    struct frame root[2] = { { .origin = &origin[0] }, { .origin = &origin[1] } };
+
+    struct kca_segment segment_a[1] = { {
+        .joint_attachment = {
+            .target_frame = &root[0], .target_body = &body[0],
+            .reference_frame = &root[0], .reference_body = &body[0]
+        },
+        .joint = {
+            .target_frame = &root[1], .target_body = &body[1],
+            .reference_frame = &root[0], .reference_body = &body[0]
+        },
+        .link = {
+            .root_frame = &root[1],
+            .inertia = { .body = &body[1], .point = &origin[1], .frame = &root[1] }
+        }
+    } };
+
+    struct kcc_segment segment_c[1] = { {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { { .row_x = { 1.0 }, .row_y = { 0.0, 1.0 }, .row_z = { 0.0, 0.0, 1.0 } } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 1.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = { .axis = JOINT_AXIS_Y, .inertia = (double [1]) { 0.1 } }
+        },
+        .link = { .inertia = { .zeroth_moment_of_mass = 1.0 } }
+    } };
+
+    struct kca_kinematic_chain kca = { .number_of_segments = 1, .segment = segment_a };
+    struct kcc_kinematic_chain kcc = { .number_of_segments = 1, .segment = segment_c };
+    int faulty;
+
+    ck_assert_int_eq(kcc.verified, 0);
+    ck_assert_int_eq(kcc_verify(&kca, &kcc, &faulty), 0);
+    ck_assert_int_eq(kcc.verified, 1);
+
+    // Missing joint inertia
+    segment_c[0].joint.revolute_joint.inertia = NULL;
+    ck_assert_int_eq(kcc_verify(&kca, &kcc, &faulty), -1);
+    ck_assert_int_eq(faulty, 0);
+    ck_assert_int_eq(kcc.verified, 0);
+
+    // Different tree structure
+    segment_c[0].joint.revolute_joint.inertia = (double [1]) { 0.1 };
+    kcc.parent = (int [1]) { 0 };
+    ck_assert_int_eq(kcc_verify(&kca, &kcc, &faulty), -1);
+    ck_assert_int_eq(faulty, 0);
+    kcc.parent = (int [1]) { -1 };
+    ck_assert_int_eq(kcc_verify(&kca, &kcc, &faulty), 0);
+
+    // Different number of segments
+    kca.number_of_segments = 0;
+    ck_assert_int_eq(kcc_verify(&kca, &kcc, &faulty), -1);
+    ck_assert_int_eq(faulty, -1);
+}
+END_TEST
+
+
+START_TEST(test_kcc_compile)
+{
+    struct kcc_segment segment[3] = {
+        { .joint = { .type = JOINT_TYPE_REVOLUTE, .revolute_joint = { .axis = JOINT_AXIS_Z } } },
+        { .joint = { .type = JOINT_TYPE_REVOLUTE, .revolute_joint = { .axis = JOINT_AXIS_X } } },
+        { .joint = { .type = JOINT_TYPE_REVOLUTE, .revolute_joint = { .axis = JOINT_AXIS_Y } } }
+    };
+    struct kcc_kinematic_chain kc = { .number_of_segments = 3, .segment = segment };
+
+    ck_assert_ptr_eq(segment[0].joint.operators, NULL);
+
+    kcc_compile(&kc);
+    ck_assert_ptr_eq(segment[0].joint.operators, &kcc_revolute_joint[JOINT_AXIS_Z]);
+    ck_assert_ptr_eq(segment[1].joint.operators, &kcc_revolute_joint[JOINT_AXIS_X]);
+    ck_assert_ptr_eq(segment[2].joint.operators, &kcc_revolute_joint[JOINT_AXIS_Y]);
+
+    // A changed axis takes effect when the chain is compiled again
+    segment[0].joint.revolute_joint.axis = JOINT_AXIS_X;
+    ck_assert_int_eq(kcc_compile(&kc), 0);
+    ck_assert_ptr_eq(segment[0].joint.operators, &kcc_revolute_joint[JOINT_AXIS_X]);
+
+    // Fixed joints must be merged first
+    segment[1].joint.type = JOINT_TYPE_FIXED;
+    segment[2].joint.operators = NULL;
+    ck_assert_int_eq(kcc_compile(&kc), -1);
+    ck_assert_ptr_eq(segment[2].joint.operators, NULL);
+}
+END_TEST
+
+
+START_TEST(test_pri_fpk_compose)
+{
+    struct kcc_joint joint = { .type = JOINT_TYPE_PRISMATIC };
+    joint_position q = { 0.3 };
+    struct gc_pose x_t = {
+        .rotation = (struct matrix3x3 [1]) { {
+            .row_x = { 0.0, 1.0, 0.0 },
+            .row_y = { 0.0, 0.0, 1.0 },
+            .row_z = { 1.0, 0.0, 0.0 } } },
+        .translation = (struct vector3 [1]) { { 1.0, 2.0, 3.0 } }
+    };
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose r = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose res_r = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+
+    for (int k = JOINT_AXIS_X; k <= JOINT_AXIS_Z; k++) {
+        joint.prismatic_joint.axis = k;
+        kcc_joint[JOINT_TYPE_PRISMATIC].fpk(&joint, &q, &x);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                ck_assert_flt_eq(x.rotation->row[i].data[j], i == j ? 1.0 : 0.0);
+            }
+            ck_assert_flt_eq(x.translation->data[i], i == k ? 0.3 : 0.0);
+        }
+        gc_pose_compose(&x, &x_t, &res_r);
+
+        kcc_joint[JOINT_TYPE_PRISMATIC].fpk_compose(&joint, &q, &x_t, &x, &r);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                ck_assert_flt_eq(r.rotation->row[i].data[j], res_r.rotation->row[i].data[j]);
+            }
+            ck_assert_flt_eq(r.translation->data[i], res_r.translation->data[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_pri_fvk)
+{
+    struct kcc_joint joint = { .type = JOINT_TYPE_PRISMATIC };
+    joint_velocity qd = { 2.0 };
+    struct gc_twist xd = {
+        .angular_velocity = (struct vector3 [1]) {},
+        .linear_velocity = (struct vector3 [1]) {}
+    };
+
+    for (int k = JOINT_AXIS_X; k <= JOINT_AXIS_Z; k++) {
+        joint.prismatic_joint.axis = k;
+        kcc_joint[JOINT_TYPE_PRISMATIC].fvk(&joint, &qd, &xd);
+        for (int i = 0; i < 3; i++) {
+            ck_assert_flt_eq(xd.angular_velocity->data[i], 0.0);
+            ck_assert_flt_eq(xd.linear_velocity->data[i], i == k ? 2.0 : 0.0);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_pri_inertial_acceleration)
+{
+    struct kcc_joint joint = { .type = JOINT_TYPE_PRISMATIC };
+    joint_position qd = { 2.0 };
+    struct gc_twist xd = {
+        .angular_velocity = (struct vector3 [1]) { 2.0, 3.0, 4.0 },
+        .linear_velocity = (struct vector3 [1]) { 3.0, 4.0, 5.0 }
+    };
+    struct gc_acc_twist xdd = {
+        .angular_acceleration = (struct vector3 [1]) {},
+        .linear_acceleration = (struct vector3 [1]) {}
+    };
+
+    struct vector3 res_lin[3] = {
+        {   0.0,  8.0, -6.0 },
+        { - 8.0,  0.0,  4.0 },
+        {   6.0, -4.0,  0.0 }
+    };
+
+    for (int k = JOINT_AXIS_X; k <= JOINT_AXIS_Z; k++) {
+        joint.prismatic_joint.axis = k;
+        kcc_joint[JOINT_TYPE_PRISMATIC].inertial_acceleration(&joint, &xd, &qd, &xdd);
+        for (int i = 0; i < 3; i++) {
+            ck_assert_flt_eq(xdd.angular_acceleration->data[i], 0.0);
+            ck_assert_flt_eq(xdd.linear_acceleration->data[i], res_lin[k].data[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_pri_ifk)
+{
+    struct kcc_joint joint = { .type = JOINT_TYPE_PRISMATIC };
+    joint_torque tau[2] = { 0.0, 0.0 };
+
+    joint_torque res[3][2] = { { 2.0, 8.0 }, { 3.0, 10.0 }, { 4.0, 12.0 } };
+
+    for (int k = JOINT_AXIS_X; k <= JOINT_AXIS_Z; k++) {
+        joint.prismatic_joint.axis = k;
+        kcc_joint[JOINT_TYPE_PRISMATIC].ifk(&joint, &fc, tau, 2);
+        for (int i = 0; i < 2; i++) ck_assert_flt_eq(tau[i], res[k][i]);
+    }
+}
+END_TEST
+
+
+START_TEST(test_pri_ffd)
+{
+    struct kcc_joint joint = {
+        .type = JOINT_TYPE_PRISMATIC,
+        .prismatic_joint = { .axis = JOINT_AXIS_X, .inertia = (double [1]) { 3.0 } }
+    };
+    joint_torque tau[2] = { 7.0, 14.0 };
+    joint_acceleration qdd[2];
+    struct mc_wrench f = {
+        .torque = (struct vector3 [2]) {},
+        .force = (struct vector3 [2]) {}
+    };
+
+    // D = 4.0 + 3.0
+    kcc_joint[JOINT_TYPE_PRISMATIC].fad(&joint, &mc, tau, qdd, 2);
+    ck_assert_flt_eq(qdd[0], 1.0);
+    ck_assert_flt_eq(qdd[1], 2.0);
+
+    struct vector3 res_ang = { 2.0, 3.0, 4.0 };
+    struct vector3 res_lin = { 4.0, 5.0, 6.0 };
+
+    kcc_joint[JOINT_TYPE_PRISMATIC].ffd(&joint, &mc, tau, &f, 2);
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 3; i++) {
+            ck_assert_flt_eq(f.torque[j].data[i], (j + 1) * res_ang.data[i]);
+            ck_assert_flt_eq(f.force[j].data[i], (j + 1) * res_lin.data[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_pri_project)
+{
+    // Without the joint's inertia the projection removes everything that the
+    // joint transmits: M^a S = 0 and S^T F^a = 0
+    struct kcc_joint joint = {
+        .type = JOINT_TYPE_PRISMATIC,
+        .prismatic_joint.inertia = (double [1]) { 0.0 }
+    };
+    struct mc_abi_packed r;
+    struct mc_wrench f = {
+        .torque = (struct vector3 [2]) {},
+        .force = (struct vector3 [2]) {}
+    };
+
+    for (int k = JOINT_AXIS_X; k <= JOINT_AXIS_Z; k++) {
+        joint.prismatic_joint.axis = k;
+
+        kcc_joint[JOINT_TYPE_PRISMATIC].project_inertia(&joint, &mc, &r);
+        for (int j = 0; j < 3; j++) {
+            ck_assert_flt_eq(r.first_moment_of_mass.row[j].data[k], 0.0);
+            ck_assert_flt_eq(r.zeroth_moment_of_mass[MC_SYM33(j, k)], 0.0);
+        }
+
+        kcc_joint[JOINT_TYPE_PRISMATIC].project_wrench(&joint, &mc, &fc, &f, 2);
+        for (int j = 0; j < 2; j++) {
+            ck_assert_flt_eq(f.force[j].data[k], 0.0);
+        }
+    }
+
+
+    // Axis x with the joint's inertia: D = 4.0 + 3.0
+    joint.prismatic_joint.axis = JOINT_AXIS_X;
+    joint.prismatic_joint.inertia[0] = 3.0;
+
+    struct vector3 res_ang[2] = {
+        { 1.0 - 2.0 * 2.0 / 7.0, 2.0 - 3.0 * 2.0 / 7.0, 3.0 - 4.0 * 2.0 / 7.0 },
+        { 2.0 - 2.0 * 8.0 / 7.0, 4.0 - 3.0 * 8.0 / 7.0, 6.0 - 4.0 * 8.0 / 7.0 }
+    };
+    struct vector3 res_lin[2] = {
+        { 2.0 - 4.0 * 2.0 / 7.0,  3.0 - 5.0 * 2.0 / 7.0,  4.0 - 6.0 * 2.0 / 7.0 },
+        { 8.0 - 4.0 * 8.0 / 7.0, 10.0 - 5.0 * 8.0 / 7.0, 12.0 - 6.0 * 8.0 / 7.0 }
+    };
+
+    kcc_joint[JOINT_TYPE_PRISMATIC].project_wrench(&joint, &mc, &fc, &f, 2);
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 3; i++) {
+            ck_assert_flt_eq(f.torque[j].data[i], res_ang[j].data[i]);
+            ck_assert_flt_eq(f.force[j].data[i], res_lin[j].data[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_fix_operators)
+{
+    struct kcc_joint joint = { .type = JOINT_TYPE_FIXED };
+    const struct kcc_joint_operators *op = kcc_joint_resolve(&joint);
+    ck_assert_ptr_eq(op, &kcc_joint[JOINT_TYPE_FIXED]);
+    ck_assert_int_eq(op->nq, 0);
+    ck_assert_int_eq(op->nd, 0);
+
+    joint_position q = { 0.3 };
+    joint_velocity qd = { 2.0 };
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) { { 1.0, 1.0, 1.0 } }
+    };
+    struct gc_twist xd = {
+        .angular_velocity = (struct vector3 [1]) { 2.0, 3.0, 4.0 },
+        .linear_velocity = (struct vector3 [1]) { 3.0, 4.0, 5.0 }
+    };
+    struct gc_acc_twist xdd = {
+        .angular_acceleration = (struct vector3 [1]) { { 1.0, 1.0, 1.0 } },
+        .linear_acceleration = (struct vector3 [1]) { { 1.0, 1.0, 1.0 } }
+    };
+
+    op->fpk(&joint, &q, &x);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ck_assert_flt_eq(x.rotation->row[i].data[j], i == j ? 1.0 : 0.0);
+        }
+        ck_assert_flt_eq(x.translation->data[i], 0.0);
+    }
+
+    op->inertial_acceleration(&joint, &xd, &qd, &xdd);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_flt_eq(xdd.angular_acceleration->data[i], 0.0);
+        ck_assert_flt_eq(xdd.linear_acceleration->data[i], 0.0);
+    }
+
+    // A fixed joint transmits everything
+    joint_torque tau[2] = { 1.0, 1.0 };
+    struct mc_abi_packed r;
+    struct mc_wrench f = {
+        .torque = (struct vector3 [2]) {},
+        .force = (struct vector3 [2]) {}
+    };
+
+    // ... and has no coordinates to write to
+    op->ifk(&joint, &fc, tau, 2);
+    ck_assert_flt_eq(tau[0], 1.0);
+    ck_assert_flt_eq(tau[1], 1.0);
+
+    op->project_inertia(&joint, &mc, &r);
+    for (int i = 0; i < 6; i++) {
+        ck_assert_flt_eq(r.zeroth_moment_of_mass[i], mc.zeroth_moment_of_mass[i]);
+        ck_assert_flt_eq(r.second_moment_of_mass[i], mc.second_moment_of_mass[i]);
+    }
+
+    op->project_wrench(&joint, &mc, &fc, &f, 2);
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 3; i++) {
+            ck_assert_flt_eq(f.torque[j].data[i], fc.torque[j].data[i]);
+            ck_assert_flt_eq(f.force[j].data[i], fc.force[j].data[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_multi_dof_fpk)
+{
+    struct kcc_joint rev = { .type = JOINT_TYPE_REVOLUTE };
+    struct kcc_joint sph = { .type = JOINT_TYPE_SPHERICAL };
+    struct kcc_joint ffl = { .type = JOINT_TYPE_FREE_FLYER };
+    struct gc_pose x = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+    struct gc_pose res = {
+        .rotation = (struct matrix3x3 [1]) {},
+        .translation = (struct vector3 [1]) {}
+    };
+
+    ck_assert_int_eq(kcc_joint[JOINT_TYPE_SPHERICAL].nq, 4);
+    ck_assert_int_eq(kcc_joint[JOINT_TYPE_SPHERICAL].nd, 3);
+    ck_assert_int_eq(kcc_joint[JOINT_TYPE_FREE_FLYER].nq, 7);
+    ck_assert_int_eq(kcc_joint[JOINT_TYPE_FREE_FLYER].nd, 6);
+
+    // A rotation by 0.3 about each axis; the quaternion's norm is 2
+    joint_position angle = 0.3;
+    for (int k = JOINT_AXIS_X; k <= JOINT_AXIS_Z; k++) {
+        joint_position q[7] = { 1.0, 2.0, 3.0, 0.0, 0.0, 0.0, 2.0 * cos(0.15) };
+        q[3 + k] = 2.0 * sin(0.15);
+
+        rev.revolute_joint.axis = k;
+        kcc_joint[JOINT_TYPE_REVOLUTE].fpk(&rev, &angle, &res);
+
+        kcc_joint[JOINT_TYPE_SPHERICAL].fpk(&sph, &q[3], &x);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                ck_assert_flt_eq(x.rotation->row[i].data[j], res.rotation->row[i].data[j]);
+            }
+            ck_assert_flt_eq(x.translation->data[i], 0.0);
+        }
+
+        kcc_joint[JOINT_TYPE_FREE_FLYER].fpk(&ffl, q, &x);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                ck_assert_flt_eq(x.rotation->row[i].data[j], res.rotation->row[i].data[j]);
+            }
+            ck_assert_flt_eq(x.translation->data[i], q[i]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_kcc_dimensions)
+{
+    struct kcc_segment segment[4] = {
+        { .joint.type = JOINT_TYPE_FREE_FLYER },
+        { .joint.type = JOINT_TYPE_REVOLUTE },
+        { .joint.type = JOINT_TYPE_SPHERICAL },
+        { .joint.type = JOINT_TYPE_FIXED }
+    };
+    struct kcc_kinematic_chain kc = { .number_of_segments = 4, .segment = segment };
+    int nq;
+    int nd;
+
+    kcc_dimensions(&kc, &nq, &nd);
+    ck_assert_int_eq(nq, 7 + 1 + 4);
+    ck_assert_int_eq(nd, 6 + 1 + 3);
+}
+END_TEST
+
+
 TCase *kinematic_chain_test()
 {
     TCase *tc = tcase_create("KinematicChain");
@@ -603,14 +1187,29 @@ TCase *kinematic_chain_test()
     tcase_add_test(tc, test_kca_ffd);
     tcase_add_test(tc, test_kca_project_inertia);
     tcase_add_test(tc, test_kca_project_wrench);
+    tcase_add_test(tc, test_kca_verify);
+    tcase_add_test(tc, test_kcc_verify);
+    tcase_add_test(tc, test_kcc_compile);
     tcase_add_test(tc, test_rev_fpk);
+    tcase_add_test(tc, test_rev_fpk_compose);
     tcase_add_test(tc, test_rev_fvk);
     tcase_add_test(tc, test_rev_fak);
     tcase_add_test(tc, test_rev_inertial_acceleration);
     tcase_add_test(tc, test_rev_ifk);
+    tcase_add_test(tc, test_rev_inertial_torque);
     tcase_add_test(tc, test_rev_ffd);
+    tcase_add_test(tc, test_rev_fad);
     tcase_add_test(tc, test_rev_project_inertia);
     tcase_add_test(tc, test_rev_project_wrench);
+    tcase_add_test(tc, test_pri_fpk_compose);
+    tcase_add_test(tc, test_pri_fvk);
+    tcase_add_test(tc, test_pri_inertial_acceleration);
+    tcase_add_test(tc, test_pri_ifk);
+    tcase_add_test(tc, test_pri_ffd);
+    tcase_add_test(tc, test_pri_project);
+    tcase_add_test(tc, test_fix_operators);
+    tcase_add_test(tc, test_multi_dof_fpk);
+    tcase_add_test(tc, test_kcc_dimensions);
 
     return tc;
 }
@@ -217,6 +217,59 @@ START_TEST(test_la_ddot)
 END_TEST
 
 
+START_TEST(test_la_dsincos)
+{
+    enum { N = 1003 };
+    static double x[N], s[N], c[N];
+
+    // A sweep over the range of joint angles, the quadrant boundaries and the
+    // arguments that are left to libm
+    for (int i = 0; i < N - 8; i++) {
+        x[i] = -25.0 + 50.0 * i / (N - 9);
+    }
+    x[N - 8] = 0.5 * M_PI;
+    x[N - 7] = -M_PI;
+    x[N - 6] = 1.0e5 - 0.1;
+    x[N - 5] = -1.0e5;
+    x[N - 4] = 3.0e7;
+    x[N - 3] = -0.0;
+    x[N - 2] = 1.0e-300;
+    x[N - 1] = 4.0 * atan(1.0) * 1.5;
+
+    enum la_isa isa = la_get_isa();
+
+    for (int k = LA_ISA_SCALAR; k <= LA_ISA_AVX512; k++) {
+        if (la_set_isa((enum la_isa)k) != 0) continue;
+
+        for (int n = 0; n <= N; n += n < 20 ? 1 : 197) {
+            la_dsincos(n, x, 1, s, 1, c, 1);
+            for (int i = 0; i < n; i++) {
+                ck_assert(fabs(s[i] - sin(x[i])) < 1e-15);
+                ck_assert(fabs(c[i] - cos(x[i])) < 1e-15);
+            }
+        }
+
+        // Strided
+        la_dsincos(N / 2, x, 2, s, 1, &c[1], 2);
+        for (int i = 0; i < N / 2; i++) {
+            ck_assert(fabs(s[i] - sin(x[2 * i])) < 1e-15);
+            ck_assert(fabs(c[2 * i + 1] - cos(x[2 * i])) < 1e-15);
+        }
+    }
+
+    ck_assert_int_eq(la_set_isa(isa), 0);
+
+    // Non-finite arguments
+    double y[3] = { INFINITY, -INFINITY, NAN };
+    la_dsincos(3, y, 1, s, 1, c, 1);
+    for (int i = 0; i < 3; i++) {
+        ck_assert(isnan(s[i]));
+        ck_assert(isnan(c[i]));
+    }
+}
+END_TEST
+
+
 START_TEST(test_la_dcross_o)
 {
     struct vector3 a = { 1.0, 2.0, 3.0 };
@@ -715,6 +768,272 @@ START_TEST(test_la_dgemm_ntoe)
 END_TEST
 
 
+static struct vector3 vec_x = { 1.0, -2.0, 3.0 };
+
+
+static void ck_assert_mat_eq(const struct matrix3x3 *a, const struct matrix3x3 *b)
+{
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ck_assert_flt_eq(a->row[i].data[j], b->row[i].data[j]);
+        }
+    }
+}
+
+
+START_TEST(test_la_d33gemv)
+{
+    struct vector3 y = { 3.0, 1.0, 2.0 };
+    struct vector3 r;
+    struct vector3 res;
+
+    la_dgemv_nos(3, 3, (double *)&mat_a, 3, (double *)&vec_x, 1, (double *)&res, 1);
+    la_d33gemv_nos((double *)&mat_a, (double *)&vec_x, (double *)&r);
+    for (int i = 0; i < 3; i++) ck_assert_flt_eq(r.data[i], res.data[i]);
+
+    la_dgemv_tos(3, 3, (double *)&mat_a, 3, (double *)&vec_x, 1, (double *)&res, 1);
+    la_d33gemv_tos((double *)&mat_a, (double *)&vec_x, (double *)&r);
+    for (int i = 0; i < 3; i++) ck_assert_flt_eq(r.data[i], res.data[i]);
+
+    la_dgemv_noe(3, 3,
+            2.0, (double *)&mat_a, 3, (double *)&vec_x, 1,
+            -3.0, (double *)&y, 1,
+            (double *)&res, 1);
+    la_d33gemv_noe(
+            2.0, (double *)&mat_a, (double *)&vec_x,
+            -3.0, (double *)&y,
+            (double *)&r);
+    for (int i = 0; i < 3; i++) ck_assert_flt_eq(r.data[i], res.data[i]);
+
+    la_dgemv_toe(3, 3,
+            2.0, (double *)&mat_a, 3, (double *)&vec_x, 1,
+            -3.0, (double *)&y, 1,
+            (double *)&res, 1);
+    la_d33gemv_toe(
+            2.0, (double *)&mat_a, (double *)&vec_x,
+            -3.0, (double *)&y,
+            (double *)&r);
+    for (int i = 0; i < 3; i++) ck_assert_flt_eq(r.data[i], res.data[i]);
+
+
+    // Operate in in-place mode
+    r = vec_x;
+    la_d33gemv_nos((double *)&mat_a, (double *)&r, (double *)&r);
+    la_dgemv_nos(3, 3, (double *)&mat_a, 3, (double *)&vec_x, 1, (double *)&res, 1);
+    for (int i = 0; i < 3; i++) ck_assert_flt_eq(r.data[i], res.data[i]);
+}
+END_TEST
+
+
+START_TEST(test_la_d33gemm)
+{
+    struct matrix3x3 c = {
+        .row_x = { 3.0, 4.0, 5.0 },
+        .row_y = { 4.0, 5.0, 6.0 },
+        .row_z = { 6.0, 7.0, 8.0 } };
+    struct matrix3x3 r;
+    struct matrix3x3 res;
+
+    la_dgemm_nnos(3, 3, 3, (double *)&mat_a, 3, (double *)&mat_b, 3, (double *)&res, 3);
+    la_d33gemm_nnos((double *)&mat_a, (double *)&mat_b, (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+
+    la_dgemm_tnos(3, 3, 3, (double *)&mat_a, 3, (double *)&mat_b, 3, (double *)&res, 3);
+    la_d33gemm_tnos((double *)&mat_a, (double *)&mat_b, (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+
+    la_dgemm_nnoe(3, 3, 3,
+            2.0, (double *)&mat_a, 3, (double *)&mat_b, 3,
+            3.0, (double *)&c, 3,
+            (double *)&res, 3);
+    la_d33gemm_nnoe(
+            2.0, (double *)&mat_a, (double *)&mat_b,
+            3.0, (double *)&c,
+            (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+
+    la_dgemm_ntoe(3, 3, 3,
+            2.0, (double *)&mat_a, 3, (double *)&mat_b, 3,
+            3.0, (double *)&c, 3,
+            (double *)&res, 3);
+    la_d33gemm_ntoe(
+            2.0, (double *)&mat_a, (double *)&mat_b,
+            3.0, (double *)&c,
+            (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+
+
+    // Operate in in-place mode
+    r = mat_a;
+    la_d33gemm_nnos((double *)&r, (double *)&mat_b, (double *)&r);
+    la_dgemm_nnos(3, 3, 3, (double *)&mat_a, 3, (double *)&mat_b, 3, (double *)&res, 3);
+    ck_assert_mat_eq(&r, &res);
+}
+END_TEST
+
+
+START_TEST(test_la_d33gecongr_tos)
+{
+    struct matrix3x3 ae;
+    struct matrix3x3 r;
+    struct matrix3x3 res;
+
+    la_dgemm_nnos(3, 3, 3, (double *)&mat_a, 3, (double *)&mat_b, 3, (double *)&ae, 3);
+    la_dgemm_tnos(3, 3, 3, (double *)&mat_b, 3, (double *)&ae, 3, (double *)&res, 3);
+    la_d33gecongr_tos((double *)&mat_b, (double *)&mat_a, (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+}
+END_TEST
+
+
+START_TEST(test_la_dsytrf_los)
+{
+    enum { N = 4 };
+    const double a[N * N] = {
+        4.0, 1.0, 2.0, 0.5,
+        1.0, 5.0, 1.0, 1.0,
+        2.0, 1.0, 6.0, 2.0,
+        0.5, 1.0, 2.0, 3.0 };
+    const double x[N] = { 1.0, -2.0, 3.0, 0.5 };
+    double ld[N * N];
+    double b[N];
+    double r[N];
+
+    for (int i = 0; i < N; i++) {
+        b[i] = 0.0;
+        for (int j = 0; j < N; j++) b[i] += a[i * N + j] * x[j];
+    }
+
+    // A x = L D L^T x = b
+    la_dsytrf_los(N, a, N, ld, N);
+    la_trsv_lnd(N, ld, N, b, 1, r, 1);
+    for (int i = 0; i < N; i++) r[i] /= ld[i * N + i];
+    la_trsv_ltd(N, ld, N, r, 1, r, 1);
+
+    for (int i = 0; i < N; i++) ck_assert_flt_eq(r[i], x[i]);
+}
+END_TEST
+
+
+START_TEST(test_la_d33crossgemm)
+{
+    struct matrix3x3 c = {
+        .row_x = { 3.0, 4.0, 5.0 },
+        .row_y = { 4.0, 5.0, 6.0 },
+        .row_z = { 6.0, 7.0, 8.0 } };
+    struct matrix3x3 rx;
+    struct matrix3x3 r;
+    struct matrix3x3 res;
+
+    la_dcrossop((double *)&vec_x, 1, (double *)&rx, 3);
+
+    la_dgemm_nnoe(3, 3, 3,
+            2.0, (double *)&rx, 3, (double *)&mat_a, 3,
+            3.0, (double *)&c, 3,
+            (double *)&res, 3);
+    la_d33crossgemm_noe(
+            2.0, (double *)&vec_x, (double *)&mat_a,
+            3.0, (double *)&c,
+            (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+
+    la_dgemm_ntoe(3, 3, 3,
+            2.0, (double *)&rx, 3, (double *)&mat_a, 3,
+            3.0, (double *)&c, 3,
+            (double *)&res, 3);
+    la_d33crossgemm_toe(
+            2.0, (double *)&vec_x, (double *)&mat_a,
+            3.0, (double *)&c,
+            (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+
+    la_dgemm_nnoe(3, 3, 3,
+            -1.0, (double *)&mat_a, 3, (double *)&rx, 3,
+            3.0, (double *)&c, 3,
+            (double *)&res, 3);
+    la_d33gemmcross_noe(
+            -1.0, (double *)&mat_a, (double *)&vec_x,
+            3.0, (double *)&c,
+            (double *)&r);
+    ck_assert_mat_eq(&r, &res);
+}
+END_TEST
+
+
+// Compare the vectorized unit-stride paths of every instruction set available
+// on this machine against plain loops for all tail lengths
+START_TEST(test_la_isa)
+{
+    enum { N = 19 };
+    double x[N * N];
+    double y[N * N];
+    double z[N * N];
+    double r[N * N];
+
+    for (int i = 0; i < N * N; i++) {
+        x[i] = 0.5 * (i % 7) - 1.0;
+        y[i] = 0.25 * (i % 5) + 1.0;
+    }
+
+    enum la_isa isa = la_get_isa();
+    ck_assert_int_eq(la_set_isa(LA_ISA_SCALAR), 0);
+    ck_assert_int_eq(la_get_isa(), LA_ISA_SCALAR);
+
+    for (int k = LA_ISA_SCALAR; k <= LA_ISA_AVX512; k++) {
+        if (la_set_isa((enum la_isa)k) != 0) continue;
+
+        for (int n = 1; n <= N; n++) {
+            la_daxpy_oe(n * n, -2.0, x, 1, y, 1, z, 1);
+            for (int i = 0; i < n * n; i++) ck_assert_flt_eq(z[i], -2.0 * x[i] + y[i]);
+
+            la_dscal_o(n * n, 3.0, x, 1, z, 1);
+            for (int i = 0; i < n * n; i++) ck_assert_flt_eq(z[i], 3.0 * x[i]);
+
+            double dot;
+            double res = 0.0;
+            la_ddot(n, x, 1, y, 1, &dot);
+            for (int i = 0; i < n; i++) res += x[i] * y[i];
+            ck_assert_flt_eq(dot, res);
+
+            // y with a leading dimension of N
+            la_dgeadd_os(n, n, x, n, y, N, z, n);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    ck_assert_flt_eq(z[i * n + j], x[i * n + j] + y[i * N + j]);
+                }
+            }
+
+            la_dgemv_tos(n, n, x, n, y, 1, z, 1);
+            la_dgemv_toe(n, n, 2.0, x, n, y, 1, -1.0, &y[N], 1, r, 1);
+            for (int i = 0; i < n; i++) {
+                double yi = 0.0;
+                for (int j = 0; j < n; j++) yi += x[j * n + i] * y[j];
+                ck_assert_flt_eq(z[i], yi);
+                ck_assert_flt_eq(r[i], 2.0 * yi - y[N + i]);
+            }
+
+            la_dgemm_nnos(n, n, n, x, n, y, N, z, n);
+            la_dgemm_ntoe(n, n, n, 2.0, x, n, y, N, 1.0, x, n, r, n);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    double nn = 0.0;
+                    double nt = 0.0;
+                    for (int l = 0; l < n; l++) {
+                        nn += x[i * n + l] * y[l * N + j];
+                        nt += x[i * n + l] * y[j * N + l];
+                    }
+                    ck_assert_flt_eq(z[i * n + j], nn);
+                    ck_assert_flt_eq(r[i * n + j], 2.0 * nt + x[i * n + j]);
+                }
+            }
+        }
+    }
+
+    ck_assert_int_eq(la_set_isa(isa), 0);
+}
+END_TEST
+
+
 TCase *linear_algebra_test()
 {
     TCase *tc = tcase_create("LinearAlgebra");
@@ -726,6 +1045,7 @@ TCase *linear_algebra_test()
     tcase_add_test(tc, test_la_daxpy_oe);
     tcase_add_test(tc, test_la_daxpy_ie);
     tcase_add_test(tc, test_la_ddot);
+    tcase_add_test(tc, test_la_dsincos);
     tcase_add_test(tc, test_la_dcross_o);
     tcase_add_test(tc, test_la_dcrossop);
     tcase_add_test(tc, test_la_dgemv_nos);
@@ -739,6 +1059,12 @@ TCase *linear_algebra_test()
     tcase_add_test(tc, test_la_dgemm_nnoe);
     tcase_add_test(tc, test_la_dgemm_tnoe);
     tcase_add_test(tc, test_la_dgemm_ntoe);
+    tcase_add_test(tc, test_la_d33gemv);
+    tcase_add_test(tc, test_la_d33gemm);
+    tcase_add_test(tc, test_la_d33gecongr_tos);
+    tcase_add_test(tc, test_la_d33crossgemm);
+    tcase_add_test(tc, test_la_dsytrf_los);
+    tcase_add_test(tc, test_la_isa);
 
     return tc;
 }
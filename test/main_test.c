@@ -4,6 +4,9 @@ extern TCase *linear_algebra_test();
 extern TCase *geometry_test();
 extern TCase *mechanics_test();
 extern TCase *kinematic_chain_test();
+extern TCase *solver_state_test();
+extern TCase *solver_test();
+extern TCase *executor_test();
 
 
 int main(int argc, char **argv)
@@ -13,6 +16,9 @@ int main(int argc, char **argv)
     suite_add_tcase(s, geometry_test());
     suite_add_tcase(s, mechanics_test());
     suite_add_tcase(s, kinematic_chain_test());
+    suite_add_tcase(s, solver_state_test());
+    suite_add_tcase(s, solver_test());
+    suite_add_tcase(s, executor_test());
 
     SRunner *sr = srunner_create(s);
 
@@ -91,11 +91,28 @@ START_TEST(test_mc_momentum_derive)
     struct vector3 res_ang = { -69.0, 27.0, 13.0 };
     struct vector3 res_lin = { -20.0,  4.0,  4.0 };
 
-    mc_momentum_derive(&xdc, &p, &r);
+    mc_momentum_derive(&xdc, &p, &r, 1);
     for (int i = 0; i < 3; i++) {
         ck_assert_flt_eq(r.torque->data[i], res_ang.data[i]);
         ck_assert_flt_eq(r.force->data[i], res_lin.data[i]);
     }
+
+
+    // structure of arrays: the derivative is linear in the momentum
+    struct gc_twist xd2 = {
+        .angular_velocity = (struct vector3 [2]) { { 1.0, 2.0, 3.0 }, { 1.0, 2.0, 3.0 } },
+        .linear_velocity = (struct vector3 [2]) { { 3.0, 4.0, 5.0 }, { 3.0, 4.0, 5.0 } } };
+    struct mc_momentum p2 = {
+        .angular_momentum = (struct vector3 [2]) { { 24.0, 41.0, 41.0 }, { 48.0, 82.0, 82.0 } },
+        .linear_momentum = (struct vector3 [2]) { { 4.0, 12.0,  8.0 }, { 8.0, 24.0, 16.0 } } };
+
+    mc_momentum_derive(&xd2, &p2, &r, 2);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_flt_eq(r.torque[0].data[i], res_ang.data[i]);
+        ck_assert_flt_eq(r.force[0].data[i], res_lin.data[i]);
+        ck_assert_flt_eq(r.torque[1].data[i], 2.0 * res_ang.data[i]);
+        ck_assert_flt_eq(r.force[1].data[i], 2.0 * res_lin.data[i]);
+    }
 }
 END_TEST
 
@@ -282,6 +299,56 @@ START_TEST(test_ma_rbi_map_twist_to_momentum)
 END_TEST
 
 
+START_TEST(test_mc_rbi_map_acc_twist_to_wrench)
+{
+    struct mc_rbi m = {
+        .zeroth_moment_of_mass = 2.0,
+        .first_moment_of_mass = { 4.0, 6.0, 8.0 },
+        .second_moment_of_mass = {
+            .row_x = { 3.0, 4.0, 5.0 },
+            .row_y = { 4.0, 6.0, 7.0 },
+            .row_z = { 5.0, 7.0, 8.0 } } };
+    struct gc_acc_twist xdd = {
+        .angular_acceleration = xdc.angular_velocity,
+        .linear_acceleration = xdc.linear_velocity };
+    struct mc_wrench r = {
+        .torque = (struct vector3 [1]) {},
+        .force = (struct vector3 [1]) {} };
+
+    // same map as from a twist to a momentum
+    struct vector3 res_torque = { 24.0, 41.0, 41.0 };
+    struct vector3 res_force = {  4.0, 12.0,  8.0 };
+
+    mc_rbi_map_acc_twist_to_wrench(&m, &xdd, &r);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_flt_eq(r.torque[0].data[i], res_torque.data[i]);
+        ck_assert_flt_eq(r.force[0].data[i], res_force.data[i]);
+    }
+}
+END_TEST
+
+
+START_TEST(test_ma_rbi_map_acc_twist_to_wrench)
+{
+    struct ma_rbi m = {
+        .body = &body_a,
+        .point = &point_a,
+        .frame = &frame_a
+    };
+    struct ga_acc_twist xdd = {
+        .target_body = &body_a, .reference_body = &body_b,
+        .point = &point_a, .frame = &frame_a
+    };
+    struct ma_wrench r;
+
+    ma_rbi_map_acc_twist_to_wrench(&m, &xdd, &r);
+    ck_assert_ptr_eq(r.body, &body_a);
+    ck_assert_ptr_eq(r.point, &point_a);
+    ck_assert_ptr_eq(r.frame, &frame_a);
+}
+END_TEST
+
+
 START_TEST(test_mc_rbi_to_abi)
 {
     struct mc_rbi m = {
@@ -335,6 +402,68 @@ START_TEST(test_ma_rbi_to_abi)
 END_TEST
 
 
+START_TEST(test_mc_rbi_tf_tgt_to_ref)
+{
+    struct mc_rbi m = {
+        .zeroth_moment_of_mass = 2.0,
+        .first_moment_of_mass = { 4.0, 6.0, 8.0 },
+        .second_moment_of_mass = {
+            .row_x = { 3.0, 4.0, 5.0 },
+            .row_y = { 4.0, 6.0, 7.0 },
+            .row_z = { 5.0, 7.0, 8.0 } } };
+    struct mc_rbi r;
+    struct mc_abi m_abi;
+    struct mc_abi r_abi;
+    struct mc_abi res;
+
+    mc_rbi_tf_tgt_to_ref(&xc, &m, &r);
+    ck_assert_flt_eq(r.zeroth_moment_of_mass, m.zeroth_moment_of_mass);
+
+    mc_rbi_to_abi(&m, &m_abi);
+    mc_abi_tf_tgt_to_ref(&xc, &m_abi, &res);
+    mc_rbi_to_abi(&r, &r_abi);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ck_assert_flt_eq(r_abi.zeroth_moment_of_mass.row[i].data[j], res.zeroth_moment_of_mass.row[i].data[j]);
+            ck_assert_flt_eq(r_abi.first_moment_of_mass.row[i].data[j], res.first_moment_of_mass.row[i].data[j]);
+            ck_assert_flt_eq(r_abi.second_moment_of_mass.row[i].data[j], res.second_moment_of_mass.row[i].data[j]);
+        }
+    }
+}
+END_TEST
+
+
+START_TEST(test_mc_rbi_add)
+{
+    struct mc_rbi m1 = {
+        .zeroth_moment_of_mass = 2.0,
+        .first_moment_of_mass = { 4.0, 6.0, 8.0 },
+        .second_moment_of_mass = {
+            .row_x = { 3.0, 4.0, 5.0 },
+            .row_y = { 4.0, 6.0, 7.0 },
+            .row_z = { 5.0, 7.0, 8.0 } } };
+    struct mc_rbi m2 = {
+        .zeroth_moment_of_mass = 1.0,
+        .first_moment_of_mass = { 1.0, 2.0, 3.0 },
+        .second_moment_of_mass = {
+            .row_x = { 1.0, 2.0, 3.0 },
+            .row_y = { 2.0, 4.0, 5.0 },
+            .row_z = { 3.0, 5.0, 6.0 } } };
+    struct mc_rbi r;
+
+    mc_rbi_add(&m1, &m2, &r);
+    ck_assert_flt_eq(r.zeroth_moment_of_mass, 3.0);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_flt_eq(r.first_moment_of_mass.data[i], m1.first_moment_of_mass.data[i] + m2.first_moment_of_mass.data[i]);
+        for (int j = 0; j < 3; j++) {
+            ck_assert_flt_eq(r.second_moment_of_mass.row[i].data[j],
+                    m1.second_moment_of_mass.row[i].data[j] + m2.second_moment_of_mass.row[i].data[j]);
+        }
+    }
+}
+END_TEST
+
+
 START_TEST(test_mc_abi_tf_tgt_to_ref)
 {
     struct mc_abi m;
@@ -468,6 +597,117 @@ START_TEST(test_ma_abi_map_acc_twist_to_wrench)
 END_TEST
 
 
+START_TEST(test_mc_abi_pack)
+{
+    struct mc_abi_packed p;
+    struct mc_abi r;
+
+    mc_abi_pack(&mc, &p);
+    ck_assert_flt_eq(p.second_moment_of_mass[MC_SYM33(1, 2)], 7.0);
+    ck_assert_flt_eq(p.second_moment_of_mass[MC_SYM33(2, 1)], 7.0);
+    ck_assert_flt_eq(p.zeroth_moment_of_mass[MC_SYM33(2, 2)], 4.0);
+
+    mc_abi_unpack(&p, &r);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ck_assert_flt_eq(r.zeroth_moment_of_mass.row[i].data[j], mc.zeroth_moment_of_mass.row[i].data[j]);
+            ck_assert_flt_eq(r.first_moment_of_mass.row[i].data[j], mc.first_moment_of_mass.row[i].data[j]);
+            ck_assert_flt_eq(r.second_moment_of_mass.row[i].data[j], mc.second_moment_of_mass.row[i].data[j]);
+        }
+    }
+}
+END_TEST
+
+
+// The packed operations must agree with their full counterparts
+static void ck_assert_abi_eq(
+        const struct mc_abi_packed *m,
+        const struct mc_abi *res)
+{
+    struct mc_abi r;
+
+    mc_abi_unpack(m, &r);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ck_assert_flt_eq(r.zeroth_moment_of_mass.row[i].data[j], res->zeroth_moment_of_mass.row[i].data[j]);
+            ck_assert_flt_eq(r.first_moment_of_mass.row[i].data[j], res->first_moment_of_mass.row[i].data[j]);
+            ck_assert_flt_eq(r.second_moment_of_mass.row[i].data[j], res->second_moment_of_mass.row[i].data[j]);
+        }
+    }
+}
+
+
+START_TEST(test_mc_rbi_to_abi_packed)
+{
+    struct mc_rbi m = {
+        .zeroth_moment_of_mass = 2.0,
+        .first_moment_of_mass = { 4.0, 6.0, 8.0 },
+        .second_moment_of_mass = {
+            .row_x = { 3.0, 4.0, 5.0 },
+            .row_y = { 4.0, 6.0, 7.0 },
+            .row_z = { 5.0, 7.0, 8.0 } } };
+    struct mc_abi_packed r;
+    struct mc_abi res;
+
+    mc_rbi_to_abi(&m, &res);
+    mc_rbi_to_abi_packed(&m, &r);
+    ck_assert_abi_eq(&r, &res);
+}
+END_TEST
+
+
+START_TEST(test_mc_abi_packed_tf_tgt_to_ref)
+{
+    struct mc_abi_packed m;
+    struct mc_abi_packed r;
+    struct mc_abi res;
+
+    mc_abi_pack(&mc, &m);
+    mc_abi_tf_tgt_to_ref(&xc, &mc, &res);
+    mc_abi_packed_tf_tgt_to_ref(&xc, &m, &r);
+    ck_assert_abi_eq(&r, &res);
+}
+END_TEST
+
+
+START_TEST(test_mc_abi_packed_add)
+{
+    struct mc_abi_packed m;
+    struct mc_abi_packed r;
+    struct mc_abi res;
+
+    mc_abi_pack(&mc, &m);
+    mc_abi_add(&mc, &mc, &res);
+    mc_abi_packed_add(&m, &m, &r);
+    ck_assert_abi_eq(&r, &res);
+}
+END_TEST
+
+
+START_TEST(test_mc_abi_packed_map_acc_twist_to_wrench)
+{
+    struct mc_abi_packed m;
+    struct gc_acc_twist xdd = {
+        .angular_acceleration = (struct vector3 [1]) { 1.0, 2.0, 3.0 },
+        .linear_acceleration = (struct vector3 [1]) { 3.0, 4.0, 5.0 } };
+    struct mc_wrench f = {
+        .torque = (struct vector3 [1]) {},
+        .force = (struct vector3 [1]) {} };
+    struct mc_wrench res = {
+        .torque = (struct vector3 [1]) {},
+        .force = (struct vector3 [1]) {} };
+
+    mc_abi_pack(&mc, &m);
+    mc_abi_map_acc_twist_to_wrench(&mc, &xdd, &res);
+    mc_abi_packed_map_acc_twist_to_wrench(&m, &xdd, &f);
+    for (int i = 0; i < 3; i++) {
+        ck_assert_flt_eq(f.torque[0].data[i], res.torque[0].data[i]);
+        ck_assert_flt_eq(f.force[0].data[i], res.force[0].data[i]);
+    }
+}
+END_TEST
+
+
 TCase *mechanics_test()
 {
     TCase *tc = tcase_create("Mechanics");
@@ -484,14 +724,23 @@ TCase *mechanics_test()
     tcase_add_test(tc, test_ma_wrench_sub);
     tcase_add_test(tc, test_mc_rbi_map_twist_to_momentum);
     tcase_add_test(tc, test_ma_rbi_map_twist_to_momentum);
+    tcase_add_test(tc, test_mc_rbi_map_acc_twist_to_wrench);
+    tcase_add_test(tc, test_ma_rbi_map_acc_twist_to_wrench);
     tcase_add_test(tc, test_mc_rbi_to_abi);
     tcase_add_test(tc, test_ma_rbi_to_abi);
+    tcase_add_test(tc, test_mc_rbi_tf_tgt_to_ref);
+    tcase_add_test(tc, test_mc_rbi_add);
     tcase_add_test(tc, test_mc_abi_tf_tgt_to_ref);
     tcase_add_test(tc, test_ma_abi_tf_tgt_to_ref);
     tcase_add_test(tc, test_mc_abi_add);
     tcase_add_test(tc, test_ma_abi_add);
     tcase_add_test(tc, test_mc_abi_map_acc_twist_to_wrench);
     tcase_add_test(tc, test_ma_abi_map_acc_twist_to_wrench);
+    tcase_add_test(tc, test_mc_abi_pack);
+    tcase_add_test(tc, test_mc_rbi_to_abi_packed);
+    tcase_add_test(tc, test_mc_abi_packed_tf_tgt_to_ref);
+    tcase_add_test(tc, test_mc_abi_packed_add);
+    tcase_add_test(tc, test_mc_abi_packed_map_acc_twist_to_wrench);
 
     return tc;
 }
@@ -0,0 +1,141 @@
+#include <dyn2b/functions/solver_state.h>
+#include <check.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+
+static struct matrix3x3 rotation = {
+    .row_x = { 1.0, 0.0, 0.0 },
+    .row_y = { 0.0, 1.0, 0.0 },
+    .row_z = { 0.0, 0.0, 1.0 }
+};
+static struct vector3 translation = { { 0.0, 0.0, 0.0 } };
+static double inertia[3];
+
+#define SEGMENT(i) { \
+    .joint_attachment = { .rotation = &rotation, .translation = &translation }, \
+    .joint = { \
+        .type = JOINT_TYPE_REVOLUTE, \
+        .revolute_joint = { .axis = JOINT_AXIS_Z, .inertia = &inertia[i] } \
+    } \
+}
+
+static struct kcc_segment segments[3] = { SEGMENT(0), SEGMENT(1), SEGMENT(2) };
+
+static struct kcc_kinematic_chain chain = {
+    .number_of_segments = 3,
+    .segment = segments
+};
+
+
+static int in_arena(const void *p, const void *memory, size_t size)
+{
+    return (const char *)p >= (const char *)memory
+            && (const char *)p < (const char *)memory + size;
+}
+
+
+START_TEST(test_solver_state_init_c)
+{
+    size_t size = solver_state_size_c(&chain);
+    ck_assert_msg(size > 0, "empty arena");
+    ck_assert_msg(size % SOLVER_STATE_ALIGNMENT == 0, "arena size not aligned");
+
+    void *memory = aligned_alloc(SOLVER_STATE_ALIGNMENT, size);
+    memset(memory, 0xff, size);
+
+    struct solver_state_c s;
+    solver_state_init_c(&chain, &s, memory);
+    ck_assert_ptr_eq(s.memory, NULL);
+    ck_assert_msg(s.nbody == 3 && s.nq == 3 && s.nd == 3, "wrong dimensions");
+
+    // every array is cache-line aligned and lives in the arena
+    const void *arrays[] = {
+        s.x_jnt, s.x_rel, s.x_tot, s.xd_jnt, s.xd_tf, s.xd,
+        s.xdd_jnt, s.xdd_bias, s.xdd_net, s.xdd_tf, s.xdd_nact, s.xdd,
+        s.q, s.qd, s.qdd, s.m_art, s.m_app, s.m_tf, s.d,
+        s.p, s.f_bias_art, s.f_bias_eom, s.f_bias_app, s.f_bias_tf,
+        s.f_bias_nact, s.tau_bias_art, s.tau_ff, s.f_ff_art, s.f_ff_app,
+        s.f_ff_jnt, s.tau_ff_art, s.f_ext, s.f_ext_art, s.f_ext_app,
+        s.f_ext_tf, s.tau_ext_art, s.tau_ctrl
+    };
+    for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+        ck_assert_msg(in_arena(arrays[i], memory, size), "array %zu outside arena", i);
+        ck_assert_msg((uintptr_t)arrays[i] % SOLVER_STATE_ALIGNMENT == 0, "array %zu misaligned", i);
+    }
+
+    // the coordinates are stored in the arena, too
+    ck_assert_msg(in_arena(s.x_tot[3].translation, memory, size), "pose outside arena");
+    ck_assert_msg(in_arena(s.xdd[3].linear_acceleration, memory, size), "twist outside arena");
+    ck_assert_msg(in_arena(s.f_ext_art[3].force, memory, size), "wrench outside arena");
+    ck_assert_msg(in_arena(&s.tau_ctrl[2], memory, size), "torque outside arena");
+
+    // structure of arrays: the elements' coordinates are contiguous slabs
+    for (int i = 1; i < 4; i++) {
+        ck_assert_ptr_eq(s.x_tot[i].rotation, s.x_tot[0].rotation + i);
+        ck_assert_ptr_eq(s.x_tot[i].translation, s.x_tot[0].translation + i);
+        ck_assert_ptr_eq(s.xd[i].angular_velocity, s.xd[0].angular_velocity + i);
+        ck_assert_ptr_eq(s.xdd[i].linear_acceleration, s.xdd[0].linear_acceleration + i);
+        ck_assert_ptr_eq(s.f_bias_art[i].torque, s.f_bias_art[0].torque + i);
+        ck_assert_ptr_eq(s.f_bias_art[i].force, s.f_bias_art[0].force + i);
+    }
+    ck_assert_ptr_eq(s.p[2].linear_momentum, s.p[0].linear_momentum + 2);
+
+    // zero state with the base at the identity pose
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ck_assert_msg(s.x_tot[0].rotation->row[i].data[j] == (i == j ? 1.0 : 0.0), "base pose");
+        }
+        ck_assert_msg(s.x_tot[0].translation->data[i] == 0.0, "base pose");
+        ck_assert_msg(s.xdd[0].linear_acceleration->data[i] == 0.0, "base acceleration");
+    }
+    ck_assert_msg(s.q[2] == 0.0 && s.tau_ctrl[2] == 0.0, "joint state");
+
+    // caller-owned arena is left alone
+    solver_state_destroy_c(&s);
+    ck_assert_ptr_eq(s.x_jnt, NULL);
+
+    free(memory);
+}
+END_TEST
+
+
+START_TEST(test_solver_state_create_c)
+{
+    struct solver_state_c s;
+
+    ck_assert_int_eq(solver_state_create_c(&chain, &s), 0);
+    ck_assert_msg(s.memory != NULL, "arena not owned");
+    ck_assert_ptr_eq(s.memory, s.x_jnt);
+    ck_assert_msg(s.x_tot[0].rotation->row_z.z == 1.0, "base pose");
+
+    solver_state_destroy_c(&s);
+    ck_assert_ptr_eq(s.memory, NULL);
+
+    // a chain that is neither verified nor complete is rejected
+    struct kcc_segment faulty[3] = { SEGMENT(0), SEGMENT(1), SEGMENT(2) };
+    struct kcc_kinematic_chain incomplete = {
+        .number_of_segments = 3,
+        .segment = faulty
+    };
+    faulty[1].joint.revolute_joint.inertia = NULL;
+    ck_assert_int_eq(solver_state_create_c(&incomplete, &s), -1);
+
+    // the token of kcc_verify() skips the check
+    incomplete.verified = 1;
+    ck_assert_int_eq(solver_state_create_c(&incomplete, &s), 0);
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+TCase *solver_state_test()
+{
+    TCase *tc = tcase_create("SolverState");
+
+    tcase_add_test(tc, test_solver_state_init_c);
+    tcase_add_test(tc, test_solver_state_create_c);
+
+    return tc;
+}
@@ -0,0 +1,1713 @@
+#include <dyn2b/functions/solver.h>
+#include <dyn2b/functions/solver_state.h>
+#include <dyn2b/functions/geometry.h>
+#include <dyn2b/functions/kinematic_chain.h>
+#include <dyn2b/functions/linear_algebra.h>
+#include <check.h>
+#include <math.h>
+#include <stdlib.h>
+
+
+#ifdef ck_assert_double_eq_tol
+#  define ck_assert_flt_eq(X, Y) ck_assert_double_eq_tol(X, Y, 0.0001)
+#else
+#  define ck_assert_flt_eq(X, Y) do { \
+     double _dist = fabs((double)(X) - (double)(Y)); \
+     ck_assert_msg(_dist < (0.0001), "Assertion '%s' failed: %s == %f, %s == %f", #X" == "#Y, #X, (X), #Y, (Y)); \
+   } while (0)
+#endif
+
+
+static const double G = 9.81;
+
+
+// Planar two-link arm with revolute joints about the z-axis: each link is a
+// point mass m = 2.0 at distance c = 1.0 from its joint, the links have a
+// length of l = 2.0 and each joint has a rotor inertia of 1.0.
+static struct kcc_segment planar_segments[] = {
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = {
+                .axis = JOINT_AXIS_Z,
+                .inertia = (double [1]) { 1.0 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .first_moment_of_mass = { { 2.0, 0.0, 0.0 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.0, 0.0, 0.0 },
+                .row_y = { 0.0, 2.0, 0.0 },
+                .row_z = { 0.0, 0.0, 2.0 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 2.0, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = {
+                .axis = JOINT_AXIS_Z,
+                .inertia = (double [1]) { 1.0 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .first_moment_of_mass = { { 2.0, 0.0, 0.0 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.0, 0.0, 0.0 },
+                .row_y = { 0.0, 2.0, 0.0 },
+                .row_z = { 0.0, 0.0, 2.0 }
+            }
+        }
+    }
+};
+
+static struct kcc_kinematic_chain planar_one_link = {
+    .number_of_segments = 1,
+    .segment = planar_segments
+};
+
+static struct kcc_kinematic_chain planar_two_link = {
+    .number_of_segments = 2,
+    .segment = planar_segments
+};
+
+
+// Closed-form equation of motion of the planar two-link arm under gravity
+// along the negative y-axis: M(q) qdd + C(q, qd) + G(q) = tau
+static void planar_two_link_fd(
+        const double *q,
+        const double *qd,
+        const double *tau,
+        double *qdd)
+{
+    double m11 = 13.0 + 8.0 * cos(q[1]);
+    double m12 = 2.0 + 4.0 * cos(q[1]);
+    double m22 = 3.0;
+    double h = -4.0 * sin(q[1]);
+    double c1 = h * (2.0 * qd[0] * qd[1] + qd[1] * qd[1]);
+    double c2 = -h * qd[0] * qd[0];
+    double g1 = 6.0 * G * cos(q[0]) + 2.0 * G * cos(q[0] + q[1]);
+    double g2 = 2.0 * G * cos(q[0] + q[1]);
+
+    double b1 = tau[0] - c1 - g1;
+    double b2 = tau[1] - c2 - g2;
+    double det = m11 * m22 - m12 * m12;
+
+    qdd[0] = ( m22 * b1 - m12 * b2) / det;
+    qdd[1] = (-m12 * b1 + m11 * b2) / det;
+}
+
+
+START_TEST(test_kcc_aba_one_link)
+{
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&planar_one_link, &s), 0);
+    s.xdd[0].linear_acceleration->y = G;
+
+    joint_position q[1] = { M_PI / 3.0 };
+    joint_velocity qd[1] = { 2.0 };
+    joint_torque tau[1] = { 1.0 };
+    joint_acceleration qdd[1];
+
+    kcc_aba(&planar_one_link, q, qd, tau, NULL, &s, qdd);
+    ck_assert_flt_eq(qdd[0], (1.0 - 2.0 * G * cos(q[0])) / 3.0);
+
+
+    // a pure torque about the joint axis acts like a joint torque
+    struct mc_wrench f_ext = {
+        .torque = (struct vector3 [1]) { { 0.0, 0.0, 0.5 } },
+        .force = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } }
+    };
+
+    kcc_aba(&planar_one_link, q, qd, tau, &f_ext, &s, qdd);
+    ck_assert_flt_eq(qdd[0], (1.5 - 2.0 * G * cos(q[0])) / 3.0);
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+START_TEST(test_kcc_aba_two_link)
+{
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&planar_two_link, &s), 0);
+    s.xdd[0].linear_acceleration->y = G;
+
+    joint_position q[4][2] = {
+        { 0.0, 0.0 }, { 1.0, 1.0 }, { -0.5, 2.0 }, { 0.3, -1.2 } };
+    joint_velocity qd[4][2] = {
+        { 0.0, 0.0 }, { 1.0, 1.0 }, { 2.0, -1.0 }, { -0.7, 0.4 } };
+    joint_torque tau[4][2] = {
+        { 0.0, 0.0 }, { 1.0, 1.0 }, { 5.0, -2.0 }, { 0.0, 3.0 } };
+
+    for (int k = 0; k < 4; k++) {
+        joint_acceleration qdd[2];
+        joint_acceleration res[2];
+
+        // the solver state is reused without resetting it in between
+        kcc_aba(&planar_two_link, q[k], qd[k], tau[k], NULL, &s, qdd);
+        planar_two_link_fd(q[k], qd[k], tau[k], res);
+        ck_assert_flt_eq(qdd[0], res[0]);
+        ck_assert_flt_eq(qdd[1], res[1]);
+    }
+
+
+    // pure torques about the joint axes map to J^T F_ext = (0.5 + 0.25, 0.25)
+    struct mc_wrench f_ext = {
+        .torque = (struct vector3 [2]) { { 0.0, 0.0, 0.5 }, { 0.0, 0.0, 0.25 } },
+        .force = (struct vector3 [2]) { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } }
+    };
+
+    for (int k = 0; k < 4; k++) {
+        joint_acceleration qdd[2];
+        joint_acceleration res[2];
+        joint_torque tau_ext[2] = { tau[k][0] + 0.75, tau[k][1] + 0.25 };
+
+        kcc_aba(&planar_two_link, q[k], qd[k], tau[k], &f_ext, &s, qdd);
+        planar_two_link_fd(q[k], qd[k], tau_ext, res);
+        ck_assert_flt_eq(qdd[0], res[0]);
+        ck_assert_flt_eq(qdd[1], res[1]);
+    }
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+// Spatial chain with revolute joints about all three axes, rotated joint
+// attachments and links whose centre of mass is off the joint axes
+static struct kcc_segment spatial_segments[] = {
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 0.1 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = {
+                .axis = JOINT_AXIS_Z,
+                .inertia = (double [1]) { 0.2 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 3.0,
+            .first_moment_of_mass = { { 0.3, 0.0, 0.6 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.5, 0.0, -0.1 },
+                .row_y = { 0.0, 0.6, 0.0 },
+                .row_z = { -0.1, 0.0, 0.2 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 0.0, 0.0, -1.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 1.0, 0.0, 0.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.1, 0.0, 0.4 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = {
+                .axis = JOINT_AXIS_Y,
+                .inertia = (double [1]) { 0.1 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .first_moment_of_mass = { { 0.5, 0.2, 0.0 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.3, 0.05, 0.0 },
+                .row_y = { 0.05, 0.4, 0.0 },
+                .row_z = { 0.0, 0.0, 0.5 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 0.6, 0.8, 0.0 },
+                .row_y = { -0.8, 0.6, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.3, -0.1, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = {
+                .axis = JOINT_AXIS_X,
+                .inertia = (double [1]) { 0.05 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 1.0,
+            .first_moment_of_mass = { { 0.2, 0.1, -0.1 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.1, 0.0, 0.0 },
+                .row_y = { 0.0, 0.2, 0.02 },
+                .row_z = { 0.0, 0.02, 0.15 }
+            }
+        }
+    }
+};
+
+static struct kcc_kinematic_chain spatial_three_link = {
+    .number_of_segments = 3,
+    .segment = spatial_segments
+};
+
+
+START_TEST(test_kcc_crba_two_link)
+{
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&planar_two_link, &s), 0);
+
+    joint_position q[3][2] = { { 0.0, 0.0 }, { 1.0, 1.0 }, { -0.5, 2.0 } };
+
+    for (int k = 0; k < 3; k++) {
+        joint_inertia m[2][2];
+        joint_inertia mp[3];
+
+        kcc_crba(&planar_two_link, q[k], &s, &m[0][0]);
+        ck_assert_flt_eq(m[0][0], 13.0 + 8.0 * cos(q[k][1]));
+        ck_assert_flt_eq(m[0][1], 2.0 + 4.0 * cos(q[k][1]));
+        ck_assert_flt_eq(m[1][0], 2.0 + 4.0 * cos(q[k][1]));
+        ck_assert_flt_eq(m[1][1], 3.0);
+
+        kcc_crba_packed(&planar_two_link, q[k], &s, mp);
+        ck_assert_flt_eq(mp[0], m[0][0]);
+        ck_assert_flt_eq(mp[1], m[1][0]);
+        ck_assert_flt_eq(mp[2], m[1][1]);
+    }
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+START_TEST(test_kcc_crba_spatial)
+{
+    enum { N = 3 };
+
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&spatial_three_link, &s), 0);
+    s.xdd[0].linear_acceleration->z = G;
+
+    for (int k = 0; k < 5; k++) {
+        joint_position q[N];
+        joint_velocity qd[N];
+        joint_torque tau[N];
+        for (int j = 0; j < N; j++) {
+            q[j] = sin(1.3 * k + j);
+            qd[j] = cos(0.7 * k - 2.0 * j);
+            tau[j] = 0.5 * sin(0.3 * k * j + 1.0);
+        }
+
+        // M(q) qdd = tau - C(q, qd) with qdd from the forward dynamics
+        joint_acceleration qdd[N];
+        joint_torque c[N];
+        joint_inertia m[N][N];
+        joint_inertia mp[N * (N + 1) / 2];
+        kcc_aba(&spatial_three_link, q, qd, tau, NULL, &s, qdd);
+        kcc_rnea(&spatial_three_link, q, qd, NULL, NULL, &s, c);
+        kcc_crba(&spatial_three_link, q, &s, &m[0][0]);
+        kcc_crba_packed(&spatial_three_link, q, &s, mp);
+
+        for (int i = 0; i < N; i++) {
+            double mqdd = 0.0;
+            for (int j = 0; j < N; j++) {
+                mqdd += m[i][j] * qdd[j];
+                ck_assert_flt_eq(m[i][j], m[j][i]);
+                if (j <= i) ck_assert_flt_eq(mp[i * (i + 1) / 2 + j], m[i][j]);
+            }
+            ck_assert_flt_eq(mqdd, tau[i] - c[i]);
+        }
+    }
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+START_TEST(test_kcc_aba_batch_two_link)
+{
+    enum { COUNT = 11 };
+
+    struct solver_state_lanes_c s;
+    ck_assert_int_eq(solver_state_create_lanes_c(&planar_two_link, &s), 0);
+
+    struct gc_acc_twist xdd_base = {
+        .angular_acceleration = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } },
+        .linear_acceleration = (struct vector3 [1]) { { 0.0, G, 0.0 } }
+    };
+
+    joint_position q[COUNT][2];
+    joint_velocity qd[COUNT][2];
+    joint_torque tau[COUNT][2];
+    for (int k = 0; k < COUNT; k++) {
+        q[k][0] = 0.3 * k - 1.0;
+        q[k][1] = 2.0 - 0.4 * k;
+        qd[k][0] = 0.1 * k;
+        qd[k][1] = -0.2 * k + 0.5;
+        tau[k][0] = 1.0 + 0.5 * k;
+        tau[k][1] = -2.0 + 0.3 * k;
+    }
+
+    enum la_isa isa = la_get_isa();
+    for (int i = LA_ISA_SCALAR; i <= LA_ISA_AVX512; i++) {
+        if (la_set_isa((enum la_isa)i) != 0) continue;
+
+        // the entry behind the batch must not be written
+        joint_acceleration qdd[COUNT + 1][2];
+        qdd[COUNT][0] = qdd[COUNT][1] = -1.0;
+
+        kcc_aba_batch(&planar_two_link, COUNT, &q[0][0], &qd[0][0], &tau[0][0],
+                &xdd_base, &s, &qdd[0][0]);
+
+        for (int k = 0; k < COUNT; k++) {
+            joint_acceleration res[2];
+            planar_two_link_fd(q[k], qd[k], tau[k], res);
+            ck_assert_flt_eq(qdd[k][0], res[0]);
+            ck_assert_flt_eq(qdd[k][1], res[1]);
+        }
+        ck_assert_flt_eq(qdd[COUNT][0], -1.0);
+        ck_assert_flt_eq(qdd[COUNT][1], -1.0);
+    }
+    la_set_isa(isa);
+
+    solver_state_destroy_lanes_c(&s);
+}
+END_TEST
+
+
+START_TEST(test_kcc_aba_batch_spatial)
+{
+    enum { COUNT = 19, N = 3 };
+
+    struct solver_state_c s;
+    struct solver_state_lanes_c sl;
+    ck_assert_int_eq(solver_state_create_c(&spatial_three_link, &s), 0);
+    ck_assert_int_eq(solver_state_create_lanes_c(&spatial_three_link, &sl), 0);
+
+    struct gc_acc_twist xdd_base = {
+        .angular_acceleration = (struct vector3 [1]) { { 0.1, -0.2, 0.3 } },
+        .linear_acceleration = (struct vector3 [1]) { { 0.5, 1.0, G } }
+    };
+    *s.xdd[0].angular_acceleration = *xdd_base.angular_acceleration;
+    *s.xdd[0].linear_acceleration = *xdd_base.linear_acceleration;
+
+    joint_position q[COUNT][N];
+    joint_velocity qd[COUNT][N];
+    joint_torque tau[COUNT][N];
+    for (int k = 0; k < COUNT; k++) {
+        for (int j = 0; j < N; j++) {
+            q[k][j] = sin(1.3 * k + j);
+            qd[k][j] = cos(0.7 * k - 2.0 * j);
+            tau[k][j] = 0.5 * sin(0.3 * k * j + 1.0);
+        }
+    }
+
+    enum la_isa isa = la_get_isa();
+    for (int i = LA_ISA_SCALAR; i <= LA_ISA_AVX512; i++) {
+        if (la_set_isa((enum la_isa)i) != 0) continue;
+
+        joint_acceleration qdd[COUNT][N];
+        kcc_aba_batch(&spatial_three_link, COUNT, &q[0][0], &qd[0][0], &tau[0][0],
+                &xdd_base, &sl, &qdd[0][0]);
+
+        for (int k = 0; k < COUNT; k++) {
+            joint_acceleration res[N];
+            kcc_aba(&spatial_three_link, q[k], qd[k], tau[k], NULL, &s, res);
+            for (int j = 0; j < N; j++) {
+                ck_assert_flt_eq(qdd[k][j], res[j]);
+            }
+        }
+    }
+    la_set_isa(isa);
+
+    solver_state_destroy_lanes_c(&sl);
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+START_TEST(test_kcc_rnea_two_link)
+{
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&planar_two_link, &s), 0);
+    s.xdd[0].linear_acceleration->y = G;
+
+    joint_position q[4][2] = {
+        { 0.0, 0.0 }, { 1.0, 1.0 }, { -0.5, 2.0 }, { 0.3, -1.2 } };
+    joint_velocity qd[4][2] = {
+        { 0.0, 0.0 }, { 1.0, 1.0 }, { 2.0, -1.0 }, { -0.7, 0.4 } };
+    joint_torque tau[4][2] = {
+        { 0.0, 0.0 }, { 1.0, 1.0 }, { 5.0, -2.0 }, { 0.0, 3.0 } };
+
+    struct mc_wrench f_ext = {
+        .torque = (struct vector3 [2]) { { 0.0, 0.0, 0.5 }, { 0.0, 0.0, 0.25 } },
+        .force = (struct vector3 [2]) { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } }
+    };
+
+    for (int k = 0; k < 4; k++) {
+        joint_acceleration qdd[2];
+        joint_torque res[2];
+
+        // inverse of the closed-form forward dynamics
+        planar_two_link_fd(q[k], qd[k], tau[k], qdd);
+        kcc_rnea(&planar_two_link, q[k], qd[k], qdd, NULL, &s, res);
+        ck_assert_flt_eq(res[0], tau[k][0]);
+        ck_assert_flt_eq(res[1], tau[k][1]);
+
+        // the external wrenches provide J^T F_ext = (0.75, 0.25)
+        kcc_rnea(&planar_two_link, q[k], qd[k], qdd, &f_ext, &s, res);
+        ck_assert_flt_eq(res[0], tau[k][0] - 0.75);
+        ck_assert_flt_eq(res[1], tau[k][1] - 0.25);
+
+        // gravitational torques only
+        kcc_rnea(&planar_two_link, q[k], NULL, NULL, NULL, &s, res);
+        ck_assert_flt_eq(res[0], 6.0 * G * cos(q[k][0]) + 2.0 * G * cos(q[k][0] + q[k][1]));
+        ck_assert_flt_eq(res[1], 2.0 * G * cos(q[k][0] + q[k][1]));
+    }
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+START_TEST(test_kcc_rnea_spatial)
+{
+    enum { N = 3 };
+
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&spatial_three_link, &s), 0);
+    *s.xd[0].angular_velocity = (struct vector3) { { 0.2, -0.1, 0.4 } };
+    *s.xd[0].linear_velocity = (struct vector3) { { 0.0, 0.3, -0.2 } };
+    *s.xdd[0].angular_acceleration = (struct vector3) { { 0.1, -0.2, 0.3 } };
+    *s.xdd[0].linear_acceleration = (struct vector3) { { 0.5, 1.0, G } };
+
+    struct mc_wrench f_ext = {
+        .torque = (struct vector3 [N]) {
+            { 0.1, 0.0, -0.2 }, { 0.0, 0.3, 0.0 }, { -0.1, 0.1, 0.1 } },
+        .force = (struct vector3 [N]) {
+            { 1.0, 0.0, 0.0 }, { 0.0, -0.5, 0.2 }, { 0.3, 0.3, -0.3 } }
+    };
+
+    for (int k = 0; k < 5; k++) {
+        joint_position q[N];
+        joint_velocity qd[N];
+        joint_torque tau[N];
+        for (int j = 0; j < N; j++) {
+            q[j] = sin(1.3 * k + j);
+            qd[j] = cos(0.7 * k - 2.0 * j);
+            tau[j] = 0.5 * sin(0.3 * k * j + 1.0);
+        }
+
+        // the inverse dynamics undo the forward dynamics
+        joint_acceleration qdd[N];
+        joint_torque res[N];
+        kcc_aba(&spatial_three_link, q, qd, tau, &f_ext, &s, qdd);
+        kcc_rnea(&spatial_three_link, q, qd, qdd, &f_ext, &s, res);
+        for (int j = 0; j < N; j++) {
+            ck_assert_flt_eq(res[j], tau[j]);
+        }
+    }
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+// Cart on a prismatic joint along the x-axis: a mass m = 2.0 at the joint
+// and a drive with a reflected mass of 0.5
+static struct kcc_segment cart_segments[] = {
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_PRISMATIC,
+            .prismatic_joint = {
+                .axis = JOINT_AXIS_X,
+                .inertia = (double [1]) { 0.5 }
+            }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .second_moment_of_mass = {
+                .row_x = { 0.1, 0.0, 0.0 },
+                .row_y = { 0.0, 0.1, 0.0 },
+                .row_z = { 0.0, 0.0, 0.1 }
+            }
+        }
+    }
+};
+
+static struct kcc_kinematic_chain cart = {
+    .number_of_segments = 1,
+    .segment = cart_segments
+};
+
+
+START_TEST(test_kcc_aba_prismatic)
+{
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&cart, &s), 0);
+
+    joint_position q[1] = { 0.7 };
+    joint_velocity qd[1] = { -1.5 };
+    joint_torque tau[1] = { 3.0 };
+    joint_acceleration qdd[1];
+    joint_torque res[1];
+
+    // gravity perpendicular to the joint's axis does not move the cart
+    s.xdd[0].linear_acceleration->y = G;
+    kcc_aba(&cart, q, qd, tau, NULL, &s, qdd);
+    ck_assert_flt_eq(qdd[0], 3.0 / 2.5);
+
+    // gravity along the axis only accelerates the cart's mass, not the drive
+    s.xdd[0].linear_acceleration->y = 0.0;
+    s.xdd[0].linear_acceleration->x = G;
+    kcc_aba(&cart, q, qd, tau, NULL, &s, qdd);
+    ck_assert_flt_eq(qdd[0], (3.0 - 2.0 * G) / 2.5);
+
+    kcc_rnea(&cart, q, qd, qdd, NULL, &s, res);
+    ck_assert_flt_eq(res[0], tau[0]);
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+// Gantry with fixed joints in between and at the end of the chain: segments 1
+// and 4 are fixed, hence the chain has three coordinates
+static struct kcc_segment gantry_segments[] = {
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 1.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_PRISMATIC,
+            .prismatic_joint = { .axis = JOINT_AXIS_X, .inertia = (double [1]) { 0.5 } }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .first_moment_of_mass = { { 0.0, 0.2, 0.0 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.3, 0.0, 0.0 },
+                .row_y = { 0.0, 0.2, 0.0 },
+                .row_z = { 0.0, 0.0, 0.3 }
+            }
+        }
+    },
+    {
+        // rotated by 90 degrees about the z-axis
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = {  0.0, 1.0, 0.0 },
+                .row_y = { -1.0, 0.0, 0.0 },
+                .row_z = {  0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.5, 0.0, 0.0 } }
+        },
+        .joint = { .type = JOINT_TYPE_FIXED },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 1.0,
+            .first_moment_of_mass = { { 0.2, 0.0, 0.1 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.1, 0.0, 0.0 },
+                .row_y = { 0.0, 0.1, 0.0 },
+                .row_z = { 0.0, 0.0, 0.1 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.3, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = { .axis = JOINT_AXIS_Z, .inertia = (double [1]) { 0.2 } }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 1.5,
+            .first_moment_of_mass = { { 1.5, 0.0, 0.0 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.1, 0.0, 0.0 },
+                .row_y = { 0.0, 1.6, 0.0 },
+                .row_z = { 0.0, 0.0, 1.6 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 1.0, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_PRISMATIC,
+            .prismatic_joint = { .axis = JOINT_AXIS_Y, .inertia = (double [1]) { 0.1 } }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 0.5,
+            .first_moment_of_mass = { { 0.0, 0.0, -0.1 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.05, 0.0, 0.0 },
+                .row_y = { 0.0, 0.05, 0.0 },
+                .row_z = { 0.0, 0.0, 0.02 }
+            }
+        }
+    },
+    {
+        // tool, rotated by 90 degrees about the x-axis
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0,  0.0, 0.0 },
+                .row_y = { 0.0,  0.0, 1.0 },
+                .row_z = { 0.0, -1.0, 0.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, -0.2 } }
+        },
+        .joint = { .type = JOINT_TYPE_FIXED },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 0.3,
+            .first_moment_of_mass = { { 0.03, 0.0, 0.06 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.02, 0.0, 0.0 },
+                .row_y = { 0.0, 0.03, 0.0 },
+                .row_z = { 0.0, 0.0, 0.02 }
+            }
+        }
+    }
+};
+
+static struct kcc_kinematic_chain gantry = {
+    .number_of_segments = 5,
+    .segment = gantry_segments
+};
+
+
+START_TEST(test_kcc_merge_fixed_joints)
+{
+    enum { M = 3 };
+
+    struct kcc_kinematic_chain merged;
+    ck_assert_int_eq(kcc_merge_fixed_joints(&gantry, &merged), 0);
+    ck_assert_int_eq(merged.number_of_segments, M);
+    for (int i = 0; i < M; i++) {
+        ck_assert_msg(merged.segment[i].joint.operators != NULL, "merged chain not compiled");
+    }
+
+    struct solver_state_c s;
+    struct solver_state_c sm;
+    ck_assert_int_eq(solver_state_create_c(&gantry, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&merged, &sm), 0);
+    ck_assert_int_eq(s.nq, M);
+    ck_assert_int_eq(s.nd, M);
+    *s.xdd[0].angular_acceleration = (struct vector3) { { 0.1, -0.2, 0.3 } };
+    *s.xdd[0].linear_acceleration = (struct vector3) { { 0.5, 1.0, G } };
+    *sm.xdd[0].angular_acceleration = *s.xdd[0].angular_acceleration;
+    *sm.xdd[0].linear_acceleration = *s.xdd[0].linear_acceleration;
+
+    for (int k = 0; k < 4; k++) {
+        // the fixed joints have no coordinates, hence both chains share them
+        joint_position q[M];
+        joint_velocity qd[M];
+        joint_torque tau[M];
+        for (int j = 0; j < M; j++) {
+            q[j] = sin(1.3 * k + j);
+            qd[j] = cos(0.7 * k - 2.0 * j);
+            tau[j] = 0.5 * sin(0.3 * k * j + 1.0);
+        }
+
+        joint_acceleration qdd[M];
+        joint_acceleration qddm[M];
+        kcc_aba(&gantry, q, qd, tau, NULL, &s, qdd);
+        kcc_aba(&merged, q, qd, tau, NULL, &sm, qddm);
+        for (int j = 0; j < M; j++) {
+            ck_assert_flt_eq(qddm[j], qdd[j]);
+        }
+
+        joint_torque res[M];
+        kcc_rnea(&gantry, q, qd, qdd, NULL, &s, res);
+        for (int j = 0; j < M; j++) {
+            ck_assert_flt_eq(res[j], tau[j]);
+        }
+
+        // the unmerged chain's mass matrix is the merged chain's one
+        joint_inertia m[M][M];
+        joint_inertia mm[M][M];
+        kcc_crba(&gantry, q, &s, &m[0][0]);
+        kcc_crba(&merged, q, &sm, &mm[0][0]);
+        for (int i = 0; i < M; i++) {
+            ck_assert_msg(m[i][i] > 0.0, "singular mass matrix");
+            for (int j = 0; j < M; j++) {
+                ck_assert_flt_eq(m[i][j], mm[i][j]);
+            }
+        }
+    }
+
+    solver_state_destroy_c(&sm);
+    solver_state_destroy_c(&s);
+    kcc_merged_destroy(&merged);
+}
+END_TEST
+
+
+// Single rigid body on a free-flyer joint with its centre of mass at the
+// link's origin: m = 2.0 and I = diag(1.0, 2.0, 3.0)
+static struct kcc_segment body_segments[] = {
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } }
+        },
+        .joint = { .type = JOINT_TYPE_FREE_FLYER },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .second_moment_of_mass = {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 2.0, 0.0 },
+                .row_z = { 0.0, 0.0, 3.0 }
+            }
+        }
+    }
+};
+
+static struct kcc_kinematic_chain body = {
+    .number_of_segments = 1,
+    .segment = body_segments
+};
+
+
+START_TEST(test_kcc_aba_free_flyer)
+{
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&body, &s), 0);
+    ck_assert_int_eq(s.nq, 7);
+    ck_assert_int_eq(s.nd, 6);
+
+    // Rotated by 90 degrees about the z-axis
+    joint_position q[7] = { 1.0, 2.0, 3.0, 0.0, 0.0, sqrt(0.5), sqrt(0.5) };
+    joint_velocity qd[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    joint_torque tau[6] = { 1.0, 2.0, 3.0, 4.0, 6.0, 8.0 };
+    joint_acceleration qdd[6];
+    joint_torque res[6];
+
+    // The wrench in the body's coordinates accelerates the body
+    joint_acceleration res_qdd[6] = { 1.0, 1.0, 1.0, 2.0, 3.0, 4.0 };
+
+    kcc_aba(&body, q, qd, tau, NULL, &s, qdd);
+    for (int i = 0; i < 6; i++) ck_assert_flt_eq(qdd[i], res_qdd[i]);
+
+    // Free fall: in the base's x-direction, i.e. the body's negative
+    // y-direction
+    for (int i = 0; i < 6; i++) tau[i] = 0.0;
+    s.xdd[0].linear_acceleration->x = G;
+    kcc_aba(&body, q, qd, tau, NULL, &s, qdd);
+    for (int i = 0; i < 6; i++) ck_assert_flt_eq(qdd[i], i == 4 ? G : 0.0);
+
+    kcc_rnea(&body, q, qd, qdd, NULL, &s, res);
+    for (int i = 0; i < 6; i++) ck_assert_flt_eq(res[i], 0.0);
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+// Floating base with a revolute, a spherical and a prismatic joint
+static struct kcc_segment floating_segments[] = {
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } }
+        },
+        .joint = { .type = JOINT_TYPE_FREE_FLYER },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 3.0,
+            .first_moment_of_mass = { { 0.3, 0.0, 0.6 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.5, 0.0, -0.1 },
+                .row_y = { 0.0, 0.6, 0.0 },
+                .row_z = { -0.1, 0.0, 0.2 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 0.0, 0.0, -1.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 1.0, 0.0, 0.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.1, 0.0, 0.4 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_REVOLUTE,
+            .revolute_joint = { .axis = JOINT_AXIS_Y, .inertia = (double [1]) { 0.1 } }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 2.0,
+            .first_moment_of_mass = { { 0.5, 0.2, 0.0 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.3, 0.05, 0.0 },
+                .row_y = { 0.05, 0.4, 0.0 },
+                .row_z = { 0.0, 0.0, 0.5 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 0.6, 0.8, 0.0 },
+                .row_y = { -0.8, 0.6, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.3, -0.1, 0.0 } }
+        },
+        .joint = { .type = JOINT_TYPE_SPHERICAL },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 1.0,
+            .first_moment_of_mass = { { 0.2, 0.1, -0.1 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.1, 0.0, 0.0 },
+                .row_y = { 0.0, 0.2, 0.02 },
+                .row_z = { 0.0, 0.02, 0.15 }
+            }
+        }
+    },
+    {
+        .joint_attachment = {
+            .rotation = (struct matrix3x3 [1]) { {
+                .row_x = { 1.0, 0.0, 0.0 },
+                .row_y = { 0.0, 1.0, 0.0 },
+                .row_z = { 0.0, 0.0, 1.0 }
+            } },
+            .translation = (struct vector3 [1]) { { 0.2, 0.0, 0.0 } }
+        },
+        .joint = {
+            .type = JOINT_TYPE_PRISMATIC,
+            .prismatic_joint = { .axis = JOINT_AXIS_Z, .inertia = (double [1]) { 0.05 } }
+        },
+        .link.inertia = {
+            .zeroth_moment_of_mass = 0.5,
+            .first_moment_of_mass = { { 0.0, 0.0, 0.05 } },
+            .second_moment_of_mass = {
+                .row_x = { 0.02, 0.0, 0.0 },
+                .row_y = { 0.0, 0.02, 0.0 },
+                .row_z = { 0.0, 0.0, 0.01 }
+            }
+        }
+    }
+};
+
+static struct kcc_kinematic_chain floating = {
+    .number_of_segments = 4,
+    .segment = floating_segments
+};
+
+
+START_TEST(test_kcc_floating_base)
+{
+    enum { NQ = 7 + 1 + 4 + 1, ND = 6 + 1 + 3 + 1 };
+
+    struct solver_state_c s;
+    ck_assert_int_eq(solver_state_create_c(&floating, &s), 0);
+    ck_assert_int_eq(s.nq, NQ);
+    ck_assert_int_eq(s.nd, ND);
+    s.xdd[0].linear_acceleration->z = G;
+
+    for (int k = 0; k < 5; k++) {
+        // The quaternions are not normalized on purpose
+        joint_position q[NQ];
+        joint_velocity qd[ND];
+        joint_torque tau[ND];
+        for (int j = 0; j < NQ; j++) {
+            q[j] = sin(1.3 * k + j);
+        }
+        for (int j = 0; j < ND; j++) {
+            qd[j] = cos(0.7 * k - 2.0 * j);
+            tau[j] = 0.5 * sin(0.3 * k * j + 1.0);
+        }
+
+        // RNEA inverts ABA
+        joint_acceleration qdd[ND];
+        joint_torque res[ND];
+        kcc_aba(&floating, q, qd, tau, NULL, &s, qdd);
+        kcc_rnea(&floating, q, qd, qdd, NULL, &s, res);
+        for (int i = 0; i < ND; i++) {
+            ck_assert_flt_eq(res[i], tau[i]);
+        }
+
+        // M(q) qdd = tau - C(q, qd)
+        joint_torque c[ND];
+        joint_inertia m[ND][ND];
+        joint_inertia mp[ND * (ND + 1) / 2];
+        kcc_rnea(&floating, q, qd, NULL, NULL, &s, c);
+        kcc_crba(&floating, q, &s, &m[0][0]);
+        kcc_crba_packed(&floating, q, &s, mp);
+
+        for (int i = 0; i < ND; i++) {
+            double mqdd = 0.0;
+            for (int j = 0; j < ND; j++) {
+                mqdd += m[i][j] * qdd[j];
+                ck_assert_flt_eq(m[i][j], m[j][i]);
+                if (j <= i) ck_assert_flt_eq(mp[i * (i + 1) / 2 + j], m[i][j]);
+            }
+            ck_assert_flt_eq(mqdd, tau[i] - c[i]);
+        }
+    }
+
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+// Two branches on the base: the spatial chain (segments 0, 2 and 4) and the
+// planar arm (segments 1 and 3), with their segments interleaved
+static int branches_parent[] = { -1, -1, 0, 1, 2 };
+
+static void branches_segments(
+        struct kcc_segment *segment)
+{
+    segment[0] = spatial_segments[0];
+    segment[1] = planar_segments[0];
+    segment[2] = spatial_segments[1];
+    segment[3] = planar_segments[1];
+    segment[4] = spatial_segments[2];
+}
+
+
+START_TEST(test_kcc_tree_branches)
+{
+    enum { N = 5 };
+    static const int spatial[3] = { 0, 2, 4 };
+    static const int planar[2] = { 1, 3 };
+
+    struct kcc_segment segment[N];
+    branches_segments(segment);
+    struct kcc_kinematic_chain tree = {
+        .number_of_segments = N,
+        .segment = segment,
+        .parent = branches_parent
+    };
+
+    struct solver_state_c s, ss, sp;
+    ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&spatial_three_link, &ss), 0);
+    ck_assert_int_eq(solver_state_create_c(&planar_two_link, &sp), 0);
+    s.xdd[0].linear_acceleration->z = G;
+    ss.xdd[0].linear_acceleration->z = G;
+    sp.xdd[0].linear_acceleration->z = G;
+
+    joint_position q[N];
+    joint_velocity qd[N];
+    joint_torque tau[N];
+    for (int j = 0; j < N; j++) {
+        q[j] = sin(1.3 + j);
+        qd[j] = cos(0.7 - 2.0 * j);
+        tau[j] = 0.5 * sin(0.3 * j + 1.0);
+    }
+
+    joint_position qs[3], qp[2];
+    joint_velocity qds[3], qdp[2];
+    joint_torque taus[3], taup[2];
+    for (int j = 0; j < 3; j++) {
+        qs[j] = q[spatial[j]];
+        qds[j] = qd[spatial[j]];
+        taus[j] = tau[spatial[j]];
+    }
+    for (int j = 0; j < 2; j++) {
+        qp[j] = q[planar[j]];
+        qdp[j] = qd[planar[j]];
+        taup[j] = tau[planar[j]];
+    }
+
+    // The branches move independently of each other
+    joint_acceleration qdd[N], qdds[3], qddp[2];
+    kcc_aba(&tree, q, qd, tau, NULL, &s, qdd);
+    kcc_aba(&spatial_three_link, qs, qds, taus, NULL, &ss, qdds);
+    kcc_aba(&planar_two_link, qp, qdp, taup, NULL, &sp, qddp);
+    for (int j = 0; j < 3; j++) ck_assert_flt_eq(qdd[spatial[j]], qdds[j]);
+    for (int j = 0; j < 2; j++) ck_assert_flt_eq(qdd[planar[j]], qddp[j]);
+
+    joint_torque res[N], ress[3], resp[2];
+    kcc_rnea(&tree, q, qd, tau, NULL, &s, res);
+    kcc_rnea(&spatial_three_link, qs, qds, taus, NULL, &ss, ress);
+    kcc_rnea(&planar_two_link, qp, qdp, taup, NULL, &sp, resp);
+    for (int j = 0; j < 3; j++) ck_assert_flt_eq(res[spatial[j]], ress[j]);
+    for (int j = 0; j < 2; j++) ck_assert_flt_eq(res[planar[j]], resp[j]);
+
+    // The links' poses, twists and acceleration twists
+    kcc_fak(&tree, q, qd, qdd, &s);
+    kcc_fak(&spatial_three_link, qs, qds, qdds, &ss);
+    kcc_fak(&planar_two_link, qp, qdp, qddp, &sp);
+    for (int j = 0; j < N; j++) {
+        const struct solver_state_c *r = (j % 2 == 0) ? &ss : &sp;
+        int b = j / 2 + 1;
+
+        for (int k = 0; k < 3; k++) {
+            for (int l = 0; l < 3; l++) {
+                ck_assert_flt_eq(s.x_tot[j + 1].rotation->row[k].data[l], r->x_tot[b].rotation->row[k].data[l]);
+            }
+            ck_assert_flt_eq(s.x_tot[j + 1].translation->data[k], r->x_tot[b].translation->data[k]);
+            ck_assert_flt_eq(s.xd[j + 1].angular_velocity->data[k], r->xd[b].angular_velocity->data[k]);
+            ck_assert_flt_eq(s.xd[j + 1].linear_velocity->data[k], r->xd[b].linear_velocity->data[k]);
+            ck_assert_flt_eq(s.xdd[j + 1].angular_acceleration->data[k], r->xdd[b].angular_acceleration->data[k]);
+            ck_assert_flt_eq(s.xdd[j + 1].linear_acceleration->data[k], r->xdd[b].linear_acceleration->data[k]);
+        }
+    }
+
+    // The mass matrix is block-diagonal w.r.t. the branches
+    joint_inertia m[N][N], ms[3][3], mp[2][2];
+    kcc_crba(&tree, q, &s, &m[0][0]);
+    kcc_crba(&spatial_three_link, qs, &ss, &ms[0][0]);
+    kcc_crba(&planar_two_link, qp, &sp, &mp[0][0]);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            if (i % 2 != j % 2) ck_assert_flt_eq(m[i][j], 0.0);
+            else if (i % 2 == 0) ck_assert_flt_eq(m[i][j], ms[i / 2][j / 2]);
+            else ck_assert_flt_eq(m[i][j], mp[i / 2][j / 2]);
+        }
+    }
+
+    solver_state_destroy_c(&sp);
+    solver_state_destroy_c(&ss);
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+// A torso (segment 0) with two arms of two links each
+static int torso_parent[] = { -1, 0, 0, 1, 2 };
+
+static void torso_segments(
+        struct kcc_segment *segment)
+{
+    segment[0] = spatial_segments[0];
+    segment[1] = spatial_segments[1];
+    segment[2] = spatial_segments[2];
+    segment[3] = planar_segments[1];
+    segment[4] = spatial_segments[1];
+}
+
+
+START_TEST(test_kcc_tree)
+{
+    enum { N = 5 };
+
+    struct kcc_segment segment[N];
+    torso_segments(segment);
+    struct kcc_kinematic_chain tree = {
+        .number_of_segments = N,
+        .segment = segment,
+        .parent = torso_parent
+    };
+
+    struct solver_state_c s;
+    struct solver_state_lanes_c sl;
+    ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+    ck_assert_int_eq(solver_state_create_lanes_c(&tree, &sl), 0);
+
+    struct gc_acc_twist xdd_base = {
+        .angular_acceleration = (struct vector3 [1]) { { 0.1, -0.2, 0.3 } },
+        .linear_acceleration = (struct vector3 [1]) { { 0.5, 1.0, G } }
+    };
+    *s.xdd[0].angular_acceleration = *xdd_base.angular_acceleration;
+    *s.xdd[0].linear_acceleration = *xdd_base.linear_acceleration;
+
+    joint_position q[N];
+    joint_velocity qd[N];
+    joint_torque tau[N];
+    for (int j = 0; j < N; j++) {
+        q[j] = sin(0.4 + 1.1 * j);
+        qd[j] = cos(1.7 - 0.9 * j);
+        tau[j] = 0.5 * sin(0.8 * j - 1.0);
+    }
+
+    // RNEA inverts ABA
+    joint_acceleration qdd[N];
+    joint_torque res[N];
+    kcc_aba(&tree, q, qd, tau, NULL, &s, qdd);
+    kcc_rnea(&tree, q, qd, qdd, NULL, &s, res);
+    for (int i = 0; i < N; i++) {
+        ck_assert_flt_eq(res[i], tau[i]);
+    }
+
+    // The acceleration twists of the forward kinematics are those of ABA
+    struct vector3 xdd_ang[N], xdd_lin[N];
+    kcc_aba(&tree, q, qd, tau, NULL, &s, qdd);
+    for (int i = 0; i < N; i++) {
+        xdd_ang[i] = *s.xdd[i + 1].angular_acceleration;
+        xdd_lin[i] = *s.xdd[i + 1].linear_acceleration;
+    }
+    kcc_fak(&tree, q, qd, qdd, &s);
+    for (int i = 0; i < N; i++) {
+        for (int k = 0; k < 3; k++) {
+            ck_assert_flt_eq(s.xdd[i + 1].angular_acceleration->data[k], xdd_ang[i].data[k]);
+            ck_assert_flt_eq(s.xdd[i + 1].linear_acceleration->data[k], xdd_lin[i].data[k]);
+        }
+    }
+
+    // The arms do not couple in the mass matrix
+    joint_torque c[N];
+    joint_inertia m[N][N];
+    joint_inertia mp[N * (N + 1) / 2];
+    kcc_rnea(&tree, q, qd, NULL, NULL, &s, c);
+    kcc_crba(&tree, q, &s, &m[0][0]);
+    kcc_crba_packed(&tree, q, &s, mp);
+    ck_assert_flt_eq(m[1][2], 0.0);
+    ck_assert_flt_eq(m[1][4], 0.0);
+    ck_assert_flt_eq(m[3][2], 0.0);
+    ck_assert_flt_eq(m[3][4], 0.0);
+
+    // M(q) qdd = tau - C(q, qd)
+    for (int i = 0; i < N; i++) {
+        double mqdd = 0.0;
+        for (int j = 0; j < N; j++) {
+            mqdd += m[i][j] * qdd[j];
+            ck_assert_flt_eq(m[i][j], m[j][i]);
+            if (j <= i) ck_assert_flt_eq(mp[i * (i + 1) / 2 + j], m[i][j]);
+        }
+        ck_assert_flt_eq(mqdd, tau[i] - c[i]);
+    }
+
+    // The batched solver agrees
+    enum la_isa isa = la_get_isa();
+    for (int i = LA_ISA_SCALAR; i <= LA_ISA_AVX512; i++) {
+        if (la_set_isa((enum la_isa)i) != 0) continue;
+
+        joint_acceleration qdd_batch[N];
+        kcc_aba_batch(&tree, 1, q, qd, tau, &xdd_base, &sl, qdd_batch);
+        for (int j = 0; j < N; j++) {
+            ck_assert_flt_eq(qdd_batch[j], qdd[j]);
+        }
+    }
+    la_set_isa(isa);
+
+    solver_state_destroy_lanes_c(&sl);
+    solver_state_destroy_c(&s);
+}
+END_TEST
+
+
+static void assert_poses_eq(
+        const struct solver_state_c *s,
+        const struct solver_state_c *t)
+{
+    for (int i = 1; i < s->nbody + 1; i++) {
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                ck_assert_flt_eq(s->x_tot[i].rotation->row[r].data[c],
+                        t->x_tot[i].rotation->row[r].data[c]);
+            }
+            ck_assert_flt_eq(s->x_tot[i].translation->data[r],
+                    t->x_tot[i].translation->data[r]);
+        }
+    }
+}
+
+
+START_TEST(test_kcc_fpk_incremental)
+{
+    enum { N = 5 };
+
+    struct kcc_segment segment[N];
+    torso_segments(segment);
+    struct kcc_kinematic_chain tree = {
+        .number_of_segments = N,
+        .segment = segment,
+        .parent = torso_parent
+    };
+
+    struct solver_state_c s, t;
+    ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&tree, &t), 0);
+
+    joint_position q[N];
+    joint_velocity qd[N];
+    joint_torque tau[N];
+    joint_acceleration qdd[N];
+    for (int j = 0; j < N; j++) {
+        q[j] = sin(0.4 + 1.1 * j);
+        qd[j] = cos(1.7 - 0.9 * j);
+        tau[j] = 0.5 * sin(0.8 * j - 1.0);
+    }
+
+    // The first call computes all poses
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, q, &s), N);
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    // Nothing has changed
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, q, &s), 0);
+    assert_poses_eq(&s, &t);
+
+    // A leaf of the left arm
+    q[3] += 0.3;
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, q, &s), 1);
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    // The shoulder of the left arm moves the arm
+    q[1] -= 0.7;
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, q, &s), 2);
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    // Both arms
+    q[3] += 0.1;
+    q[4] += 0.2;
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, q, &s), 2);
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    // The torso moves everything
+    q[0] += 1.1;
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, q, &s), N);
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    // Another solver overwrites the poses
+    joint_position q_aba[N];
+    for (int j = 0; j < N; j++) q_aba[j] = -q[j];
+    kcc_aba(&tree, q_aba, qd, tau, NULL, &s, qdd);
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, q, &s), N);
+    assert_poses_eq(&s, &t);
+
+    // The state's own joint positions, updated in place
+    for (int j = 0; j < N; j++) s.q[j] = q[j];
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, s.q, &s), 0);
+    assert_poses_eq(&s, &t);
+
+    s.q[3] -= 0.4;
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, s.q, &s), 1);
+    kcc_fpk(&tree, s.q, &t);
+    assert_poses_eq(&s, &t);
+
+    s.q[0] += 0.6;
+    ck_assert_int_eq(kcc_fpk_incremental(&tree, s.q, &s), N);
+    kcc_fpk(&tree, s.q, &t);
+    assert_poses_eq(&s, &t);
+
+    solver_state_destroy_c(&s);
+    solver_state_destroy_c(&t);
+}
+END_TEST
+
+
+START_TEST(test_kcc_sincos)
+{
+    enum { N = 5 };
+
+    struct kcc_segment segment[N];
+    torso_segments(segment);
+    struct kcc_kinematic_chain tree = {
+        .number_of_segments = N,
+        .segment = segment,
+        .parent = torso_parent
+    };
+
+    struct solver_state_c s, t;
+    ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&tree, &t), 0);
+
+    joint_position q[N];
+    joint_velocity qd[N];
+    joint_torque tau[N];
+    joint_acceleration qdd[N], res[N];
+    for (int j = 0; j < N; j++) {
+        q[j] = 3.0 * sin(0.4 + 1.1 * j);
+        qd[j] = cos(1.7 - 0.9 * j);
+        tau[j] = 0.5 * sin(0.8 * j - 1.0);
+    }
+
+    kcc_sincos(&tree, q, &s);
+    for (int j = 0; j < N; j++) {
+        ck_assert(fabs(s.sin_q[j] - sin(q[j])) < 1e-15);
+        ck_assert(fabs(s.cos_q[j] - cos(q[j])) < 1e-15);
+    }
+
+    // The sweeps agree with those that evaluate libm
+    kcc_fpk(&tree, q, &s);
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    kcc_aba(&tree, q, qd, tau, NULL, &s, qdd);
+    kcc_aba(&tree, q, qd, tau, NULL, &t, res);
+    for (int j = 0; j < N; j++) ck_assert_flt_eq(qdd[j], res[j]);
+
+    // The sweeps take the stored values: a rotation by pi about the torso
+    s.sin_q[0] = sin(q[0] + M_PI);
+    s.cos_q[0] = cos(q[0] + M_PI);
+    kcc_fpk(&tree, q, &s);
+    q[0] += M_PI;
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    // ... but only as long as the positions match
+    q[0] -= 0.5;
+    kcc_fpk(&tree, q, &s);
+    kcc_fpk(&tree, q, &t);
+    assert_poses_eq(&s, &t);
+
+    solver_state_destroy_c(&s);
+    solver_state_destroy_c(&t);
+}
+END_TEST
+
+
+static struct gc_pose tool = {
+    .rotation = (struct matrix3x3 [1]) { {
+        .row_x = { 0.0, 1.0, 0.0 },
+        .row_y = { 0.0, 0.0, 1.0 },
+        .row_z = { 1.0, 0.0, 0.0 }
+    } },
+    .translation = (struct vector3 [1]) { { 0.1, 0.2, 0.3 } }
+};
+
+static struct gc_pose identity = {
+    .rotation = (struct matrix3x3 [1]) { {
+        .row_x = { 1.0, 0.0, 0.0 },
+        .row_y = { 0.0, 1.0, 0.0 },
+        .row_z = { 0.0, 0.0, 1.0 }
+    } },
+    .translation = (struct vector3 [1]) { { 0.0, 0.0, 0.0 } }
+};
+
+
+// J qd is the frame's twist, which the velocity sweep t yields
+static void assert_jacobian_twist(
+        const struct kcc_frame *frame,
+        const struct solver_state_c *t,
+        const double *j,
+        enum jacobian_type type,
+        const joint_velocity *qd)
+{
+    struct matrix3x3 rotation;
+    struct vector3 translation;
+    struct gc_pose x = { .rotation = &rotation, .translation = &translation };
+    struct vector3 ang_f, lin_f, ang, lin;
+    struct gc_twist xd_f = { .angular_velocity = &ang_f, .linear_velocity = &lin_f };
+    struct gc_twist xd = { .angular_velocity = &ang, .linear_velocity = &lin };
+
+    // f^X_0 and the frame's twist in its own coordinates
+    gc_pose_compose(frame->pose, &t->x_tot[frame->body], &x);
+    gc_twist_tf_ref_to_tgt(frame->pose, &t->xd[frame->body], &xd_f);
+    if (type == JACOBIAN_SPATIAL) {
+        gc_twist_tf_tgt_to_ref(&x, &xd_f, &xd);
+    } else {
+        xd = xd_f;
+    }
+
+    for (int r = 0; r < 3; r++) {
+        double w = 0.0, v = 0.0;
+        for (int k = 0; k < t->nd; k++) {
+            w += j[6 * k + r] * qd[k];
+            v += j[6 * k + 3 + r] * qd[k];
+        }
+        ck_assert_flt_eq(w, xd.angular_velocity->data[r]);
+        ck_assert_flt_eq(v, xd.linear_velocity->data[r]);
+    }
+}
+
+
+START_TEST(test_kcc_jacobian)
+{
+    enum { N = 5, NF = 4 };
+
+    struct kcc_segment segment[N];
+    torso_segments(segment);
+    struct kcc_kinematic_chain tree = {
+        .number_of_segments = N,
+        .segment = segment,
+        .parent = torso_parent
+    };
+
+    const struct kcc_frame frame[NF] = {
+        { .body = 4, .pose = &tool },
+        { .body = 5, .pose = &identity },
+        { .body = 1, .pose = &tool },
+        { .body = 0, .pose = &identity }
+    };
+
+    struct solver_state_c s, t;
+    ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&tree, &t), 0);
+
+    joint_position q[N];
+    joint_velocity qd[N];
+    for (int j = 0; j < N; j++) {
+        q[j] = sin(0.4 + 1.1 * j);
+        qd[j] = cos(1.7 - 0.9 * j);
+    }
+    kcc_fvk(&tree, q, qd, &t);
+
+    double jb[NF][6 * N], js[NF][6 * N], j1[6 * N];
+    kcc_jacobian_batch(&tree, q, NF, frame, JACOBIAN_BODY, &s, &jb[0][0]);
+    kcc_jacobian_batch(&tree, q, NF, frame, JACOBIAN_SPATIAL, &s, &js[0][0]);
+
+    for (int f = 0; f < NF; f++) {
+        assert_jacobian_twist(&frame[f], &t, jb[f], JACOBIAN_BODY, qd);
+        assert_jacobian_twist(&frame[f], &t, js[f], JACOBIAN_SPATIAL, qd);
+
+        // The batch is the frames' Jacobians
+        kcc_jacobian(&tree, q, &frame[f], JACOBIAN_BODY, &s, j1);
+        for (int k = 0; k < 6 * N; k++) ck_assert_flt_eq(j1[k], jb[f][k]);
+    }
+
+    // The right arm (bodies 3 and 5) does not move the left hand (body 4)
+    for (int k = 0; k < 6; k++) {
+        ck_assert_flt_eq(jb[0][6 * 2 + k], 0.0);
+        ck_assert_flt_eq(jb[0][6 * 4 + k], 0.0);
+    }
+
+    // A NULL pose is the body's frame
+    const struct kcc_frame hand = { .body = 5, .pose = NULL };
+    kcc_jacobian(&tree, q, &hand, JACOBIAN_BODY, &s, j1);
+    for (int k = 0; k < 6 * N; k++) ck_assert_flt_eq(j1[k], jb[1][k]);
+
+    // The state's own joint positions, updated in place
+    for (int j = 0; j < N; j++) s.q[j] = q[j];
+    kcc_jacobian(&tree, s.q, &frame[0], JACOBIAN_BODY, &s, j1);
+    for (int k = 0; k < 6 * N; k++) ck_assert_flt_eq(j1[k], jb[0][k]);
+
+    s.q[1] += 0.5;
+    s.q[3] -= 0.8;
+    double jt[6 * N];
+    kcc_jacobian(&tree, s.q, &frame[0], JACOBIAN_SPATIAL, &s, j1);
+    kcc_jacobian(&tree, s.q, &frame[0], JACOBIAN_SPATIAL, &t, jt);
+    for (int k = 0; k < 6 * N; k++) ck_assert_flt_eq(j1[k], jt[k]);
+
+    // Multi-DoF joints
+    enum { NQ = 7 + 1 + 4 + 1, ND = 6 + 1 + 3 + 1 };
+    struct solver_state_c sf, tf;
+    ck_assert_int_eq(solver_state_create_c(&floating, &sf), 0);
+    ck_assert_int_eq(solver_state_create_c(&floating, &tf), 0);
+
+    joint_position qf[NQ];
+    joint_velocity qdf[ND];
+    for (int j = 0; j < NQ; j++) qf[j] = sin(1.3 + j);
+    for (int j = 0; j < ND; j++) qdf[j] = cos(0.7 - 2.0 * j);
+    kcc_fvk(&floating, qf, qdf, &tf);
+
+    const struct kcc_frame end = { .body = 4, .pose = &tool };
+    double jf[6 * ND];
+    kcc_jacobian(&floating, qf, &end, JACOBIAN_BODY, &sf, jf);
+    assert_jacobian_twist(&end, &tf, jf, JACOBIAN_BODY, qdf);
+    kcc_jacobian(&floating, qf, &end, JACOBIAN_SPATIAL, &sf, jf);
+    assert_jacobian_twist(&end, &tf, jf, JACOBIAN_SPATIAL, qdf);
+
+    solver_state_destroy_c(&s);
+    solver_state_destroy_c(&t);
+    solver_state_destroy_c(&sf);
+    solver_state_destroy_c(&tf);
+}
+END_TEST
+
+
+START_TEST(test_kcc_jacobian_dot_qd)
+{
+    enum { N = 5, NF = 3 };
+
+    struct kcc_segment segment[N];
+    torso_segments(segment);
+    struct kcc_kinematic_chain tree = {
+        .number_of_segments = N,
+        .segment = segment,
+        .parent = torso_parent
+    };
+
+    const struct kcc_frame frame[NF] = {
+        { .body = 4, .pose = &tool },
+        { .body = 5, .pose = NULL },
+        { .body = 0, .pose = NULL }
+    };
+
+    struct solver_state_c s, t;
+    ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&tree, &t), 0);
+
+    // The sweep ignores the base's motion
+    s.xd[0].angular_velocity->x = 1.0;
+    s.xdd[0].linear_acceleration->z = G;
+
+    joint_position q[N], qp[N], qm[N];
+    joint_velocity qd[N];
+    joint_acceleration qdd[N] = { 0.0 };
+    for (int j = 0; j < N; j++) {
+        q[j] = sin(0.4 + 1.1 * j);
+        qd[j] = cos(1.7 - 0.9 * j);
+    }
+
+    // Jd qd = (J(q + h qd) - J(q - h qd)) / 2h qd
+    const double H = 1e-6;
+    for (int j = 0; j < N; j++) {
+        qp[j] = q[j] + H * qd[j];
+        qm[j] = q[j] - H * qd[j];
+    }
+
+    for (int f = 0; f < NF; f++) {
+        for (int type = JACOBIAN_BODY; type <= JACOBIAN_SPATIAL; type++) {
+            double a[6], jp[6 * N], jm[6 * N];
+
+            kcc_jacobian_dot_qd(&tree, q, qd, &frame[f], type, &s, a);
+            kcc_jacobian(&tree, qp, &frame[f], type, &t, jp);
+            kcc_jacobian(&tree, qm, &frame[f], type, &t, jm);
+
+            for (int r = 0; r < 6; r++) {
+                double jdqd = 0.0;
+                for (int k = 0; k < N; k++) jdqd += (jp[6 * k + r] - jm[6 * k + r]) / (2.0 * H) * qd[k];
+                ck_assert_flt_eq(a[r], jdqd);
+            }
+        }
+    }
+    ck_assert_flt_eq(s.xd[0].angular_velocity->x, 1.0);
+    ck_assert_flt_eq(s.xdd[0].linear_acceleration->z, G);
+
+    // The acceleration twist of the forward kinematics with qdd = 0
+    double a[6];
+    kcc_jacobian_dot_qd(&tree, q, qd, &frame[1], JACOBIAN_BODY, &s, a);
+    kcc_fak(&tree, q, qd, qdd, &t);
+    for (int r = 0; r < 3; r++) {
+        ck_assert_flt_eq(a[r], t.xdd[5].angular_acceleration->data[r]);
+        ck_assert_flt_eq(a[3 + r], t.xdd[5].linear_acceleration->data[r]);
+    }
+
+    // The state's own joint positions, updated in place
+    for (int j = 0; j < N; j++) s.q[j] = q[j];
+    kcc_jacobian_dot_qd(&tree, s.q, qd, &frame[0], JACOBIAN_BODY, &s, a);
+    s.q[0] -= 0.3;
+    s.q[3] += 0.9;
+    double b[6];
+    kcc_jacobian_dot_qd(&tree, s.q, qd, &frame[0], JACOBIAN_BODY, &s, a);
+    kcc_jacobian_dot_qd(&tree, s.q, qd, &frame[0], JACOBIAN_BODY, &t, b);
+    for (int r = 0; r < 6; r++) ck_assert_flt_eq(a[r], b[r]);
+
+    solver_state_destroy_c(&s);
+    solver_state_destroy_c(&t);
+}
+END_TEST
+
+
+START_TEST(test_kcc_merge_fixed_joints_tree)
+{
+    enum { N = 4 };
+
+    // The fixed segment 1 carries the second arm (segment 3)
+    struct kcc_segment segment[N] = {
+        spatial_segments[0], gantry_segments[1], spatial_segments[1], spatial_segments[2]
+    };
+    int parent[N] = { -1, 0, 0, 1 };
+    struct kcc_kinematic_chain tree = {
+        .number_of_segments = N,
+        .segment = segment,
+        .parent = parent
+    };
+
+    struct kcc_kinematic_chain merged;
+    ck_assert_int_eq(kcc_merge_fixed_joints(&tree, &merged), 0);
+    ck_assert_int_eq(merged.number_of_segments, 3);
+    ck_assert_int_eq(merged.parent[0], -1);
+    ck_assert_int_eq(merged.parent[1], 0);
+    ck_assert_int_eq(merged.parent[2], 0);
+
+    struct solver_state_c s, sm;
+    ck_assert_int_eq(solver_state_create_c(&tree, &s), 0);
+    ck_assert_int_eq(solver_state_create_c(&merged, &sm), 0);
+    s.xdd[0].linear_acceleration->z = G;
+    sm.xdd[0].linear_acceleration->z = G;
+
+    joint_position q[3] = { 0.3, -0.7, 1.1 };
+    joint_velocity qd[3] = { 0.5, 0.2, -0.4 };
+    joint_torque tau[3] = { 1.0, -0.5, 0.25 };
+
+    joint_acceleration qdd[3], qddm[3];
+    kcc_aba(&tree, q, qd, tau, NULL, &s, qdd);
+    kcc_aba(&merged, q, qd, tau, NULL, &sm, qddm);
+    for (int j = 0; j < 3; j++) ck_assert_flt_eq(qdd[j], qddm[j]);
+
+    solver_state_destroy_c(&sm);
+    solver_state_destroy_c(&s);
+    kcc_merged_destroy(&merged);
+}
+END_TEST
+
+
+TCase *solver_test()
+{
+    TCase *tc = tcase_create("Solver");
+
+    tcase_add_test(tc, test_kcc_aba_one_link);
+    tcase_add_test(tc, test_kcc_aba_two_link);
+    tcase_add_test(tc, test_kcc_rnea_two_link);
+    tcase_add_test(tc, test_kcc_rnea_spatial);
+    tcase_add_test(tc, test_kcc_aba_prismatic);
+    tcase_add_test(tc, test_kcc_merge_fixed_joints);
+    tcase_add_test(tc, test_kcc_aba_free_flyer);
+    tcase_add_test(tc, test_kcc_floating_base);
+    tcase_add_test(tc, test_kcc_tree_branches);
+    tcase_add_test(tc, test_kcc_tree);
+    tcase_add_test(tc, test_kcc_fpk_incremental);
+    tcase_add_test(tc, test_kcc_sincos);
+    tcase_add_test(tc, test_kcc_jacobian);
+    tcase_add_test(tc, test_kcc_jacobian_dot_qd);
+    tcase_add_test(tc, test_kcc_merge_fixed_joints_tree);
+    tcase_add_test(tc, test_kcc_crba_two_link);
+    tcase_add_test(tc, test_kcc_crba_spatial);
+    tcase_add_test(tc, test_kcc_aba_batch_two_link);
+    tcase_add_test(tc, test_kcc_aba_batch_spatial);
+
+    return tc;
+}